@@ -0,0 +1,601 @@
+// Microbenchmarks for libtiny3d.
+//
+// Usage: bench [--filter SUBSTRING] [--reps N] [--min-time MS] [--json FILE]
+//
+// Every benchmark is warmed up, calibrated so one repetition runs for at least --min-time,
+// then repeated --reps times. The table reports the median (and fastest) ns per operation and
+// items per second; --json writes the same numbers for tracking regressions between releases.
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "tiny3d.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MAX_REPS 64
+
+// State handed to every benchmark body
+typedef struct {
+    long iterations;   // Operations to run in this call
+    double items;      // Items processed per operation (edges, pixels, points...), set by the body
+    void *data;        // Fixture from setup
+} bench_t;
+
+// A registered benchmark: optional fixture, body run b->iterations times, optional teardown
+typedef struct {
+    const char *name;
+    const char *item_name;
+    void *(*setup)(void);
+    void (*body)(bench_t *b);
+    void (*teardown)(void *data);
+} bench_def_t;
+
+// Measured result of one benchmark
+typedef struct {
+    const char *name;
+    const char *item_name;
+    long iterations;
+    int reps;
+    double median_ns;
+    double min_ns;
+    double items_per_op;
+} bench_result_t;
+
+// Consumes values so the optimizer cannot drop benchmark work
+static volatile float bench_sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Small deterministic generator so every run measures the same inputs
+static unsigned int bench_rand_state = 12345u;
+static float bench_randf(void) {
+    bench_rand_state = bench_rand_state * 1664525u + 1013904223u;
+    return (bench_rand_state >> 8) * (1.0f / 16777216.0f);
+}
+
+// =======================
+// math3d
+// =======================
+
+static void bench_vec3_add(bench_t *b) {
+    vec3 acc = vec3_from_cartesian(0, 0, 0);
+    vec3 step = vec3_from_cartesian(0.001f, 0.002f, 0.003f);
+    for (long i = 0; i < b->iterations; ++i) acc = vec3_add(acc, step);
+    bench_sink = acc.x;
+    b->items = 1;
+}
+
+static void bench_vec3_normalize(bench_t *b) {
+    vec3 v = vec3_from_cartesian(1.0f, 2.0f, 3.0f);
+    float sum = 0.0f;
+    for (long i = 0; i < b->iterations; ++i) {
+        v.x += 0.001f;
+        sum += vec3_normalize_fast(v).x;
+    }
+    bench_sink = sum;
+    b->items = 1;
+}
+
+static void bench_mat4_mul(bench_t *b) {
+    mat4 m = mat4_rotate_xyz(0.1f, 0.2f, 0.3f);
+    mat4 acc = mat4_identity();
+    for (long i = 0; i < b->iterations; ++i) acc = mat4_mul(acc, m);
+    bench_sink = acc.m[0];
+    b->items = 1;
+}
+
+static void bench_mat4_mul_vec4(bench_t *b) {
+    mat4 m = mat4_rotate_xyz(0.1f, 0.2f, 0.3f);
+    vec4 v = {1.0f, 2.0f, 3.0f, 1.0f};
+    float sum = 0.0f;
+    for (long i = 0; i < b->iterations; ++i) {
+        v.x += 0.001f;
+        sum += mat4_mul_vec4(m, v).x;
+    }
+    bench_sink = sum;
+    b->items = 1;
+}
+
+// =======================
+// canvas
+// =======================
+
+#define CANVAS_SIZE 800
+#define BATCH 1024
+
+static void *setup_canvas(void) {
+    return canvas_create(CANVAS_SIZE, CANVAS_SIZE);
+}
+
+static void teardown_canvas(void *data) {
+    canvas_destroy(data);
+}
+
+static void bench_canvas_clear(bench_t *b) {
+    for (long i = 0; i < b->iterations; ++i) canvas_clear(b->data);
+    b->items = (double)CANVAS_SIZE * CANVAS_SIZE;
+}
+
+static void bench_set_pixel_f(bench_t *b) {
+    float xy[2 * BATCH];
+    for (int k = 0; k < 2 * BATCH; ++k) xy[k] = bench_randf() * CANVAS_SIZE;
+    color_t c = {40, 40, 40};
+    for (long i = 0; i < b->iterations; ++i)
+        for (int k = 0; k < BATCH; ++k) set_pixel_f(b->data, xy[2 * k], xy[2 * k + 1], c);
+    b->items = BATCH;
+}
+
+static void bench_draw_line_f(bench_t *b) {
+    float pts[4 * 64];
+    for (int k = 0; k < 4 * 64; ++k) pts[k] = 100.0f + bench_randf() * (CANVAS_SIZE - 200);
+    color_t c = {40, 40, 40};
+    for (long i = 0; i < b->iterations; ++i)
+        for (int k = 0; k < 64; ++k) draw_line_f(b->data, pts[4 * k], pts[4 * k + 1], pts[4 * k + 2], pts[4 * k + 3], 1.5f, c);
+    b->items = 64;
+}
+
+static void bench_draw_line_fixed(bench_t *b) {
+    canvas_t *canvas = b->data;
+    canvas->line_mode = LINE_RASTER_FIXED;
+    bench_draw_line_f(b);
+    canvas->line_mode = LINE_RASTER_FLOAT;
+}
+
+// One soccer demo frame, so the image codecs see realistic runs of black and line pixels
+static void *setup_frame(void) {
+    canvas_t *canvas = canvas_create(CANVAS_SIZE, CANVAS_SIZE);
+    object3d_t *ball = mesh_create_truncated_icosahedron();
+    if (canvas && ball) {
+        vec3 light = vec3_normalize(vec3_from_cartesian(1.0f, 1.0f, 1.0f));
+        render_wireframe(canvas, ball, mat4_rotate_xyz(0.4f, 0.8f, 0.0f), mat4_translate(0, 0, -3.5f),
+                         mat4_perspective(-1, 1, -1, 1, 1, 100), 1.5f, &light, 1);
+    }
+    object3d_destroy(ball);
+    return canvas;
+}
+
+static void bench_canvas_encode_qoi(bench_t *b) {
+    size_t size = 0;
+    for (long i = 0; i < b->iterations; ++i) free(canvas_encode_qoi(b->data, &size));
+    bench_sink = (float)size;
+    b->items = (double)CANVAS_SIZE * CANVAS_SIZE;
+}
+
+static void bench_canvas_save_qoi(bench_t *b) {
+    const char *dir = getenv("TMPDIR");
+    char path[512];
+    snprintf(path, sizeof(path), "%s/tiny3d_bench.qoi", dir ? dir : "/tmp");
+    for (long i = 0; i < b->iterations; ++i) canvas_save_qoi(b->data, path);
+    remove(path);
+    b->items = (double)CANVAS_SIZE * CANVAS_SIZE;
+}
+
+static void bench_canvas_save_pgm(bench_t *b) {
+    const char *dir = getenv("TMPDIR");
+    char path[512];
+    snprintf(path, sizeof(path), "%s/tiny3d_bench.pgm", dir ? dir : "/tmp");
+    for (long i = 0; i < b->iterations; ++i) canvas_save_pgm(b->data, path);
+    remove(path);
+    b->items = (double)CANVAS_SIZE * CANVAS_SIZE;
+}
+
+// =======================
+// Wireframe rendering
+// =======================
+
+// A canvas and a latitude/longitude sphere with about the requested number of edges
+typedef struct {
+    canvas_t *canvas;
+    object3d_t mesh;
+    int num_edges;
+} wire_fixture_t;
+
+static wire_fixture_t *make_sphere(int rings) {
+    wire_fixture_t *f = calloc(1, sizeof(wire_fixture_t));
+    int segs = 2 * rings;
+    f->canvas = canvas_create(CANVAS_SIZE, CANVAS_SIZE);
+    f->mesh.num_vertices = (rings + 1) * segs;
+    f->mesh.vertices = malloc(f->mesh.num_vertices * sizeof(vec3));
+    f->mesh.indices = malloc(4 * rings * segs * sizeof(int) + 2 * segs * sizeof(int));
+    for (int r = 0; r <= rings; ++r) {
+        float phi = (float)M_PI * r / rings;
+        for (int s = 0; s < segs; ++s) {
+            float theta = 2.0f * (float)M_PI * s / segs;
+            f->mesh.vertices[r * segs + s] = vec3_from_cartesian(sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta));
+        }
+    }
+    int n = 0;
+    for (int r = 0; r <= rings; ++r) {
+        for (int s = 0; s < segs; ++s) {
+            int v = r * segs + s;
+            if (r > 0 && r < rings) {          // Latitude circles
+                f->mesh.indices[n++] = v;
+                f->mesh.indices[n++] = r * segs + (s + 1) % segs;
+            }
+            if (r < rings) {                   // Meridians
+                f->mesh.indices[n++] = v;
+                f->mesh.indices[n++] = v + segs;
+            }
+        }
+    }
+    f->mesh.num_indices = n;
+    f->num_edges = n / 2;
+    return f;
+}
+
+static void *setup_sphere_small(void) { return make_sphere(16); }    // ~1k edges
+static void *setup_sphere_medium(void) { return make_sphere(50); }   // ~10k edges
+static void *setup_sphere_large(void) { return make_sphere(160); }   // ~100k edges
+
+static void teardown_sphere(void *data) {
+    wire_fixture_t *f = data;
+    canvas_destroy(f->canvas);
+    free(f->mesh.vertices);
+    free(f->mesh.indices);
+    free(f);
+}
+
+static void bench_render_wireframe(bench_t *b) {
+    wire_fixture_t *f = b->data;
+    mat4 view = mat4_translate(0, 0, -3.0f);
+    mat4 proj = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    vec3 lights[2] = { vec3_normalize(vec3_from_cartesian(1, 1, 1)), vec3_normalize(vec3_from_cartesian(-1, -0.5f, 0.5f)) };
+    for (long i = 0; i < b->iterations; ++i) {
+        mat4 model = mat4_rotate_xyz(0.01f * i, 0.02f * i, 0.0f);
+        render_wireframe(f->canvas, &f->mesh, model, view, proj, 1.0f, lights, 2);
+    }
+    b->items = f->num_edges;
+}
+
+// =======================
+// Scaling
+// =======================
+
+// A canvas and a generated mesh; edges/s should stay flat from 10^2 to 10^7 edges
+typedef struct {
+    canvas_t *canvas;
+    object3d_t *mesh;
+} scale_fixture_t;
+
+static scale_fixture_t *make_scale_fixture(object3d_t *mesh) {
+    scale_fixture_t *f = calloc(1, sizeof(scale_fixture_t));
+    f->canvas = canvas_create(CANVAS_SIZE, CANVAS_SIZE);
+    f->mesh = mesh;
+    return f;
+}
+
+static void *setup_icosphere_1(void) { return make_scale_fixture(mesh_create_icosphere(1)); }   // 120 edges
+static void *setup_icosphere_3(void) { return make_scale_fixture(mesh_create_icosphere(3)); }   // 1920 edges
+static void *setup_icosphere_5(void) { return make_scale_fixture(mesh_create_icosphere(5)); }   // 30720 edges
+static void *setup_icosphere_7(void) { return make_scale_fixture(mesh_create_icosphere(7)); }   // 491520 edges
+static void *setup_icosphere_9(void) { return make_scale_fixture(mesh_create_icosphere(9)); }   // 7864320 edges
+static void *setup_lines_100(void) { return make_scale_fixture(mesh_create_random_lines(100, 1.0f, 0.05f, 1)); }
+static void *setup_lines_10k(void) { return make_scale_fixture(mesh_create_random_lines(10000, 1.0f, 0.05f, 1)); }
+static void *setup_lines_1m(void) { return make_scale_fixture(mesh_create_random_lines(1000000, 1.0f, 0.05f, 1)); }
+
+static void teardown_scale(void *data) {
+    scale_fixture_t *f = data;
+    canvas_destroy(f->canvas);
+    object3d_destroy(f->mesh);
+    free(f);
+}
+
+static void bench_render_scale(bench_t *b) {
+    scale_fixture_t *f = b->data;
+    mat4 view = mat4_translate(0, 0, -3.0f);
+    mat4 proj = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    vec3 lights[2] = { vec3_normalize(vec3_from_cartesian(1, 1, 1)), vec3_normalize(vec3_from_cartesian(-1, -0.5f, 0.5f)) };
+    for (long i = 0; i < b->iterations; ++i) {
+        mat4 model = mat4_rotate_xyz(0.01f * i, 0.02f * i, 0.0f);
+        render_wireframe(f->canvas, f->mesh, model, view, proj, 1.0f, lights, 2);
+    }
+    b->items = f->mesh->num_indices / 2;
+}
+
+// =======================
+// Lighting
+// =======================
+
+#define LIGHT_EDGES 4096
+
+static void *setup_edges(void) {
+    float *dirs = malloc(3 * LIGHT_EDGES * sizeof(float) + LIGHT_EDGES);
+    for (int k = 0; k < 3 * LIGHT_EDGES; ++k) dirs[k] = bench_randf() * 2.0f - 1.0f;
+    return dirs;
+}
+
+static void bench_compute_edge_lighting(bench_t *b) {
+    const float *d = b->data;
+    vec3 lights[2] = { vec3_normalize(vec3_from_cartesian(1, 1, 1)), vec3_normalize(vec3_from_cartesian(-1, -0.5f, 0.5f)) };
+    vec3 origin = vec3_from_cartesian(0, 0, 0);
+    float sum = 0.0f;
+    for (long i = 0; i < b->iterations; ++i)
+        for (int k = 0; k < 256; ++k)
+            sum += compute_edge_lighting(origin, vec3_from_cartesian(d[3 * k], d[3 * k + 1], d[3 * k + 2]), lights, 2);
+    bench_sink = sum;
+    b->items = 256;
+}
+
+static void bench_compute_edge_lighting_batch(bench_t *b) {
+    float *d = b->data;
+    unsigned char *out = (unsigned char *)(d + 3 * LIGHT_EDGES);
+    vec3 lights[2] = { vec3_normalize(vec3_from_cartesian(1, 1, 1)), vec3_normalize(vec3_from_cartesian(-1, -0.5f, 0.5f)) };
+    for (long i = 0; i < b->iterations; ++i)
+        compute_edge_lighting_batch(d, d + LIGHT_EDGES, d + 2 * LIGHT_EDGES, LIGHT_EDGES, lights, 2, 0.1f, out);
+    bench_sink = out[0];
+    b->items = LIGHT_EDGES;
+}
+
+// =======================
+// Multi-view
+// =======================
+
+// Four 400x400 cells of an atlas viewing a 30k-edge icosphere under a non-rigid model matrix
+typedef struct {
+    canvas_t *atlas;
+    render_view_t views[4];
+    object3d_t *mesh;
+} multiview_fixture_t;
+
+static void *setup_multiview(void) {
+    multiview_fixture_t *f = calloc(1, sizeof(multiview_fixture_t));
+    f->atlas = canvas_create(CANVAS_SIZE, CANVAS_SIZE);
+    f->mesh = mesh_create_icosphere(5);
+    mat4 persp = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    mat4 ortho = mat4_orthographic(-1.5f, 1.5f, -1.5f, 1.5f, 0.1f, 10.0f);
+    mat4 cameras[4] = {mat4_translate(0, 0, -3.0f), mat4_mul(mat4_translate(0, 0, -5.0f), mat4_rotate_x((float)M_PI / 2)),
+                       mat4_mul(mat4_translate(0, 0, -5.0f), mat4_rotate_y((float)-M_PI / 2)), mat4_translate(0.4f, 0, -2.0f)};
+    for (int v = 0; v < 4; ++v) {
+        int cell = CANVAS_SIZE / 2;
+        f->views[v] = (render_view_t){canvas_region(f->atlas, (v % 2) * cell, (v / 2) * cell, cell, cell), cameras[v],
+                                      v == 1 || v == 2 ? ortho : persp};
+    }
+    return f;
+}
+
+static void teardown_multiview(void *data) {
+    multiview_fixture_t *f = data;
+    for (int v = 0; v < 4; ++v) canvas_destroy(f->views[v].canvas);
+    canvas_destroy(f->atlas);
+    object3d_destroy(f->mesh);
+    free(f);
+}
+
+static void run_multiview(bench_t *b, int mode) {
+    multiview_fixture_t *f = b->data;
+    vec3 lights[2] = { vec3_normalize(vec3_from_cartesian(1, 1, 1)), vec3_normalize(vec3_from_cartesian(-1, -0.5f, 0.5f)) };
+    render_context_t ctx;
+    render_context_init(&ctx);
+    for (long i = 0; i < b->iterations; ++i) {
+        mat4 model = mat4_mul(mat4_scale(1.0f, 0.8f, 1.0f), mat4_rotate_xyz(0.01f * i, 0.02f * i, 0.0f));
+        if (mode == 0) {
+            for (int v = 0; v < 4; ++v)
+                render_wireframe_ctx(&ctx, f->views[v].canvas, f->mesh, model, f->views[v].view_matrix, f->views[v].projection_matrix, 1.0f, lights, 2);
+        } else {
+            render_wireframe_views(&ctx, f->mesh, model, f->views, 4, 1.0f, lights, 2, mode);
+        }
+    }
+    b->items = 4;
+}
+
+static void bench_multiview_separate(bench_t *b) { run_multiview(b, 0); }
+static void bench_multiview_shared(bench_t *b) { run_multiview(b, 1); }
+static void bench_multiview_threads(bench_t *b) { run_multiview(b, 4); }
+
+// =======================
+// Layers
+// =======================
+
+// A static 100k-line field under one small moving ball: redraw both every frame, or cache the field in a layer
+typedef struct {
+    canvas_t *canvas;
+    layer_stack_t *stack;
+    int field_layer, ball_layer;
+    object3d_t *field;
+    object3d_t *ball;
+} layer_fixture_t;
+
+static void *setup_layers(void) {
+    layer_fixture_t *f = calloc(1, sizeof(layer_fixture_t));
+    f->canvas = canvas_create(CANVAS_SIZE, CANVAS_SIZE);
+    f->stack = layer_stack_create(CANVAS_SIZE, CANVAS_SIZE);
+    f->field_layer = layer_stack_add(f->stack, LAYER_STATIC, LAYER_BLEND_ADD);
+    f->ball_layer = layer_stack_add(f->stack, LAYER_DYNAMIC, LAYER_BLEND_ADD);
+    f->field = mesh_create_random_lines(100000, 1.0f, 0.05f, 1);
+    f->ball = mesh_create_truncated_icosahedron();
+    return f;
+}
+
+static void teardown_layers(void *data) {
+    layer_fixture_t *f = data;
+    canvas_destroy(f->canvas);
+    layer_stack_destroy(f->stack);
+    object3d_destroy(f->field);
+    object3d_destroy(f->ball);
+    free(f);
+}
+
+static void draw_layer_field(canvas_t *canvas, object3d_t *field, vec3 *light) {
+    render_wireframe(canvas, field, mat4_rotate_xyz(0.3f, 0.2f, 0.0f), mat4_translate(0, 0, -3.0f),
+                     mat4_perspective(-1, 1, -1, 1, 1, 100), 1.0f, light, 1);
+}
+
+static void draw_layer_ball(canvas_t *canvas, object3d_t *ball, long frame, vec3 *light) {
+    mat4 model = mat4_mul(mat4_translate(0.5f * sinf(0.05f * frame), 0.3f, 0.0f),
+                          mat4_mul(mat4_scale(0.2f, 0.2f, 0.2f), mat4_rotate_xyz(0.1f * frame, 0.2f * frame, 0.0f)));
+    render_wireframe(canvas, ball, model, mat4_translate(0, 0, -3.0f), mat4_perspective(-1, 1, -1, 1, 1, 100), 1.5f, light, 1);
+}
+
+static void bench_layers_full_redraw(bench_t *b) {
+    layer_fixture_t *f = b->data;
+    vec3 light = vec3_normalize(vec3_from_cartesian(1, 1, 1));
+    for (long i = 0; i < b->iterations; ++i) {
+        canvas_clear(f->canvas);
+        draw_layer_field(f->canvas, f->field, &light);
+        draw_layer_ball(f->canvas, f->ball, i, &light);
+    }
+    b->items = 1;
+}
+
+static void bench_layers_cached(bench_t *b) {
+    layer_fixture_t *f = b->data;
+    vec3 light = vec3_normalize(vec3_from_cartesian(1, 1, 1));
+    for (long i = 0; i < b->iterations; ++i) {
+        canvas_t *c = layer_begin(f->stack, f->field_layer);
+        if (c) {
+            draw_layer_field(c, f->field, &light);
+            layer_end(f->stack, f->field_layer);
+        }
+        c = layer_begin(f->stack, f->ball_layer);
+        draw_layer_ball(c, f->ball, i, &light);
+        layer_end(f->stack, f->ball_layer);
+        layer_stack_compose(f->stack, f->canvas);
+    }
+    b->items = 1;
+}
+
+// =======================
+// Registry
+// =======================
+
+static const bench_def_t BENCHMARKS[] = {
+    {"math/vec3_add",                  "ops",    NULL,                bench_vec3_add,                    NULL},
+    {"math/vec3_normalize_fast",       "ops",    NULL,                bench_vec3_normalize,              NULL},
+    {"math/mat4_mul",                  "ops",    NULL,                bench_mat4_mul,                    NULL},
+    {"math/mat4_mul_vec4",             "ops",    NULL,                bench_mat4_mul_vec4,               NULL},
+    {"canvas/canvas_clear",            "pixels", setup_canvas,        bench_canvas_clear,                teardown_canvas},
+    {"canvas/set_pixel_f",             "pixels", setup_canvas,        bench_set_pixel_f,                 teardown_canvas},
+    {"canvas/draw_line_f",             "lines",  setup_canvas,        bench_draw_line_f,                 teardown_canvas},
+    {"canvas/draw_line_fixed",         "lines",  setup_canvas,        bench_draw_line_fixed,             teardown_canvas},
+    {"canvas/canvas_save_pgm",         "pixels", setup_canvas,        bench_canvas_save_pgm,             teardown_canvas},
+    {"canvas/canvas_encode_qoi",       "pixels", setup_frame,         bench_canvas_encode_qoi,           teardown_canvas},
+    {"canvas/canvas_save_qoi",         "pixels", setup_frame,         bench_canvas_save_qoi,             teardown_canvas},
+    {"render/wireframe_1k",            "edges",  setup_sphere_small,  bench_render_wireframe,            teardown_sphere},
+    {"render/wireframe_10k",           "edges",  setup_sphere_medium, bench_render_wireframe,            teardown_sphere},
+    {"render/wireframe_100k",          "edges",  setup_sphere_large,  bench_render_wireframe,            teardown_sphere},
+    {"scale/icosphere_1e2",            "edges",  setup_icosphere_1,   bench_render_scale,                teardown_scale},
+    {"scale/icosphere_2e3",            "edges",  setup_icosphere_3,   bench_render_scale,                teardown_scale},
+    {"scale/icosphere_3e4",            "edges",  setup_icosphere_5,   bench_render_scale,                teardown_scale},
+    {"scale/icosphere_5e5",            "edges",  setup_icosphere_7,   bench_render_scale,                teardown_scale},
+    {"scale/icosphere_8e6",            "edges",  setup_icosphere_9,   bench_render_scale,                teardown_scale},
+    {"scale/lines_1e2",                "edges",  setup_lines_100,     bench_render_scale,                teardown_scale},
+    {"scale/lines_1e4",                "edges",  setup_lines_10k,     bench_render_scale,                teardown_scale},
+    {"scale/lines_1e6",                "edges",  setup_lines_1m,      bench_render_scale,                teardown_scale},
+    {"multiview/separate_4",           "views",  setup_multiview,     bench_multiview_separate,          teardown_multiview},
+    {"multiview/shared_4",             "views",  setup_multiview,     bench_multiview_shared,            teardown_multiview},
+    {"multiview/shared_4_threads",     "views",  setup_multiview,     bench_multiview_threads,           teardown_multiview},
+    {"layers/full_redraw",             "frames", setup_layers,        bench_layers_full_redraw,          teardown_layers},
+    {"layers/static_cached",           "frames", setup_layers,        bench_layers_cached,               teardown_layers},
+    {"lighting/compute_edge_lighting", "edges",  setup_edges,         bench_compute_edge_lighting,       free},
+    {"lighting/edge_lighting_batch",   "edges",  setup_edges,         bench_compute_edge_lighting_batch, free},
+};
+
+#define NUM_BENCHMARKS ((int)(sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0])))
+
+// Warm up, calibrate the iteration count, then time the repetitions
+static bench_result_t run_benchmark(const bench_def_t *def, int reps, double min_time_ns) {
+    bench_t b = {1, 1.0, def->setup ? def->setup() : NULL};
+
+    // Warm-up doubles as calibration: grow until one call takes the minimum time
+    for (;;) {
+        double start = now_ns();
+        def->body(&b);
+        double elapsed = now_ns() - start;
+        if (elapsed >= min_time_ns || b.iterations >= (1L << 40)) break;
+        double scale = elapsed > 0.0 ? 1.2 * min_time_ns / elapsed : 100.0;
+        if (scale > 100.0) scale = 100.0;
+        if (scale < 2.0) scale = 2.0;
+        b.iterations = (long)(b.iterations * scale);
+    }
+
+    double samples[MAX_REPS];
+    for (int r = 0; r < reps; ++r) {
+        double start = now_ns();
+        def->body(&b);
+        samples[r] = (now_ns() - start) / b.iterations;
+    }
+    qsort(samples, reps, sizeof(double), compare_doubles);
+
+    if (def->teardown) def->teardown(b.data);
+
+    bench_result_t result = {def->name, def->item_name, b.iterations, reps,
+                             reps % 2 ? samples[reps / 2] : 0.5 * (samples[reps / 2 - 1] + samples[reps / 2]),
+                             samples[0], b.items};
+    return result;
+}
+
+static void write_json(const char *path, const bench_result_t *results, int count, int reps, double min_time_ms) {
+    FILE *fp = fopen(path, "w");
+    if (!fp) {
+        perror("Failed to open JSON output");
+        return;
+    }
+    fprintf(fp, "{\n  \"reps\": %d,\n  \"min_time_ms\": %.1f,\n  \"benchmarks\": [\n", reps, min_time_ms);
+    for (int i = 0; i < count; ++i) {
+        const bench_result_t *r = &results[i];
+        fprintf(fp, "    {\"name\": \"%s\", \"iterations\": %ld, \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, "
+                    "\"items_per_op\": %.0f, \"item\": \"%s\", \"items_per_second\": %.1f}%s\n",
+                r->name, r->iterations, r->median_ns, r->min_ns, r->items_per_op, r->item_name,
+                r->items_per_op * 1e9 / r->median_ns, i + 1 < count ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    fclose(fp);
+}
+
+int main(int argc, char **argv) {
+    const char *filter = NULL;
+    const char *json_path = NULL;
+    int reps = 5;
+    double min_time_ms = 100.0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (!strcmp(argv[i], "--reps") && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--min-time") && i + 1 < argc) {
+            min_time_ms = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--filter SUBSTRING] [--reps N] [--min-time MS] [--json FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (reps < 1) reps = 1;
+    if (reps > MAX_REPS) reps = MAX_REPS;
+
+    bench_result_t results[NUM_BENCHMARKS];
+    int count = 0;
+
+    printf("%-34s %12s %14s %16s\n", "benchmark", "ns/op", "min ns/op", "items/s");
+    for (int i = 0; i < NUM_BENCHMARKS; ++i) {
+        if (filter && !strstr(BENCHMARKS[i].name, filter)) continue;
+        bench_result_t r = run_benchmark(&BENCHMARKS[i], reps, min_time_ms * 1e6);
+        printf("%-34s %12.1f %14.1f %12.3g %s\n", r.name, r.median_ns, r.min_ns,
+               r.items_per_op * 1e9 / r.median_ns, r.item_name);
+        fflush(stdout);
+        results[count++] = r;
+    }
+
+    if (json_path) {
+        write_json(json_path, results, count, reps, min_time_ms);
+        printf("Wrote %s\n", json_path);
+    }
+    return 0;
+}
@@ -11,4 +11,62 @@
 // t: Parameter from 0.0 to 1.0 (0.0 at p0, 1.0 at p3)
 vec3 bezier_cubic(vec3 p0, vec3 p1, vec3 p2, vec3 p3, float t);
 
+// =======================
+// Curves and Paths
+// =======================
+
+// One cubic segment in power form: p(t) = c[0] + c[1] t + c[2] t^2 + c[3] t^3 (x, y, z per row), t in [0, 1]
+typedef struct {
+    float c[4][3];
+} curve_segment_t;
+
+// Control point layouts for curve_path_create
+typedef enum {
+    PATH_BEZIER,       // 3n + 1 points: end, control, control, end, control, control, end, ...
+    PATH_CATMULL_ROM,  // Passes through every point (at least 2), endpoints repeated for the end tangents
+    PATH_BSPLINE       // Uniform cubic B-spline (at least 4 points), C2-smooth but approximating
+} path_type_t;
+
+// A chain of cubic segments, optionally reparameterized by arc length
+typedef struct {
+    curve_segment_t *segments;
+    int num_segments;
+    float length;            // Total arc length (coarse at creation, refined by curve_path_build_arc_table)
+    float *arc_params;       // Path parameter at arc_samples + 1 evenly spaced distances, NULL until built
+    int arc_samples;
+} curve_path_t;
+
+// Coefficients of a cubic Bézier segment (points are x, y, z float triples)
+curve_segment_t curve_segment_bezier(const float p0[3], const float p1[3], const float p2[3], const float p3[3]);
+
+// Evaluate a segment at t (Horner's rule)
+void curve_segment_eval(const curve_segment_t *segment, float t, float out[3]);
+
+// Sample count >= 2 points at evenly spaced t from 0 to 1 into out (x, y, z triples) by forward differencing:
+// three additions per axis and point instead of a polynomial evaluation
+void curve_segment_sample(const curve_segment_t *segment, int count, float *out);
+
+// Build a path from num_points x, y, z triples. Returns NULL for too few points or on allocation failure.
+curve_path_t *curve_path_create(path_type_t type, const float *points, int num_points);
+
+// Free a path and its arc-length table
+void curve_path_destroy(curve_path_t *path);
+
+// Evaluate a path at u in [0, 1], each segment taking an equal share of u (speed varies along the path)
+void curve_path_eval(const curve_path_t *path, float u, float out[3]);
+
+// Sample count >= 2 points spread evenly over u into out, forward differencing within each segment
+void curve_path_sample(const curve_path_t *path, int count, float *out);
+
+// Measure the path with samples_per_segment chords per segment and build the table mapping distance to u.
+// Returns false on allocation failure.
+bool curve_path_build_arc_table(curve_path_t *path, int samples_per_segment);
+
+// Path parameter u at arc length s (clamped to [0, length]). O(1) table lookup; u = s / length
+// without a table, which only moves at constant speed if the path does.
+float curve_path_param_at_distance(const curve_path_t *path, float s);
+
+// Evaluate a path at arc length s, for constant-speed motion
+void curve_path_eval_distance(const curve_path_t *path, float s, float out[3]);
+
 #endif // ANIMATION_H
@@ -2,28 +2,60 @@
 #define CANVAS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 // Define a color structure for RGB values
 typedef struct {
     unsigned char r, g, b;
 } color_t;
 
+// Sub-pixel bits of draw_line_fixed coordinates (24.8 fixed point)
+#define CANVAS_SUBPIXEL_BITS 8
+#define CANVAS_SUBPIXEL_ONE (1 << CANVAS_SUBPIXEL_BITS)
+
+// How draw_line_f rasterizes
+typedef enum {
+    LINE_RASTER_FLOAT,   // Float DDA with bilinear splats (default)
+    LINE_RASTER_FIXED    // Endpoints rounded to 24.8 fixed point, then draw_line_fixed: bit-identical on every
+                         // compiler, optimization level and ISA for the same endpoints
+} line_raster_mode_t;
+
 // Define a color_t with 0 intensity for black
 typedef struct {
     int width;                
     int height; 
     color_t **pixels;         // 2d array for representing color at each pixel
+    float *depth;             // Optional depth buffer (width * height NDC depths), NULL until canvas_enable_depth
+    int *viewport_spans;      // First and last x inside the circular viewport for each row (empty rows: 0, -1)
+    struct render_stats *stats; // Optional counters for pixels and bytes written and clear/save times (not owned)
+    bool owns_pixels;         // False for canvas_wrap: the rows point into caller memory
+    line_raster_mode_t line_mode; // Rasterizer used by draw_line_f (LINE_RASTER_FLOAT by default)
 } canvas_t;
 
 // Create a new canvas with given width and height
 canvas_t *canvas_create(int width, int height);
 
-// Free the memory used by the canvas
+// Create a canvas drawing into caller memory (for example a shared frame buffer): row y starts at
+// pixels + y * stride (in pixels, at least width). The memory is not cleared and must outlive the canvas.
+canvas_t *canvas_wrap(int width, int height, color_t *pixels, int stride);
+
+// Create a canvas drawing into the rectangle at (x, y) of another canvas, e.g. one cell of an atlas, with its own
+// circular viewport. Destroy it before the parent. Returns NULL if the rectangle does not fit inside the parent.
+canvas_t *canvas_region(canvas_t *parent, int x, int y, int width, int height);
+
+// Free the memory used by the canvas (a wrapped canvas leaves the caller's pixels alone)
 void canvas_destroy(canvas_t *canvas);
 
 // Clear the canvas to black (0.0 intensity for all channels)
 void canvas_clear(canvas_t *canvas);
 
+// Allocate the depth buffer used by filled-triangle rendering (cleared by canvas_clear)
+bool canvas_enable_depth(canvas_t *canvas);
+
+// Get the span of row y inside the circular viewport. Returns false if the row is outside it.
+bool canvas_row_viewport(canvas_t *canvas, int y, int *x_min, int *x_max);
+
 // Sets a pixel with bilinear filtering, spreading intensity to 4 nearest pixels
 void set_pixel_f(canvas_t *canvas, float x, float y, color_t color);
 
@@ -31,7 +63,39 @@ void set_pixel_f(canvas_t *canvas, float x, float y, color_t color);
 // Uses DDA algorithm to draw a smooth line from (x0,y0) to (x1,y1) with given thickness
 void draw_line_f(canvas_t *canvas, float x0, float y0, float x1, float y1, float thickness, color_t color);
 
+// Integer version of the same DDA for endpoints in 24.8 fixed point (pixel * CANVAS_SUBPIXEL_ONE): positions step
+// in fixed point and each step spreads the color over 4 pixels with integer bilinear weights. No float math at all.
+void draw_line_fixed(canvas_t *canvas, int32_t x0, int32_t y0, int32_t x1, int32_t y1, color_t color);
+
 // Save the canvas to a PGM file (will convert RGB to grayscale)
 void canvas_save_pgm(canvas_t *canvas, const char *filename);
 
+// Load an ASCII (P2) or binary (P5) PGM into a new canvas with r = g = b = gray.
+// Returns NULL if the file cannot be read or is not an 8-bit PGM.
+canvas_t *canvas_load_pgm(const char *filename);
+
+// Save the canvas as a lossless QOI image (RGB, run/index/difference coded; typically far smaller than PGM).
+// Returns false if the file cannot be written.
+bool canvas_save_qoi(canvas_t *canvas, const char *filename);
+
+// Load a QOI image into a new canvas (alpha is dropped). Returns NULL if the file is missing or malformed.
+canvas_t *canvas_load_qoi(const char *filename);
+
+// In-memory QOI encoding: returns a malloc'd image and its size in *size, or NULL
+unsigned char *canvas_encode_qoi(const canvas_t *canvas, size_t *size);
+
+// Decode a QOI image held in memory. Returns NULL if it is malformed.
+canvas_t *canvas_decode_qoi(const unsigned char *data, size_t size);
+
+// Difference between two images, compared in the grayscale written by canvas_save_pgm
+typedef struct {
+    int max_error;            // Largest per-pixel difference (0-255)
+    long num_different;       // Pixels that differ at all
+    double mse;               // Mean squared error
+    double psnr;              // Peak signal-to-noise ratio in dB (INFINITY for identical images)
+} canvas_diff_t;
+
+// Compare two canvases of the same size. Returns false if the sizes differ.
+bool canvas_compare(const canvas_t *a, const canvas_t *b, canvas_diff_t *diff);
+
 #endif
\ No newline at end of file
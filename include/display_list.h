@@ -0,0 +1,80 @@
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include "tiny3d.h"
+
+// Handle to a recorded draw command (-1 when recording failed)
+typedef int draw_handle_t;
+
+// Kinds of recorded draw commands, in replay order
+typedef enum {
+    DRAW_SOLID,       // render_solid
+    DRAW_WIREFRAME,   // render_wireframe_ctx
+    DRAW_POINTS,      // render_point_cloud
+    DRAW_LINE_2D      // draw_line_f in screen space
+} draw_kind_t;
+
+// One recorded draw operation and its cached projection
+typedef struct {
+    draw_kind_t kind;
+    bool visible;
+    object3d_t *object;           // DRAW_SOLID, DRAW_WIREFRAME (not owned)
+    const point_cloud_t *cloud;   // DRAW_POINTS (not owned)
+    mat4 model;
+    float thickness;              // Line thickness or point size
+    color_t color;                // DRAW_POINTS and DRAW_LINE_2D
+    float line[4];                // DRAW_LINE_2D endpoints x0, y0, x1, y1
+    render_line_t *cached_lines;  // DRAW_WIREFRAME: lit, sorted screen lines from the last replay
+    int cached_count;
+    bool cache_valid;
+} draw_cmd_t;
+
+// Retained list of draw commands replayed every frame
+typedef struct {
+    render_context_t ctx;         // Settings used at replay (changing them invalidates the caches)
+    draw_cmd_t *cmds;
+    int count;
+    int capacity;
+    int *order;                   // Replay order, sorted by kind and mesh
+    bool order_dirty;
+    mat4 view;
+    mat4 projection;
+    vec3 *lights;
+    int num_lights;
+    render_context_t cached_ctx;  // Context the caches were built with
+    int cached_width;             // Canvas size the caches were built for
+    int cached_height;
+} display_list_t;
+
+// Create an empty display list with default render settings and identity camera
+display_list_t *display_list_create(void);
+
+// Free the list and its caches (meshes and point clouds are not owned)
+void display_list_destroy(display_list_t *list);
+
+// Remove every command (handles become invalid)
+void display_list_clear(display_list_t *list);
+
+// Record draw operations. The mesh or cloud must stay alive while the command is in the list.
+draw_handle_t display_list_add_wireframe(display_list_t *list, object3d_t *object, mat4 model_matrix, float line_thickness);
+draw_handle_t display_list_add_solid(display_list_t *list, object3d_t *object, mat4 model_matrix);
+draw_handle_t display_list_add_points(display_list_t *list, const point_cloud_t *cloud, mat4 model_matrix, float point_size, color_t color);
+draw_handle_t display_list_add_line(display_list_t *list, float x0, float y0, float x1, float y1, float thickness, color_t color);
+
+// Shared camera and lights. Setting the same values again keeps the caches.
+void display_list_set_camera(display_list_t *list, mat4 view_matrix, mat4 projection_matrix);
+void display_list_set_lights(display_list_t *list, const vec3 *light_dirs, int num_lights);
+
+// Per-command patching through handles. Only a changed transform invalidates that command's cache.
+void display_list_set_transform(display_list_t *list, draw_handle_t handle, mat4 model_matrix);
+void display_list_set_color(display_list_t *list, draw_handle_t handle, color_t color);
+void display_list_set_visible(display_list_t *list, draw_handle_t handle, bool visible);
+
+// Drop a command's cache after its mesh data was edited in place
+void display_list_invalidate(display_list_t *list, draw_handle_t handle);
+
+// Replay every visible command: solids, then wireframes, points and 2D lines, grouped by mesh.
+// Wireframes whose transform, camera, lights and settings are unchanged reuse their projected lines.
+void display_list_render(display_list_t *list, canvas_t *canvas);
+
+#endif
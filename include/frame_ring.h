@@ -0,0 +1,75 @@
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tiny3d.h" // canvas_t, color_t
+
+// =======================
+// Shared Frame Ring
+// =======================
+//
+// A ring of canvas-sized RGB slots in shared memory, so previewers and encoders on the same machine read
+// frames where the renderer drew them instead of re-reading files. The renderer draws straight into the next
+// slot through a wrapped canvas and publishes it; readers map the same region read-only.
+//
+// One producer, any number of consumers, no locks: every slot carries a sequence counter that is odd while
+// the producer writes it (a seqlock). A reader checks the counter before and after touching the pixels and
+// discards the frame if it changed, which only happens when the reader falls a whole ring behind.
+// Neither side makes a system call per frame.
+//
+// Names with a single leading '/' and no other '/' ("/tiny3d_frames") are POSIX shared memory objects;
+// anything else is a file path, which gives a file-backed ring.
+
+typedef struct frame_ring frame_ring_t;
+
+// A frame being read in place
+typedef struct {
+    const color_t *pixels;     // Row y starts at pixels + y * width
+    int width, height;
+    uint64_t frame;            // Frame number (0 for the first published frame)
+    uint64_t seq;              // Slot sequence seen by frame_ring_read_begin
+    int slot;
+} frame_view_t;
+
+// Producer: create (or replace) a ring of num_slots frames. Returns NULL on failure.
+frame_ring_t *frame_ring_create(const char *name, int width, int height, int num_slots);
+
+// Producer: canvas for the next frame, drawing into its slot. Clear it as usual; the previous contents are
+// whatever the slot held num_slots frames ago.
+canvas_t *frame_ring_begin_frame(frame_ring_t *ring);
+
+// Producer: make the frame from frame_ring_begin_frame visible to readers. Returns its frame number.
+uint64_t frame_ring_publish(frame_ring_t *ring);
+
+// Producer: tell readers that no more frames will come (frame_ring_destroy also does)
+void frame_ring_finish(frame_ring_t *ring);
+
+// Consumer: map an existing ring read-only. Returns NULL if it does not exist or is not a frame ring.
+frame_ring_t *frame_ring_open(const char *name);
+
+// Frames published so far; the newest is frame_ring_published() - 1
+uint64_t frame_ring_published(const frame_ring_t *ring);
+
+// True once the producer has finished
+bool frame_ring_finished(const frame_ring_t *ring);
+
+int frame_ring_width(const frame_ring_t *ring);
+int frame_ring_height(const frame_ring_t *ring);
+int frame_ring_slots(const frame_ring_t *ring);
+
+// Consumer: start reading frame `frame` in place. Returns false if it is not published yet, has already been
+// overwritten, or is being overwritten right now.
+bool frame_ring_read_begin(const frame_ring_t *ring, uint64_t frame, frame_view_t *view);
+
+// Consumer: returns true if the pixels stayed intact since frame_ring_read_begin. If false, anything derived
+// from them must be thrown away.
+bool frame_ring_read_end(const frame_ring_t *ring, const frame_view_t *view);
+
+// Unmap the ring (and mark it finished if this is the producer). The shared object or file stays.
+void frame_ring_destroy(frame_ring_t *ring);
+
+// Remove a ring's shared memory object or file
+bool frame_ring_unlink(const char *name);
+
+#endif
\ No newline at end of file
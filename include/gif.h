@@ -0,0 +1,31 @@
+#ifndef GIF_H
+#define GIF_H
+
+#include <stdbool.h>
+#include "tiny3d.h" // canvas_t
+
+// =======================
+// Animated GIF Output
+// =======================
+//
+// Frames are converted to the gray of canvas_save_pgm and mapped onto one fixed gray palette, written once as
+// the global color table. The last palette entry is transparent: each frame after the first is cropped to the
+// rectangle of pixels that changed, and unchanged pixels inside it are written as transparent so they compress
+// to long runs. Frames go straight to the file, so memory use does not grow with the animation length.
+
+typedef struct gif_writer gif_writer_t;
+
+// Start a GIF of width x height frames shown delay_cs hundredths of a second each. loop_count is the number of
+// repeats (0 loops forever, -1 plays once). palette_bits (2-8) gives 2^bits - 1 gray levels evenly spaced from 0 to
+// 255 plus the transparent entry; each gray is rounded to the nearest level, so even 8 bits (255 levels) requantizes
+// slightly, with 0 and 255 kept exact. Returns NULL on failure or palette_bits outside 2-8.
+gif_writer_t *gif_writer_create(const char *filename, int width, int height, int delay_cs, int loop_count, int palette_bits);
+
+// Append a canvas of the writer's size. Bytes written and save time go to canvas->stats if attached.
+// Returns false on a size mismatch or write error.
+bool gif_writer_add_frame(gif_writer_t *gif, const canvas_t *canvas);
+
+// Finish the file and free the writer. Returns false if any write failed.
+bool gif_writer_close(gif_writer_t *gif);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef LAYERS_H
+#define LAYERS_H
+
+#include <stdbool.h>
+#include "tiny3d.h" // canvas_t
+
+// =======================
+// Canvas Layers
+// =======================
+//
+// A stack of full-size canvases composited bottom to top into an output canvas. Static layers keep their
+// image between frames and are only redrawn after layer_invalidate; dynamic layers are redrawn whenever the
+// caller wants (usually every frame). Each layer remembers the bounding box of its non-black pixels, so
+// redrawing a layer clears only its previous contents, and composing rewrites only the output regions where
+// a layer changed since the last compose.
+//
+// Typical frame:
+//   canvas_t *c;
+//   if ((c = layer_begin(stack, background))) { draw the static geometry into c; layer_end(stack, background); }
+//   c = layer_begin(stack, actors); draw the animated objects into c; layer_end(stack, actors);
+//   layer_stack_compose(stack, output);
+
+#define LAYER_STACK_MAX_LAYERS 16
+
+// Whether a layer is cached between frames
+typedef enum {
+    LAYER_STATIC,    // Drawn once; layer_begin returns NULL until layer_invalidate
+    LAYER_DYNAMIC    // layer_begin always hands out the canvas for redrawing
+} layer_kind_t;
+
+// How a layer is merged onto the layers below it
+typedef enum {
+    LAYER_BLEND_ADD,   // Saturating per-channel add: the same image as drawing the layer's lines and points
+                       // straight onto the layers below, since those accumulate additively
+    LAYER_BLEND_OVER   // Non-black pixels replace the pixels below; black is transparent
+} layer_blend_t;
+
+// Half-open pixel rectangle [x0, x1) x [y0, y1); empty when x0 >= x1 or y0 >= y1
+typedef struct {
+    int x0, y0, x1, y1;
+} canvas_rect_t;
+
+typedef struct layer_stack layer_stack_t;
+
+// Create an empty stack of width x height layers. Returns NULL on failure.
+layer_stack_t *layer_stack_create(int width, int height);
+
+// Free the stack and its layer canvases
+void layer_stack_destroy(layer_stack_t *stack);
+
+// Add a layer on top of the stack. Returns its index, or -1 if the stack is full or allocation fails.
+int layer_stack_add(layer_stack_t *stack, layer_kind_t kind, layer_blend_t blend);
+
+// Start redrawing a layer: returns its canvas with the previous contents cleared, or NULL if the layer is
+// static and its cached image is still valid. Attach stats or a depth buffer to the canvas as usual.
+canvas_t *layer_begin(layer_stack_t *stack, int layer);
+
+// Finish drawing a layer started with layer_begin (records its new bounds for the next compose)
+void layer_end(layer_stack_t *stack, int layer);
+
+// Make a static layer's next layer_begin return its canvas for redrawing
+void layer_invalidate(layer_stack_t *stack, int layer);
+
+// Bounds of a layer's non-black pixels as of its last layer_end
+canvas_rect_t layer_bounds(const layer_stack_t *stack, int layer);
+
+// Composite the layers into out (same size as the stack). When out is the canvas of the previous call, only
+// the regions of layers redrawn since then are rewritten, so out must not be drawn on in between; otherwise
+// (or after layer_stack_invalidate_output) the whole canvas is composed. SSE2 when available.
+// Returns the number of pixels composed, or -1 if out has the wrong size.
+long layer_stack_compose(layer_stack_t *stack, canvas_t *out);
+
+// Make the next layer_stack_compose rewrite the whole output canvas
+void layer_stack_invalidate_output(layer_stack_t *stack);
+
+#endif
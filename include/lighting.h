@@ -3,7 +3,87 @@
 
 #include "tiny3d.h" // Assumes math3d.h defines vec3
 
+// Exponent of the curve that boosts low intensities before quantization (0.5 = square root)
+#define LIGHT_BOOST_EXPONENT 0.5f
+
+// Entries in the boost-and-quantize lookup table
+#define LIGHT_LUT_SIZE 1024
+
+// Screen tiles used to cull local lights are LIGHT_TILE_SIZE pixels square
+#define LIGHT_TILE_SIZE 32
+
+// Kinds of light objects
+typedef enum {
+    LIGHT_DIRECTIONAL,   // Same everywhere, like the light_dirs arrays
+    LIGHT_POINT,         // Radiates from a position, fading to zero at its range
+    LIGHT_SPOT           // Point light restricted to a cone around its direction
+} light_type_t;
+
+// A light object. Contributions are summed (not averaged) and scaled by intensity.
+typedef struct light {
+    light_type_t type;
+    float position[3];   // Point and spot: world-space position
+    float direction[3];  // Directional: unit vector dotted with edges (as in light_dirs); spot: unit cone axis
+    float intensity;     // Scale of this light's contribution
+    float range;         // Point and spot: distance where attenuation reaches zero
+    float inner_cos;     // Spot: cosine of the half angle with full intensity
+    float outer_cos;     // Spot: cosine of the half angle where the light is cut off
+} light_t;
+
+// Light objects culled for one draw: lights that reach everything, plus local lights binned per screen tile
+typedef struct {
+    const light_t *lights;
+    int *global_lights;  // Indices evaluated for every edge (directional lights and lights around the camera)
+    int num_global;
+    int tiles_x;
+    int tiles_y;
+    int *tile_offsets;   // tiles_x * tiles_y + 1 offsets into tile_lights
+    int *tile_lights;    // Indices of the local lights overlapping each tile
+} light_grid_t;
+
+// Light constructors (angles in radians, measured from the cone axis)
+light_t light_directional(float dx, float dy, float dz, float intensity);
+light_t light_point(float x, float y, float z, float range, float intensity);
+light_t light_spot(float x, float y, float z, float dx, float dy, float dz, float range, float inner_angle, float outer_angle, float intensity);
+
+// Cull lights against an object's world bounding sphere (skipped if bounds_radius < 0) and bin the
+// remaining local lights into screen tiles by their projected range (clamped to the border tiles when off-screen).
+// Returns false on allocation failure.
+bool light_grid_build(light_grid_t *grid, const light_t *lights, int num_lights, mat4 view_matrix, mat4 projection_matrix,
+                      int width, int height, const float bounds_center[3], float bounds_radius);
+
+// Free the lists of a light grid
+void light_grid_free(light_grid_t *grid);
+
+// Light many edges against a light grid. mid_* are world-space edge midpoints and tiles their screen tile
+// (tile index from the projected midpoint clamped to the grid, -1 to use only the global lights). Output as in compute_edge_lighting_batch.
+void compute_edge_lighting_grid(const float *dir_x, const float *dir_y, const float *dir_z,
+                                const float *mid_x, const float *mid_y, const float *mid_z, const int *tiles, int num_edges,
+                                const light_grid_t *grid, float ambient, unsigned char *out);
+
 // Compute Lambertian lighting intensity for a single edge given multiple light directions
 float compute_edge_lighting(vec3 v1, vec3 v2, vec3* light_dirs, int num_lights);
 
-#endif
\ No newline at end of file
+// Light many edges at once. Edge directions are given as structure-of-arrays (they need not be normalized).
+// Each output is the 8-bit gray level of ambient + lambert * (1 - ambient), boosted by LIGHT_BOOST_EXPONENT
+// through a lookup table. Processes 4 edges per step with SSE2 when available.
+void compute_edge_lighting_batch(const float *dir_x, const float *dir_y, const float *dir_z, int num_edges,
+                                 const vec3* light_dirs, int num_lights, float ambient, unsigned char *out);
+
+// compute_edge_lighting_batch for edge directions that are already unit length (e.g. object3d_t edge_dirs),
+// skipping the per-edge normalization
+void compute_edge_lighting_batch_unit(const float *dir_x, const float *dir_y, const float *dir_z, int num_edges,
+                                      const vec3* light_dirs, int num_lights, float ambient, unsigned char *out);
+
+// Fade lit edges with distance: scales each gray level by the fog factor of its eye distance (clip w).
+// Exponential modes read exp() from a lookup table. Processes 4 edges per step with SSE2 when available.
+void compute_edge_fog_batch(const float *depth, int num_edges, fog_mode_t mode, float fog_start, float fog_end,
+                            float fog_density, unsigned char *gray);
+
+// Distance beyond which edges are fully fogged (FLT_MAX without fog), for culling before lighting
+float fog_max_distance(fog_mode_t mode, float fog_start, float fog_end, float fog_density);
+
+// Boost and quantize one intensity in [0, 1] through the same lookup table
+unsigned char lighting_quantize(float intensity);
+
+#endif
@@ -28,6 +28,14 @@ typedef struct {
     float m[16];
 } mat4;
 
+// =======================
+// Quaternion Struct
+// =======================
+
+typedef struct {
+    float x, y, z, w;               // Unit quaternion (x, y, z vector part, w scalar part)
+} quat;
+
 // =======================
 // Vector Constructors
 // =======================
@@ -77,7 +85,25 @@ mat4 mat4_rotate_y(float angle);
 mat4 mat4_rotate_z(float angle);
 mat4 mat4_rotate_xyz(float rx, float ry, float rz);
 mat4 mat4_perspective(float l, float r, float b, float t, float n, float f);
+mat4 mat4_orthographic(float l, float r, float b, float t, float n, float f); // Clip w stays 1
 vec4 mat4_mul_vec4(mat4 m, vec4 v);
 mat4 mat4_mul(mat4 a, mat4 b);
 
+// =======================
+// Quaternion Operations
+// =======================
+
+quat quat_identity(void);
+quat quat_from_axis_angle(float ax, float ay, float az, float angle);
+quat quat_from_euler_xyz(float rx, float ry, float rz);   // Same rotation as mat4_rotate_xyz
+quat quat_mul(quat a, quat b);
+quat quat_normalize(quat q);
+quat quat_slerp(quat a, quat b, float t);                  // Shortest arc, normalized lerp when nearly equal
+mat4 mat4_from_quat(quat q);
+mat4 mat4_from_trs(const float translation[3], quat rotation, const float scale[3]); // T * R * S
+
+// True if m is a rigid transform up to uniform scale (rotation/reflection * s + translation, no projection).
+// Writes the unscaled rotation as a column-major 3x3 when rotation is not NULL.
+bool mat4_rigid_rotation(mat4 m, float rotation[9]);
+
 #endif
\ No newline at end of file
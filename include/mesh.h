@@ -0,0 +1,65 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include "tiny3d.h" // object3d_t and compact_mesh_t live in renderer.h
+
+// Build a compact copy of an object for rendering with render_wireframe_compact.
+// Positions are packed as float3 or quantized to int16 over the object's bounding box,
+// and edge indices are stored as 16 bits whenever the vertex count allows.
+// Returns NULL on allocation failure or if the object is empty.
+compact_mesh_t *compact_mesh_create(const object3d_t *object, mesh_position_format_t format);
+
+// Free the memory used by a compact mesh
+void compact_mesh_destroy(compact_mesh_t *mesh);
+
+// Matrix that maps stored positions back to object space (translate * scale).
+// Multiply it onto the right of a model matrix to render the mesh directly.
+mat4 compact_mesh_dequant_matrix(const compact_mesh_t *mesh);
+
+// Build the edge -> face adjacency (object->edge_faces) from object->faces and the edge list.
+// Each edge gets up to two adjacent triangles; diagonals not in the edge list are ignored.
+// object->edge_faces must be NULL or a previous result, it is replaced.
+// Returns 0 on success, -1 on failure.
+int object3d_build_edge_faces(object3d_t *object);
+
+// Cache the normalized object-space direction of every edge (object->edge_dirs).
+// With the cache, rigid models are lit in object space: the lights are rotated into the object once per draw
+// instead of transforming and normalizing every edge. Rebuild it after moving vertices or editing the edge list.
+// object->edge_dirs must be NULL or a previous result, it is replaced.
+// Returns 0 on success, -1 on failure.
+int object3d_build_edge_dirs(object3d_t *object);
+
+// =======================
+// Procedural Meshes
+// =======================
+
+// Generators for test and benchmark geometry. Each builds vertices, a deduplicated edge list and, for surfaces,
+// counter-clockwise triangles (so object3d_build_edge_faces and render_solid work) in time linear in the output.
+// The object and its arrays are malloc'd; free them with object3d_destroy. Returns NULL on allocation failure
+// or if the resolution is out of range.
+
+// Truncated icosahedron (soccer ball) with unit circumradius: 60 vertices, 90 edges, no faces
+object3d_t *mesh_create_truncated_icosahedron(void);
+
+// Unit icosphere: an icosahedron subdivided `level` times (0..10), 30 * 4^level edges
+object3d_t *mesh_create_icosphere(int level);
+
+// Flat grid of cols x rows quads in the XZ plane, centered on the origin, facing +y.
+// Quad diagonals are faces only, so the edge list is the 2*cols*rows + cols + rows grid lines.
+object3d_t *mesh_create_grid(int cols, int rows, float width, float depth);
+
+// Torus around the y axis with major_segments >= 3 rings of minor_segments >= 3 vertices
+object3d_t *mesh_create_torus(int major_segments, int minor_segments, float major_radius, float minor_radius);
+
+// Cylinder along the y axis, centered on the origin, with segments >= 3 around and stacks >= 1 along it.
+// Capped cylinders close each end with a fan around a center vertex.
+object3d_t *mesh_create_cylinder(int segments, int stacks, float radius, float height, bool capped);
+
+// Line soup of num_lines unconnected segments starting inside the cube [-extent, extent]^3,
+// each at most max_length long. The same seed always gives the same lines. No faces.
+object3d_t *mesh_create_random_lines(int num_lines, float extent, float max_length, uint32_t seed);
+
+// Free an object from the mesh_create_* functions, including the optional face, adjacency and direction arrays
+void object3d_destroy(object3d_t *object);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef POINTS_H
+#define POINTS_H
+
+#include "tiny3d.h" // canvas_t, mat4 and render_context_t
+
+// A point cloud stored as structure-of-arrays positions in object space
+typedef struct {
+    float* x;
+    float* y;
+    float* z;
+    int count;
+} point_cloud_t;
+
+// Render every point of the cloud as an anti-aliased disc of point_size pixels (additive, like set_pixel_f).
+// Positions go through one combined model-view-projection matrix in cache-sized batches and are splatted
+// with precomputed sub-pixel footprint kernels. With ctx->bin_points the splats are ordered by screen tile.
+void render_point_cloud(render_context_t *ctx, canvas_t *canvas, const point_cloud_t *cloud, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float point_size, color_t color);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "canvas.h"
+
+// A triangle corner after projection to the screen
+typedef struct {
+    float x, y;       // Screen position in pixels (Y down)
+    float z;          // NDC depth, smaller is closer
+    float intensity;  // Shade in [0, 1], interpolated across the triangle (Gouraud)
+} raster_vertex_t;
+
+// Fill a triangle with color scaled by the interpolated intensity.
+// Uses tiled half-space edge functions evaluated 4 pixels at a time with a top-left fill rule.
+// Pixels are depth tested against canvas->depth when the canvas has a depth buffer.
+// Either winding is accepted.
+void draw_triangle_f(canvas_t *canvas, const raster_vertex_t *v0, const raster_vertex_t *v1, const raster_vertex_t *v2, color_t color);
+
+#endif
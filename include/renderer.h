@@ -10,15 +10,129 @@ typedef struct {
     int num_vertices;
     int* indices;       // Array of vertex indices defining edges (pairs of indices)
     int num_indices;    // Total number of indices (should be even)
+    int* faces;         // Optional triangle list (3 indices per face, counter-clockwise seen from outside), NULL if unused
+    int num_faces;
+    int* edge_faces;    // Optional edge -> face adjacency (2 face indices per edge, -1 if none), see object3d_build_edge_faces
+    float* edge_dirs;   // Optional unit edge directions in object space (3 floats per edge), see object3d_build_edge_dirs
 } object3d_t;
 
+// Storage format of the positions in a compact mesh
+typedef enum {
+    MESH_POSITIONS_FLOAT3,   // Packed x,y,z floats (12 bytes per vertex)
+    MESH_POSITIONS_QUANT16   // Packed x,y,z int16 quantized to the bounding box (6 bytes per vertex)
+} mesh_position_format_t;
+
+// Compact alternative to object3d_t for large wireframe meshes (see mesh.h to build one)
+typedef struct {
+    mesh_position_format_t position_format;
+    void* positions;          // float[3 * num_vertices] or int16_t[3 * num_vertices]
+    int num_vertices;
+    void* indices;            // Edge index pairs, uint16_t or uint32_t depending on index_size
+    int index_size;           // 2 when num_vertices <= 65536, otherwise 4
+    int num_indices;
+    float dequant_offset[3];  // Object-space position = dequant_offset + stored * dequant_scale
+    float dequant_scale[3];
+} compact_mesh_t;
+
+// Edge culling modes for objects with a face list and edge adjacency
+typedef enum {
+    EDGE_CULL_NONE,        // Draw every edge
+    EDGE_CULL_BACKFACE,    // Skip edges whose adjacent faces all face away from the camera
+    EDGE_CULL_SILHOUETTE   // Draw only edges between a front-facing and a back-facing face
+} edge_cull_mode_t;
+
+// Shading modes for filled triangles
+typedef enum {
+    SHADE_FLAT,     // One lighting intensity per face
+    SHADE_GOURAUD   // Lighting evaluated per vertex and interpolated across the face
+} shade_mode_t;
+
+// Depth cueing for wireframe edges, by eye distance (clip w) of the edge midpoint
+typedef enum {
+    FOG_NONE,      // No depth cueing
+    FOG_LINEAR,    // Full intensity up to fog_start, fading linearly to zero at fog_end
+    FOG_EXP,       // exp(-fog_density * distance)
+    FOG_EXP2       // exp(-(fog_density * distance)^2)
+} fog_mode_t;
+
+// Renderer settings shared across draw calls
+typedef struct {
+    edge_cull_mode_t cull_mode;
+    shade_mode_t shade_mode;     // Filled triangles: flat or Gouraud lighting
+    bool double_sided;           // Filled triangles: also fill faces pointing away from the camera
+    bool edge_overlay;           // Filled triangles: draw the front-facing edges on top of the fill
+    color_t fill_color;          // Filled triangles: base color scaled by the lighting intensity
+    bool bin_points;             // Point clouds: splat in screen-tile order for cache locality
+    float ambient;               // Minimum light level in [0, 1] added under the Lambert term (0 by default)
+    fog_mode_t fog_mode;         // Wireframes: fade edges with distance; fully faded edges are not drawn
+    float fog_start;             // FOG_LINEAR: distance where fading begins
+    float fog_end;               // FOG_LINEAR: distance where edges disappear
+    float fog_density;           // FOG_EXP and FOG_EXP2: falloff rate per unit of distance
+    render_stats_t *stats;       // Optional stage timers and counters (NULL by default, not owned)
+} render_context_t;
+
+// Initialize a render context with the defaults used by render_wireframe
+void render_context_init(render_context_t *ctx);
+
+// A projected, lit edge ready for rasterization (screen coordinates, Y down)
+typedef struct {
+    float x0, y0;
+    float x1, y1;
+    float average_z; // Average NDC Z of the two endpoints for sorting
+    color_t color;   // Store color for the line
+} render_line_t;
+
 // Structure to hold line data for depth sorting
 vec4 project_vertex(vec3 vertex, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix);
 
 // Comparison function for qsort to sort lines by average Z (back to front)
 void render_wireframe(canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, vec3* light_dirs, int num_lights);
 
+// render_wireframe with explicit renderer settings (edge culling needs object->faces and object->edge_faces)
+void render_wireframe_ctx(render_context_t *ctx, canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, vec3* light_dirs, int num_lights);
+
+struct light; // light_t, defined in lighting.h
+
+// render_wireframe_ctx lit by light objects (light_t, see lighting.h) instead of direction vectors. Lights whose range
+// misses the object's bounds are skipped, and point/spot lights are only evaluated for edges in the screen tiles they cover.
+void render_wireframe_lit(render_context_t *ctx, canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, const struct light *lights, int num_lights);
+
+// Render object->faces as depth-tested, lit, filled triangles (allocates the canvas depth buffer on first use).
+// Faces must wind counter-clockwise seen from outside; triangles crossing the near plane are clipped.
+void render_solid(render_context_t *ctx, canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, vec3* light_dirs, int num_lights);
+
+// First half of render_wireframe_ctx: project, light and sort the edges back to front into a malloc'd array.
+// Returns the number of lines (free *lines when done), or -1 on failure.
+int render_wireframe_lines(render_context_t *ctx, canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, vec3* light_dirs, int num_lights, render_line_t **lines);
+
+// Second half of render_wireframe_ctx: draw lines in array order
+void render_lines(canvas_t *canvas, const render_line_t *lines, int count, float line_thickness);
+
+// Same as render_wireframe, reading positions and indices straight from a compact mesh.
+// The dequantization transform is folded into the model matrix.
+void render_wireframe_compact(canvas_t *canvas, const compact_mesh_t *mesh, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, vec3* light_dirs, int num_lights);
+
+// Multi-view draws spread views over threads unless built with -DTINY3D_THREADS=0
+#ifndef TINY3D_THREADS
+#define TINY3D_THREADS 1
+#endif
+
+// One camera of a multi-view draw
+typedef struct {
+    canvas_t *canvas;          // Target: its own canvas, or a canvas_region of a shared atlas
+    mat4 view_matrix;
+    mat4 projection_matrix;
+} render_view_t;
+
+// render_wireframe_ctx from several cameras at once. The model transform and the lighting of every edge are
+// done once for all views; each view then projects, culls, fogs, sorts and rasterizes on its own. Every view's
+// image is the same as a render_wireframe_ctx call with its matrices.
+// With num_threads > 1 the views are split over that many threads (the caller's included): their canvases
+// must not overlap or share a render_stats_t, and ctx->stats only receives the shared transform and lighting.
+void render_wireframe_views(render_context_t *ctx, object3d_t *object, mat4 model_matrix, const render_view_t *views, int num_views, float line_thickness, vec3* light_dirs, int num_lights, int num_threads);
+
 // Renders a 3D object as a series of points (particles) on the given canvas.
+// Each vertex becomes an anti-aliased disc point_size pixels wide (see render_point_cloud).
 void render_object_as_points(canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float point_size);
 
 // Draws a point (small filled circle) at the projected location
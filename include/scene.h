@@ -0,0 +1,151 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "tiny3d.h"
+
+// =======================
+// Scene Files
+// =======================
+//
+// A scene describes generated meshes, their animated instances, directional lights and the camera, so demos
+// and tools can change what they draw without recompiling. Text scenes have one directive per line
+// ('#' starts a comment); names must be defined before they are used:
+//
+//   canvas 800 800
+//   frames 240
+//   camera 0 0 3.5                        # eye position, looking down -z
+//   perspective -1 1 -1 1 1 100           # mat4_perspective(left, right, bottom, top, near, far)
+//   light 1 1 1                           # directional light (normalized on load), up to SCENE_MAX_LIGHTS
+//   mesh ball soccer                      # soccer | icosphere L | grid C R W D | torus M m R r
+//                                         # | cylinder S K radius height capped | lines N extent length seed
+//   path loop bezier -1.5 -0.5 0  -0.5 1 -1  -0.5 1 1  -1.5 -0.5 0   # bezier | catmull-rom | bspline
+//   instance ball path=loop scale=0.6 spin=0.5,1,0 ease=sine thickness=1.5 mode=wire
+//
+// Instance keys: at=x,y,z (offset added to the path position), path=name, scale=s, spin=x,y,z (turns about
+// each axis over the animation), ease=linear|step|in-quad|out-quad|sine|in-out-cubic (applied to the spin),
+// thickness=t, mode=wire|solid. At animation time t in [0, 1] an instance's model matrix is
+// translate(at + path(t)) * scale * rotate_xyz(2 pi ease(t) spin).
+//
+// The binary form (scene_save_binary) holds the same records with a header and a string table. Both forms are
+// parsed in one pass over an mmapped file without per-token allocation: text names stay in the mapping, and
+// binary record arrays are used in place.
+
+#define SCENE_MAX_MESHES 64
+#define SCENE_MAX_PATHS 64
+#define SCENE_MAX_POINTS 1024
+#define SCENE_MAX_INSTANCES 1024
+#define SCENE_MAX_LIGHTS 16
+
+// Mesh generators (see mesh.h)
+typedef enum {
+    SCENE_MESH_SOCCER,      // mesh_create_truncated_icosahedron
+    SCENE_MESH_ICOSPHERE,   // i[0] = level
+    SCENE_MESH_GRID,        // i[0] = cols, i[1] = rows, f[0] = width, f[1] = depth
+    SCENE_MESH_TORUS,       // i[0] = major segments, i[1] = minor segments, f[0] = major radius, f[1] = minor radius
+    SCENE_MESH_CYLINDER,    // i[0] = segments, i[1] = stacks, i[2] = capped, f[0] = radius, f[1] = height
+    SCENE_MESH_LINES,       // i[0] = count, i[1] = seed, f[0] = extent, f[1] = max length
+    SCENE_MESH_TYPE_COUNT
+} scene_mesh_type_t;
+
+// Instance drawing modes
+typedef enum {
+    SCENE_DRAW_WIRE,        // render_wireframe
+    SCENE_DRAW_SOLID        // render_solid (needs a mesh with faces)
+} scene_draw_mode_t;
+
+// Records are plain 4-byte fields so the binary form can be used in place
+
+typedef struct {
+    int32_t width, height, frames;
+    float camera[3];
+    float perspective[6];            // left, right, bottom, top, near, far
+} scene_settings_t;
+
+typedef struct {
+    int32_t type;                    // scene_mesh_type_t
+    int32_t i[3];
+    float f[2];
+    uint32_t name_offset, name_length;
+} scene_mesh_t;
+
+typedef struct {
+    int32_t type;                    // path_type_t
+    int32_t first_point, num_points; // Range of scene points (x, y, z triples)
+    uint32_t name_offset, name_length;
+} scene_path_t;
+
+typedef struct {
+    int32_t mesh;                    // Index into meshes
+    int32_t path;                    // Index into paths, -1 for none
+    int32_t mode;                    // scene_draw_mode_t
+    int32_t ease;                    // ease_t applied to the spin
+    float at[3];
+    float scale;
+    float spin[3];
+    float thickness;
+} scene_instance_t;
+
+typedef struct {
+    float direction[3];
+} scene_light_t;
+
+typedef struct {
+    scene_settings_t settings;
+    const scene_mesh_t *meshes;
+    int num_meshes;
+    const scene_path_t *paths;
+    int num_paths;
+    const float *points;
+    int num_points;
+    const scene_instance_t *instances;
+    int num_instances;
+    const scene_light_t *lights;
+    int num_lights;
+    const char *strings;             // Base of name_offset (the text itself, or the binary string table)
+
+    vec3 *light_dirs;                // Normalized light directions for the renderer
+    curve_path_t **curves;           // Catmull-Rom and B-spline paths (NULL for Bézier paths, evaluated directly)
+    object3d_t **objects;            // Generated meshes, NULL until scene_build_meshes
+
+    void *map;                       // File mapping (NULL for scene_parse)
+    size_t map_size;
+    void *storage;                   // Record arrays of a text scene
+} scene_t;
+
+// Load a text or binary (detected by its magic) scene file. Errors are reported on stderr with the line number.
+// Returns NULL on failure.
+scene_t *scene_load(const char *filename);
+
+// Parse a text scene from memory. Names point into text, which must outlive the scene.
+scene_t *scene_parse(const char *text, size_t length);
+
+// Write the binary form of a scene. Returns false on failure.
+bool scene_save_binary(const scene_t *scene, const char *filename);
+
+// Free a scene, its generated meshes and its file mapping
+void scene_destroy(scene_t *scene);
+
+// Generate every mesh (with edge adjacency when it has faces). Returns false on failure.
+bool scene_build_meshes(scene_t *scene);
+
+// Animation time of a frame: 0 at the first frame and 1 at the last
+float scene_frame_time(const scene_t *scene, int frame);
+
+// Camera matrices from the settings
+mat4 scene_view_matrix(const scene_t *scene);
+mat4 scene_projection_matrix(const scene_t *scene);
+
+// Position on a path at t in [0, 1]
+void scene_path_eval(const scene_t *scene, int path, float t, float out[3]);
+
+// Model matrix of an instance at animation time t
+mat4 scene_instance_matrix(const scene_t *scene, int instance, float t);
+
+// Draw every instance at frame `frame` (after scene_build_meshes); the canvas is not cleared.
+// Solid instances enable the canvas depth buffer.
+void scene_render_frame(scene_t *scene, canvas_t *canvas, int frame);
+
+#endif
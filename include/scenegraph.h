@@ -0,0 +1,44 @@
+#ifndef SCENEGRAPH_H
+#define SCENEGRAPH_H
+
+#include "tiny3d.h" // mat4, quat and display_list_t
+
+// Handle to a scene node (-1 for none)
+typedef int scene_node_t;
+
+// Transform hierarchy stored as flat arrays. A node's parent is always created before it, so the
+// arrays are in parent-before-child order and one forward pass updates the whole tree.
+typedef struct {
+    int count;
+    int capacity;
+    int *parent;            // Parent node, -1 for roots
+    int *depth;             // 0 for roots
+    mat4 *local;            // Transform relative to the parent
+    mat4 *world;            // parent world * local, valid after scene_graph_update
+    unsigned char *dirty;   // Local transform changed since the last update
+    draw_handle_t *draw;    // Display list command driven by this node (-1 if none)
+} scene_graph_t;
+
+// Create an empty graph. Returns NULL on allocation failure.
+scene_graph_t *scene_graph_create(void);
+
+// Free a graph
+void scene_graph_destroy(scene_graph_t *graph);
+
+// Add a node under parent (-1 for a root). Returns the node, or -1 for a bad parent or on allocation failure.
+scene_node_t scene_graph_add(scene_graph_t *graph, scene_node_t parent, mat4 local);
+
+// Replace a node's local transform, marking its subtree for update
+void scene_graph_set_local(scene_graph_t *graph, scene_node_t node, mat4 local);
+
+// Set a node's local transform from translation, rotation and scale (T * R * S)
+void scene_graph_set_trs(scene_graph_t *graph, scene_node_t node, const float translation[3], quat rotation, const float scale[3]);
+
+// Drive a display list command with a node's world transform
+void scene_graph_bind(scene_graph_t *graph, scene_node_t node, draw_handle_t handle);
+
+// Recompute world transforms of dirty subtrees only, in one pass over the flat arrays. Bound commands of
+// recomputed nodes get their new transform in list (if not NULL). Returns the number of nodes recomputed.
+int scene_graph_update(scene_graph_t *graph, display_list_t *list);
+
+#endif
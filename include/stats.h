@@ -0,0 +1,93 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Instrumentation is compiled in unless built with -DTINY3D_STATS=0, which removes every timer and counter.
+// When compiled in, nothing is measured until a render_stats_t is attached to a render context or canvas.
+#ifndef TINY3D_STATS
+#define TINY3D_STATS 1
+#endif
+
+// Timed pipeline stages
+typedef enum {
+    STAGE_CLEAR,       // canvas_clear
+    STAGE_TRANSFORM,   // Model/view/projection of vertices
+    STAGE_CULL,        // Face classification for edge culling
+    STAGE_PROJECT,     // Edge setup: near-plane test, perspective divide, screen mapping
+    STAGE_LIGHTING,    // Edge lighting and fog
+    STAGE_SORT,        // Depth sort of lines
+    STAGE_RASTER,      // Lines, triangles and point splats
+    STAGE_COMPOSITE,   // Layer compositing
+    STAGE_SAVE,        // Image output
+    STAGE_COUNT
+} render_stage_t;
+
+// One timed interval, for trace export
+typedef struct {
+    render_stage_t stage;
+    double start_ns;
+    double duration_ns;
+} render_trace_event_t;
+
+// Counters and stage timers. Attach to render_context_t.stats and/or canvas_t.stats.
+typedef struct render_stats {
+    double stage_ns[STAGE_COUNT];      // Total time per stage
+    uint64_t stage_calls[STAGE_COUNT]; // Timed intervals per stage
+    uint64_t vertices_transformed;
+    uint64_t edges_submitted;          // Edges handed to the wireframe pipeline
+    uint64_t edges_culled;             // Dropped by face culling, the near plane or fog
+    uint64_t lines_drawn;
+    uint64_t triangles_drawn;
+    uint64_t points_drawn;
+    uint64_t pixels_written;           // Pixel updates (a bilinear sample touching 4 pixels counts 4)
+    uint64_t bytes_written;            // Image file output
+    uint64_t frames;
+
+    bool trace;                        // Record every interval for render_stats_write_trace
+    render_trace_event_t *events;
+    int num_events;
+    int event_capacity;
+    double *frame_marks;               // Start time of each frame (render_stats_frame)
+    int num_frames;
+    int frame_capacity;
+} render_stats_t;
+
+// Zero all counters (trace off). render_stats_free releases the trace buffers.
+void render_stats_init(render_stats_t *stats);
+void render_stats_free(render_stats_t *stats);
+
+// Zero counters and drop recorded events, keeping the trace setting and buffers
+void render_stats_reset(render_stats_t *stats);
+
+// Mark the start of a frame (shown as an instant event in traces)
+void render_stats_frame(render_stats_t *stats);
+
+// Monotonic clock in nanoseconds
+double render_stats_now(void);
+
+// Add the interval from start_ns to now to a stage (and to the trace if enabled)
+void render_stats_record(render_stats_t *stats, render_stage_t stage, double start_ns);
+
+// Name of a stage, as used in reports and traces
+const char *render_stage_name(render_stage_t stage);
+
+// Print per-stage times and the counters
+void render_stats_print(const render_stats_t *stats);
+
+// Write the recorded intervals as Chrome trace-event JSON (chrome://tracing, Perfetto). Returns false on failure.
+bool render_stats_write_trace(const render_stats_t *stats, const char *filename);
+
+// Instrumentation hooks used inside the library; they compile to nothing with TINY3D_STATS=0
+#if TINY3D_STATS
+#define STATS_BEGIN(stats, start) double start = (stats) ? render_stats_now() : 0.0
+#define STATS_END(stats, stage, start) do { if (stats) render_stats_record((stats), (stage), (start)); } while (0)
+#define STATS_ADD(stats, field, n) do { if (stats) (stats)->field += (n); } while (0)
+#else
+#define STATS_BEGIN(stats, start) do { } while (0)
+#define STATS_END(stats, stage, start) do { } while (0)
+#define STATS_ADD(stats, field, n) do { } while (0)
+#endif
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include "tiny3d.h" // mat4 and quat
+
+// What a track animates and how many floats each of its keys holds
+typedef enum {
+    TRACK_POSITION,   // 3 floats into a transform's translation
+    TRACK_ROTATION,   // 4 floats (quat x, y, z, w) into a transform's rotation, slerped
+    TRACK_SCALE,      // 3 floats into a transform's scale
+    TRACK_FLOAT,      // 1 float into a float slot (light intensity, range, ambient, fog distance...)
+    TRACK_VEC3        // 3 floats into three consecutive float slots (light position or direction...)
+} track_type_t;
+
+// Easing applied between a key and the next one
+typedef enum {
+    EASE_LINEAR,
+    EASE_STEP,          // Hold the key's value until the next key
+    EASE_IN_QUAD,
+    EASE_OUT_QUAD,
+    EASE_IN_OUT_SINE,   // (1 - cos(pi t)) / 2, the easing of the soccer demo
+    EASE_IN_OUT_CUBIC
+} ease_t;
+
+// A keyframed track. Keys are copied into one allocation: times, then values, then easings.
+typedef struct {
+    track_type_t type;
+    int target;             // Transform index (position/rotation/scale) or first float slot (float/vec3)
+    int num_keys;
+    float *times;           // Ascending key times in seconds
+    float *values;          // num_keys * width floats
+    unsigned char *easing;  // ease_t of each key's outgoing segment
+    int cursor;             // Segment used by the last evaluation, so sequential playback never searches
+} anim_track_t;
+
+// A set of tracks evaluated together into model matrices and float slots
+typedef struct {
+    anim_track_t *tracks;
+    int num_tracks;
+    int track_capacity;
+
+    int num_transforms;
+    float *trs;             // Per transform: translation (3), rotation quat (4), scale (3)
+    mat4 *matrices;         // Per transform: T * R * S, rebuilt by timeline_evaluate
+    unsigned char *dirty;   // Per transform: touched by a track since its matrix was last built
+
+    int num_floats;
+    float *floats;          // Float slots written by TRACK_FLOAT and TRACK_VEC3
+
+    float duration;         // Time of the last key of any track
+    bool loop;              // Wrap evaluation times into [0, duration)
+} timeline_t;
+
+// Create a timeline with identity transforms and zeroed float slots. Returns NULL on allocation failure.
+timeline_t *timeline_create(int num_transforms, int num_floats);
+
+// Free a timeline and its tracks
+void timeline_destroy(timeline_t *timeline);
+
+// Add a track, copying its keys (times must ascend). easing may be NULL for linear segments.
+// Returns the track index, or -1 if the target is out of range or on allocation failure.
+int timeline_add_track(timeline_t *timeline, track_type_t type, int target,
+                       const float *times, const float *values, const ease_t *easing, int num_keys);
+
+// Evaluate every track at a time and rebuild the matrices of the transforms they touched.
+// Times before the first key or after the last hold the end values.
+void timeline_evaluate(timeline_t *timeline, float time);
+
+// Eased parameter for t in [0, 1]
+float ease_apply(ease_t ease, float t);
+
+#endif
@@ -9,17 +9,29 @@ extern "C" {
  * tiny3d.h
  * 
  * Main public header for the libtiny3d graphics library.
- * Includes all necessary modules: canvas, math3d, renderer, lighting.
+ * Includes all necessary modules: stats, canvas, math3d, renderer, lighting, animation, mesh, raster, points,
+ * display_list, timeline, scenegraph, scene, gif, frame_ring, layers.
  * 
  * Usage: 
  *   #include "tiny3d.h"
  */
 
+#include "stats.h"
 #include "canvas.h"
 #include "math3d.h"
 #include "renderer.h"
 #include "lighting.h"
 #include "animation.h" 
+#include "mesh.h"
+#include "raster.h"
+#include "points.h"
+#include "display_list.h"
+#include "timeline.h"
+#include "scenegraph.h"
+#include "scene.h"
+#include "gif.h"
+#include "frame_ring.h"
+#include "layers.h"
 
 #ifdef __cplusplus
 }
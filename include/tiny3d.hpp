@@ -0,0 +1,297 @@
+#ifndef TINY3D_HPP
+#define TINY3D_HPP
+
+/*
+ * tiny3d.hpp
+ *
+ * Header-only C++20 layer over libtiny3d (link with -ltiny3d as usual).
+ *  - Canvas and Mesh own a canvas_t / object3d_t. They can be moved but not copied, so pixel buffers and
+ *    vertex arrays are never duplicated behind the caller's back. A failed factory gives an empty object
+ *    that tests false, like the NULL returns of the C API.
+ *  - Batch math over std::span instead of pointer and count pairs.
+ *  - Stages specialized at compile time: the light count (std::array size), the clipping mode of
+ *    project_points and the pixel format of read_pixels are template parameters, so their inner loops
+ *    carry no per-element checks for them.
+ *
+ * Usage:
+ *   #include "tiny3d.hpp"
+ */
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include "tiny3d.h"
+
+namespace tiny3d {
+
+// =======================
+// Canvas
+// =======================
+
+class Canvas {
+public:
+    Canvas() noexcept = default;
+    Canvas(int width, int height) noexcept : canvas_(canvas_create(width, height)) {}
+    explicit Canvas(canvas_t *canvas) noexcept : canvas_(canvas) {} // Takes ownership
+
+    // Draw into caller memory (see canvas_wrap); the pixels must outlive the canvas
+    static Canvas wrap(int width, int height, color_t *pixels, int stride) noexcept {
+        return Canvas(canvas_wrap(width, height, pixels, stride));
+    }
+    static Canvas load_pgm(const char *filename) noexcept { return Canvas(canvas_load_pgm(filename)); }
+    static Canvas load_qoi(const char *filename) noexcept { return Canvas(canvas_load_qoi(filename)); }
+
+    Canvas(Canvas &&other) noexcept : canvas_(std::exchange(other.canvas_, nullptr)) {}
+    Canvas &operator=(Canvas &&other) noexcept {
+        if (this != &other) {
+            canvas_destroy(canvas_);
+            canvas_ = std::exchange(other.canvas_, nullptr);
+        }
+        return *this;
+    }
+    Canvas(const Canvas &) = delete;
+    Canvas &operator=(const Canvas &) = delete;
+    ~Canvas() { canvas_destroy(canvas_); }
+
+    explicit operator bool() const noexcept { return canvas_ != nullptr; }
+    canvas_t *get() const noexcept { return canvas_; }
+    canvas_t *release() noexcept { return std::exchange(canvas_, nullptr); }
+
+    int width() const noexcept { return canvas_ ? canvas_->width : 0; }
+    int height() const noexcept { return canvas_ ? canvas_->height : 0; }
+    std::span<color_t> row(int y) noexcept { return {canvas_->pixels[y], (std::size_t)canvas_->width}; }
+    std::span<const color_t> row(int y) const noexcept { return {canvas_->pixels[y], (std::size_t)canvas_->width}; }
+
+    void clear() noexcept { canvas_clear(canvas_); }
+    bool enable_depth() noexcept { return canvas_enable_depth(canvas_); }
+    void save_pgm(const char *filename) const noexcept { canvas_save_pgm(canvas_, filename); }
+    bool save_qoi(const char *filename) const noexcept { return canvas_save_qoi(canvas_, filename); }
+
+private:
+    canvas_t *canvas_ = nullptr;
+};
+
+// =======================
+// Mesh
+// =======================
+
+// Owner of an object3d_t built by the mesh_create_* generators (freed with object3d_destroy)
+class Mesh {
+public:
+    Mesh() noexcept = default;
+    explicit Mesh(object3d_t *object) noexcept : object_(object) {} // Takes ownership
+
+    static Mesh truncated_icosahedron() noexcept { return Mesh(mesh_create_truncated_icosahedron()); }
+    static Mesh icosphere(int level) noexcept { return Mesh(mesh_create_icosphere(level)); }
+    static Mesh grid(int cols, int rows, float width, float depth) noexcept {
+        return Mesh(mesh_create_grid(cols, rows, width, depth));
+    }
+    static Mesh torus(int major_segments, int minor_segments, float major_radius, float minor_radius) noexcept {
+        return Mesh(mesh_create_torus(major_segments, minor_segments, major_radius, minor_radius));
+    }
+    static Mesh cylinder(int segments, int stacks, float radius, float height, bool capped) noexcept {
+        return Mesh(mesh_create_cylinder(segments, stacks, radius, height, capped));
+    }
+    static Mesh random_lines(int num_lines, float extent, float max_length, uint32_t seed) noexcept {
+        return Mesh(mesh_create_random_lines(num_lines, extent, max_length, seed));
+    }
+
+    Mesh(Mesh &&other) noexcept : object_(std::exchange(other.object_, nullptr)) {}
+    Mesh &operator=(Mesh &&other) noexcept {
+        if (this != &other) {
+            object3d_destroy(object_);
+            object_ = std::exchange(other.object_, nullptr);
+        }
+        return *this;
+    }
+    Mesh(const Mesh &) = delete;
+    Mesh &operator=(const Mesh &) = delete;
+    ~Mesh() { object3d_destroy(object_); }
+
+    explicit operator bool() const noexcept { return object_ != nullptr; }
+    object3d_t *get() const noexcept { return object_; }
+    object3d_t *release() noexcept { return std::exchange(object_, nullptr); }
+
+    std::span<vec3> vertices() noexcept { return {object_->vertices, (std::size_t)object_->num_vertices}; }
+    std::span<const vec3> vertices() const noexcept { return {object_->vertices, (std::size_t)object_->num_vertices}; }
+    std::span<const int> indices() const noexcept { return {object_->indices, (std::size_t)object_->num_indices}; }
+    int num_edges() const noexcept { return object_ ? object_->num_indices / 2 : 0; }
+
+    // Caches for edge culling and object-space lighting (see mesh.h)
+    bool build_edge_faces() noexcept { return object3d_build_edge_faces(object_) == 0; }
+    bool build_edge_dirs() noexcept { return object3d_build_edge_dirs(object_) == 0; }
+
+private:
+    object3d_t *object_ = nullptr;
+};
+
+// =======================
+// Batch Math
+// =======================
+
+// Directional lights with the count fixed at compile time
+template <std::size_t N>
+using Lights = std::array<vec3, N>;
+
+// Which projected points project_points keeps
+enum class Clip {
+    None,      // Caller guarantees every point is in front of the camera
+    Near,      // Drop points at or behind the near plane (clip w <= epsilon), like the wireframe renderer
+    Frustum    // Drop points outside the view volume (|x|, |y|, |z| > w)
+};
+
+// A projected point in screen coordinates (Y down, as the renderer draws them)
+struct ScreenPoint {
+    float x, y;
+    float z;       // NDC depth
+    int index;     // Position of the point in the input span
+};
+
+// Same epsilon as the renderer's near-plane test
+inline constexpr float kWClipEpsilon = FLT_EPSILON * 100.0f;
+
+// out[i] = m * (points[i], 1). Reads the Cartesian coordinates directly (vec3_from_cartesian keeps them valid).
+inline void transform_points(const mat4 &m, std::span<const vec3> points, std::span<vec4> out) noexcept {
+    const float *a = m.m;
+    std::size_t count = points.size() < out.size() ? points.size() : out.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        float x = points[i].x, y = points[i].y, z = points[i].z;
+        out[i] = {a[0] * x + a[4] * y + a[8] * z + a[12], a[1] * x + a[5] * y + a[9] * z + a[13],
+                  a[2] * x + a[6] * y + a[10] * z + a[14], a[3] * x + a[7] * y + a[11] * z + a[15]};
+    }
+}
+
+// Project points through a model-view-projection matrix onto a width x height screen.
+// Kept points are written to the front of out in input order; returns how many were kept.
+template <Clip Mode>
+std::size_t project_points(const mat4 &mvp, std::span<const vec3> points, int width, int height,
+                           std::span<ScreenPoint> out) noexcept {
+    const float *a = mvp.m;
+    float half_w = 0.5f * width, half_h = 0.5f * height;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < points.size() && kept < out.size(); ++i) {
+        float x = points[i].x, y = points[i].y, z = points[i].z;
+        float cx = a[0] * x + a[4] * y + a[8] * z + a[12];
+        float cy = a[1] * x + a[5] * y + a[9] * z + a[13];
+        float cz = a[2] * x + a[6] * y + a[10] * z + a[14];
+        float cw = a[3] * x + a[7] * y + a[11] * z + a[15];
+        if constexpr (Mode == Clip::Near) {
+            if (!(cw > kWClipEpsilon)) continue;
+        } else if constexpr (Mode == Clip::Frustum) {
+            if (!(cw > kWClipEpsilon) || cx < -cw || cx > cw || cy < -cw || cy > cw || cz < -cw || cz > cw) continue;
+        }
+        float inv_w = 1.0f / cw;
+        out[kept++] = {(cx * inv_w + 1.0f) * half_w, (1.0f - cy * inv_w) * half_h, cz * inv_w, (int)i};
+    }
+    return kept;
+}
+
+// Light unit edge directions against N directional lights: the same gray levels as
+// compute_edge_lighting_batch_unit, with the light loop unrolled for the compile-time count.
+template <std::size_t N>
+void light_edges(std::span<const float> dir_x, std::span<const float> dir_y, std::span<const float> dir_z,
+                 const Lights<N> &lights, float ambient, std::span<unsigned char> out) noexcept {
+    static_assert(N > 0, "use compute_edge_lighting_batch_unit for ambient-only lighting");
+    std::array<vec4, N> l;
+    for (std::size_t k = 0; k < N; ++k) l[k] = vec4_from_vec3(lights[k], 0.0f);
+    constexpr float inv_lights = 1.0f / N;
+    ambient = ambient < 0.0f ? 0.0f : ambient > 1.0f ? 1.0f : ambient;
+    float diffuse_scale = 1.0f - ambient;
+
+    std::size_t count = out.size();
+    for (std::span<const float> s : {dir_x, dir_y, dir_z}) count = s.size() < count ? s.size() : count;
+    for (std::size_t i = 0; i < count; ++i) {
+        float dx = dir_x[i], dy = dir_y[i], dz = dir_z[i];
+        float intensity = [&]<std::size_t... K>(std::index_sequence<K...>) {
+            float sum = 0.0f;
+            ((sum += std::max(0.0f, dx * l[K].x + dy * l[K].y + dz * l[K].z)), ...);
+            return sum;
+        }(std::make_index_sequence<N>{});
+        out[i] = lighting_quantize(ambient + intensity * inv_lights * diffuse_scale);
+    }
+}
+
+// =======================
+// Pixel Formats
+// =======================
+
+// 8-bit gray, converted like canvas_save_pgm
+struct Gray8 {
+    static constexpr std::size_t channels = 1;
+    static void store(unsigned char *dst, color_t c) noexcept { dst[0] = (unsigned char)((c.r + c.g + c.b) / 3.0f); }
+};
+
+struct Rgb8 {
+    static constexpr std::size_t channels = 3;
+    static void store(unsigned char *dst, color_t c) noexcept {
+        dst[0] = c.r;
+        dst[1] = c.g;
+        dst[2] = c.b;
+    }
+};
+
+// Opaque RGBA, e.g. for uploading frames as textures
+struct Rgba8 {
+    static constexpr std::size_t channels = 4;
+    static void store(unsigned char *dst, color_t c) noexcept {
+        dst[0] = c.r;
+        dst[1] = c.g;
+        dst[2] = c.b;
+        dst[3] = 255;
+    }
+};
+
+// Bytes read_pixels<Format> writes for a canvas
+template <class Format>
+std::size_t pixel_bytes(const Canvas &canvas) noexcept {
+    return (std::size_t)canvas.width() * canvas.height() * Format::channels;
+}
+
+// Copy the canvas into a tightly packed buffer in the given format. Returns false if out is too small.
+template <class Format>
+bool read_pixels(const Canvas &canvas, std::span<unsigned char> out) noexcept {
+    if (!canvas || out.size() < pixel_bytes<Format>(canvas)) return false;
+    unsigned char *dst = out.data();
+    for (int y = 0; y < canvas.height(); ++y) {
+        for (color_t c : canvas.row(y)) {
+            Format::store(dst, c);
+            dst += Format::channels;
+        }
+    }
+    return true;
+}
+
+// =======================
+// Rendering
+// =======================
+
+// The C entry points take non-const light arrays but only read them
+template <std::size_t N>
+vec3 *light_data(const Lights<N> &lights) noexcept {
+    return const_cast<vec3 *>(lights.data());
+}
+
+// render_wireframe / render_wireframe_ctx with the light count taken from the array type
+template <std::size_t N>
+void render_wireframe(Canvas &canvas, const Mesh &mesh, const mat4 &model, const mat4 &view, const mat4 &projection,
+                      float line_thickness, const Lights<N> &lights, render_context_t *ctx = nullptr) noexcept {
+    if (ctx) {
+        ::render_wireframe_ctx(ctx, canvas.get(), mesh.get(), model, view, projection, line_thickness, light_data(lights), (int)N);
+    } else {
+        ::render_wireframe(canvas.get(), mesh.get(), model, view, projection, line_thickness, light_data(lights), (int)N);
+    }
+}
+
+// Filled triangles (the mesh needs faces; the canvas depth buffer is allocated on first use)
+template <std::size_t N>
+void render_solid(render_context_t &ctx, Canvas &canvas, const Mesh &mesh, const mat4 &model, const mat4 &view,
+                  const mat4 &projection, const Lights<N> &lights) noexcept {
+    ::render_solid(&ctx, canvas.get(), mesh.get(), model, view, projection, light_data(lights), (int)N);
+}
+
+} // namespace tiny3d
+
+#endif
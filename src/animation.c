@@ -1,4 +1,5 @@
 #include <math.h>
+#include <stdlib.h>
 #include "animation.h"
 #include "math3d.h" 
 
@@ -15,14 +16,308 @@ vec3 bezier_cubic(vec3 p0, vec3 p1, vec3 p2, vec3 p3, float t) {
     float b2 = 3.0f * one_minus_t * t * t;              // 3 * (1-t) * t^2
     float b3 = t * t * t;                               // t^3
 
-    // Scale each control point by its blending factor and sum them up
-    vec3 term0 = vec3_scale(p0, b0);
-    vec3 term1 = vec3_scale(p1, b1);
-    vec3 term2 = vec3_scale(p2, b2);
-    vec3 term3 = vec3_scale(p3, b3);
+    // Blend the Cartesian coordinates directly: going through vec3_scale/vec3_add would recompute
+    // spherical coordinates for every temporary
+    vec4 a = vec4_from_vec3(p0, 1.0f);
+    vec4 b = vec4_from_vec3(p1, 1.0f);
+    vec4 c = vec4_from_vec3(p2, 1.0f);
+    vec4 d = vec4_from_vec3(p3, 1.0f);
 
-    // Sum the terms to get the final point on the curve
-    vec3 result = vec3_add(term0, vec3_add(term1, vec3_add(term2, term3)));
+    // Same summation order as the nested vec3_add calls
+    return vec3_from_cartesian(a.x * b0 + (b.x * b1 + (c.x * b2 + d.x * b3)),
+                               a.y * b0 + (b.y * b1 + (c.y * b2 + d.y * b3)),
+                               a.z * b0 + (b.z * b1 + (c.z * b2 + d.z * b3)));
+}
+
+
+// =======================
+// Curves and Paths
+// =======================
+
+// Power-form coefficients from a 4x4 basis matrix (rows: t^0..t^3, columns: control points) and a scale
+static curve_segment_t segment_from_basis(const float basis[4][4], float scale,
+                                          const float *p0, const float *p1, const float *p2, const float *p3) {
+    curve_segment_t segment;
+    const float *p[4] = {p0, p1, p2, p3};
+    for (int k = 0; k < 4; ++k) {
+        for (int axis = 0; axis < 3; ++axis) {
+            segment.c[k][axis] = scale * (basis[k][0] * p[0][axis] + basis[k][1] * p[1][axis] +
+                                          basis[k][2] * p[2][axis] + basis[k][3] * p[3][axis]);
+        }
+    }
+    return segment;
+}
+
+// Cubic Bézier basis
+static const float BEZIER_BASIS[4][4] = {
+    { 1,  0,  0, 0},
+    {-3,  3,  0, 0},
+    { 3, -6,  3, 0},
+    {-1,  3, -3, 1}
+};
+
+// Catmull-Rom basis (scaled by 1/2)
+static const float CATMULL_ROM_BASIS[4][4] = {
+    { 0,  2,  0,  0},
+    {-1,  0,  1,  0},
+    { 2, -5,  4, -1},
+    {-1,  3, -3,  1}
+};
+
+// Uniform cubic B-spline basis (scaled by 1/6)
+static const float BSPLINE_BASIS[4][4] = {
+    { 1,  4,  1, 0},
+    {-3,  0,  3, 0},
+    { 3, -6,  3, 0},
+    {-1,  3, -3, 1}
+};
+
+// Bézier segment coefficients
+curve_segment_t curve_segment_bezier(const float p0[3], const float p1[3], const float p2[3], const float p3[3]) {
+    return segment_from_basis(BEZIER_BASIS, 1.0f, p0, p1, p2, p3);
+}
+
+// Evaluate a segment at t
+void curve_segment_eval(const curve_segment_t *segment, float t, float out[3]) {
+    for (int axis = 0; axis < 3; ++axis) {
+        out[axis] = ((segment->c[3][axis] * t + segment->c[2][axis]) * t + segment->c[1][axis]) * t + segment->c[0][axis];
+    }
+}
+
+// Forward-difference sampling of a segment (t = 0, h, 2h, ..., 1)
+void curve_segment_sample(const curve_segment_t *segment, int count, float *out) {
+    if (segment == NULL || out == NULL || count < 1) return;
+    if (count == 1) {
+        curve_segment_eval(segment, 0.0f, out);
+        return;
+    }
+
+    float h = 1.0f / (count - 1);
+    float h2 = h * h;
+    float h3 = h2 * h;
+
+    // Value and first three differences at t = 0 (accumulated in double to limit drift over long runs)
+    double f[3], d1[3], d2[3], d3[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        float a = segment->c[3][axis], b = segment->c[2][axis], c = segment->c[1][axis];
+        f[axis] = segment->c[0][axis];
+        d1[axis] = a * h3 + b * h2 + c * h;
+        d2[axis] = 6.0f * a * h3 + 2.0f * b * h2;
+        d3[axis] = 6.0f * a * h3;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            out[3 * i + axis] = (float)f[axis];
+            f[axis] += d1[axis];
+            d1[axis] += d2[axis];
+            d2[axis] += d3[axis];
+        }
+    }
+
+    // Land exactly on the end point
+    curve_segment_eval(segment, 1.0f, out + 3 * (count - 1));
+}
+
+// Chords per segment for the length measured at creation (the arc table refines it)
+#define PATH_LENGTH_SAMPLES 16
+
+// Sum of chord lengths over every segment
+static float measure_path_length(const curve_path_t *path) {
+    float points[(PATH_LENGTH_SAMPLES + 1) * 3];
+    float length = 0.0f;
+    for (int s = 0; s < path->num_segments; ++s) {
+        curve_segment_sample(&path->segments[s], PATH_LENGTH_SAMPLES + 1, points);
+        for (int i = 1; i <= PATH_LENGTH_SAMPLES; ++i) {
+            float dx = points[3 * i] - points[3 * i - 3];
+            float dy = points[3 * i + 1] - points[3 * i - 2];
+            float dz = points[3 * i + 2] - points[3 * i - 1];
+            length += sqrtf(dx * dx + dy * dy + dz * dz);
+        }
+    }
+    return length;
+}
+
+// Build a path from control points
+curve_path_t *curve_path_create(path_type_t type, const float *points, int num_points) {
+    if (points == NULL) return NULL;
+
+    int num_segments;
+    switch (type) {
+        case PATH_BEZIER:
+            num_segments = num_points >= 4 ? (num_points - 1) / 3 : 0;
+            break;
+        case PATH_CATMULL_ROM:
+            num_segments = num_points - 1;
+            break;
+        case PATH_BSPLINE:
+            num_segments = num_points - 3;
+            break;
+        default:
+            return NULL;
+    }
+    if (num_segments < 1) return NULL;
+
+    curve_path_t *path = calloc(1, sizeof(curve_path_t));
+    if (!path) return NULL;
+    path->segments = malloc(num_segments * sizeof(curve_segment_t));
+    if (!path->segments) {
+        free(path);
+        return NULL;
+    }
+    path->num_segments = num_segments;
 
-    return result;
+    for (int s = 0; s < num_segments; ++s) {
+        if (type == PATH_BEZIER) {
+            const float *p = points + 9 * s;
+            path->segments[s] = segment_from_basis(BEZIER_BASIS, 1.0f, p, p + 3, p + 6, p + 9);
+        } else if (type == PATH_CATMULL_ROM) {
+            // Segment s runs from point s to point s + 1; clamp the outer neighbours at the ends
+            int i0 = s > 0 ? s - 1 : 0;
+            int i3 = s + 2 < num_points ? s + 2 : num_points - 1;
+            path->segments[s] = segment_from_basis(CATMULL_ROM_BASIS, 0.5f, points + 3 * i0, points + 3 * s,
+                                                   points + 3 * (s + 1), points + 3 * i3);
+        } else {
+            const float *p = points + 3 * s;
+            path->segments[s] = segment_from_basis(BSPLINE_BASIS, 1.0f / 6.0f, p, p + 3, p + 6, p + 9);
+        }
+    }
+    path->length = measure_path_length(path);
+    return path;
 }
+
+// Free a path
+void curve_path_destroy(curve_path_t *path) {
+    if (!path) return;
+    free(path->segments);
+    free(path->arc_params);
+    free(path);
+}
+
+// Map u in [0, 1] to a segment and its local t
+static inline int path_locate(const curve_path_t *path, float u, float *t) {
+    u = fmaxf(0.0f, fminf(1.0f, u));
+    float x = u * path->num_segments;
+    int s = (int)x;
+    if (s >= path->num_segments) s = path->num_segments - 1;
+    *t = x - s;
+    return s;
+}
+
+// Evaluate a path at u
+void curve_path_eval(const curve_path_t *path, float u, float out[3]) {
+    if (path == NULL || out == NULL) return;
+    float t;
+    int s = path_locate(path, u, &t);
+    curve_segment_eval(&path->segments[s], t, out);
+}
+
+// Sample a path at evenly spaced u
+void curve_path_sample(const curve_path_t *path, int count, float *out) {
+    if (path == NULL || out == NULL || count < 1) return;
+    if (count == 1) {
+        curve_path_eval(path, 0.0f, out);
+        return;
+    }
+
+    // Samples at u = i / (count - 1) fall into segment s for i in [first, next): difference forward
+    // inside each segment from its first sample, restarting exactly at every segment boundary
+    float step = (float)path->num_segments / (count - 1); // Segment-local t per sample
+    int i = 0;
+    for (int s = 0; s < path->num_segments && i < count; ++s) {
+        int next = (s == path->num_segments - 1) ? count : (int)ceilf((s + 1) / step - 1e-4f);
+        if (next > count) next = count;
+        if (next <= i) continue;
+
+        const curve_segment_t *seg = &path->segments[s];
+        float t0 = i * step - s;
+        double f[3], d1[3], d2[3], d3[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            float a = seg->c[3][axis], b = seg->c[2][axis], c = seg->c[1][axis];
+            float h = step, h2 = step * step, h3 = h2 * step;
+
+            // Differences of a cubic at t0 with step h
+            f[axis] = ((a * t0 + b) * t0 + c) * t0 + seg->c[0][axis];
+            d1[axis] = a * (3.0f * t0 * t0 * h + 3.0f * t0 * h2 + h3) + b * (2.0f * t0 * h + h2) + c * h;
+            d2[axis] = a * (6.0f * t0 * h2 + 6.0f * h3) + 2.0f * b * h2;
+            d3[axis] = 6.0f * a * h3;
+        }
+
+        for (; i < next; ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                out[3 * i + axis] = (float)f[axis];
+                f[axis] += d1[axis];
+                d1[axis] += d2[axis];
+                d2[axis] += d3[axis];
+            }
+        }
+    }
+
+    curve_path_eval(path, 1.0f, out + 3 * (count - 1));
+}
+
+// Measure the path and build the distance -> parameter table
+bool curve_path_build_arc_table(curve_path_t *path, int samples_per_segment) {
+    if (path == NULL) return false;
+    if (samples_per_segment < 1) samples_per_segment = 1;
+
+    // Cumulative chord lengths at evenly spaced u
+    int n = path->num_segments * samples_per_segment;
+    float *points = malloc((n + 1) * 3 * sizeof(float));
+    float *cumulative = malloc((n + 1) * sizeof(float));
+    float *params = malloc((n + 1) * sizeof(float));
+    if (!points || !cumulative || !params) {
+        free(points);
+        free(cumulative);
+        free(params);
+        return false;
+    }
+    curve_path_sample(path, n + 1, points);
+
+    cumulative[0] = 0.0f;
+    for (int i = 1; i <= n; ++i) {
+        float dx = points[3 * i] - points[3 * i - 3];
+        float dy = points[3 * i + 1] - points[3 * i - 2];
+        float dz = points[3 * i + 2] - points[3 * i - 1];
+        cumulative[i] = cumulative[i - 1] + sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+    float length = cumulative[n];
+
+    // Invert into u at n + 1 evenly spaced distances, walking both tables once
+    int j = 0;
+    for (int k = 0; k <= n; ++k) {
+        float s = length * k / n;
+        while (j < n - 1 && cumulative[j + 1] < s) j++;
+        float span = cumulative[j + 1] - cumulative[j];
+        float frac = span > 0.0f ? (s - cumulative[j]) / span : 0.0f;
+        params[k] = (j + fmaxf(0.0f, fminf(1.0f, frac))) / n;
+    }
+    params[0] = 0.0f;
+    params[n] = 1.0f;
+
+    free(points);
+    free(cumulative);
+    free(path->arc_params);
+    path->arc_params = params;
+    path->arc_samples = n;
+    path->length = length;
+    return true;
+}
+
+// Path parameter at an arc length
+float curve_path_param_at_distance(const curve_path_t *path, float s) {
+    if (path == NULL || path->length <= 0.0f) return 0.0f;
+    float u = fmaxf(0.0f, fminf(1.0f, s / path->length));
+    if (path->arc_params == NULL) return u;
+
+    float x = u * path->arc_samples;
+    int k = (int)x;
+    if (k >= path->arc_samples) return 1.0f;
+    float frac = x - k;
+    return path->arc_params[k] + (path->arc_params[k + 1] - path->arc_params[k]) * frac;
+}
+
+// Evaluate a path at an arc length
+void curve_path_eval_distance(const curve_path_t *path, float s, float out[3]) {
+    curve_path_eval(path, curve_path_param_at_distance(path, s), out);
+}
\ No newline at end of file
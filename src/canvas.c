@@ -3,9 +3,40 @@
 #include <string.h>
 #include <math.h>
 #include <stdbool.h>
+#include <float.h>
 #include "tiny3d.h"
 #include "canvas.h"
 
+// Extra floats allocated after the depth buffer for unaligned 4-wide loads
+#define DEPTH_ROW_PADDING 4
+
+// Check if a pixel is within a circular viewport centered in the canvas
+static bool is_pixel_in_circular_viewport(canvas_t *canvas, int px, int py) {
+    if (canvas == NULL) return false;
+    float center_x = canvas->width / 2.0f;
+    float center_y = canvas->height / 2.0f;
+    float radius = fminf(center_x, center_y);
+
+    float dist_sq = (px - center_x) * (px - center_x) + (py - center_y) * (py - center_y);
+    return dist_sq <= (radius * radius);
+}
+
+// Precompute the circular viewport span of every row so per-pixel tests become a table lookup
+static void build_viewport_spans(canvas_t *canvas) {
+    for (int y = 0; y < canvas->height; ++y) {
+        int lo = 0;
+        while (lo < canvas->width && !is_pixel_in_circular_viewport(canvas, lo, y)) lo++;
+        int hi = canvas->width - 1;
+        while (hi >= lo && !is_pixel_in_circular_viewport(canvas, hi, y)) hi--;
+        if (lo > hi) {
+            lo = 0;
+            hi = -1;
+        }
+        canvas->viewport_spans[2 * y] = lo;
+        canvas->viewport_spans[2 * y + 1] = hi;
+    }
+}
+
 // Define a color_t struct to represent RGB colors
 canvas_t *canvas_create(int width, int height) {
     canvas_t *canvas = malloc(sizeof(canvas_t));
@@ -14,6 +45,10 @@ canvas_t *canvas_create(int width, int height) {
     // Initialize canvas dimensions
     canvas->width = width;
     canvas->height = height;
+    canvas->depth = NULL;
+    canvas->stats = NULL;
+    canvas->owns_pixels = true;
+    canvas->line_mode = LINE_RASTER_FLOAT;
 
     // Allocate for color_t pixels
     canvas->pixels = malloc(height * sizeof(color_t *));
@@ -34,26 +69,104 @@ canvas_t *canvas_create(int width, int height) {
             return NULL;
         }
     }
+
+    // Circular viewport spans, one [first, last] pair per row
+    canvas->viewport_spans = malloc(2 * height * sizeof(int));
+    if (!canvas->viewport_spans) {
+        for (int y = 0; y < height; ++y) free(canvas->pixels[y]);
+        free(canvas->pixels);
+        free(canvas);
+        return NULL;
+    }
+    build_viewport_spans(canvas);
+    return canvas;
+}
+
+// Canvas whose rows point into memory it does not own; only the row table and viewport spans are allocated
+static canvas_t *alloc_borrowed(int width, int height) {
+    canvas_t *canvas = calloc(1, sizeof(canvas_t));
+    if (!canvas) return NULL;
+    canvas->width = width;
+    canvas->height = height;
+    canvas->owns_pixels = false;
+    canvas->pixels = malloc(height * sizeof(color_t *));
+    canvas->viewport_spans = malloc(2 * height * sizeof(int));
+    if (!canvas->pixels || !canvas->viewport_spans) {
+        free(canvas->pixels);
+        free(canvas->viewport_spans);
+        free(canvas);
+        return NULL;
+    }
+    return canvas;
+}
+
+// Rows point into the caller's memory
+canvas_t *canvas_wrap(int width, int height, color_t *pixels, int stride) {
+    if (pixels == NULL || width < 1 || height < 1 || stride < width) return NULL;
+    canvas_t *canvas = alloc_borrowed(width, height);
+    if (!canvas) return NULL;
+    for (int y = 0; y < height; ++y) canvas->pixels[y] = pixels + (size_t)y * stride;
+    build_viewport_spans(canvas);
+    return canvas;
+}
+
+// Rows point into a rectangle of the parent's rows
+canvas_t *canvas_region(canvas_t *parent, int x, int y, int width, int height) {
+    if (parent == NULL || x < 0 || y < 0 || width < 1 || height < 1 ||
+        x + width > parent->width || y + height > parent->height) {
+        return NULL;
+    }
+    canvas_t *canvas = alloc_borrowed(width, height);
+    if (!canvas) return NULL;
+    for (int row = 0; row < height; ++row) canvas->pixels[row] = parent->pixels[y + row] + x;
+    canvas->line_mode = parent->line_mode;
+    build_viewport_spans(canvas);
     return canvas;
 }
 
 // Free the memory used by the canvas
 void canvas_destroy(canvas_t *canvas) {
     if (!canvas) return;
-    for (int y = 0; y < canvas->height; ++y) {
+    for (int y = 0; y < canvas->height && canvas->owns_pixels; ++y) {
         free(canvas->pixels[y]);
     }
     free(canvas->pixels);
+    free(canvas->depth);
+    free(canvas->viewport_spans);
     free(canvas);
 }
 
+// Reset every depth value to "infinitely far"
+static void clear_depth(canvas_t *canvas) {
+    int count = canvas->width * canvas->height;
+    for (int i = 0; i < count; ++i) {
+        canvas->depth[i] = FLT_MAX;
+    }
+}
+
+// Allocate the depth buffer (padded so 4-wide loads at the end of a row stay in bounds)
+bool canvas_enable_depth(canvas_t *canvas) {
+    if (!canvas) return false;
+    if (canvas->depth) return true;
+
+    canvas->depth = malloc((canvas->width * canvas->height + DEPTH_ROW_PADDING) * sizeof(float));
+    if (!canvas->depth) return false;
+    clear_depth(canvas);
+    return true;
+}
+
 // Clear the canvas to black (0.0 intensity for all channels)
 void canvas_clear(canvas_t *canvas) {
     if (!canvas) return;
+    STATS_BEGIN(canvas->stats, start);
     // Clear all color channels to 0 (black)
     for (int y = 0; y < canvas->height; ++y) {
         memset(canvas->pixels[y], 0, canvas->width * sizeof(color_t));
     }
+    if (canvas->depth) {
+        clear_depth(canvas);
+    }
+    STATS_END(canvas->stats, STAGE_CLEAR, start);
 }
 
 
@@ -62,24 +175,25 @@ static unsigned char clamp_uchar(float x) {
     return (unsigned char)fminf(255.0f, fmaxf(0.0f, x));
 }
 
-// Check if a pixel is within a circular viewport centered in the canvas
-static bool is_pixel_in_circular_viewport(canvas_t *canvas, int px, int py) {
-    if (canvas == NULL) return false;
-    float center_x = canvas->width / 2.0f;
-    float center_y = canvas->height / 2.0f;
-    float radius = fminf(center_x, center_y);
-
-    float dist_sq = (px - center_x) * (px - center_x) + (py - center_y) * (py - center_y);
-    return dist_sq <= (radius * radius);
+// Get the span of row y inside the circular viewport
+bool canvas_row_viewport(canvas_t *canvas, int y, int *x_min, int *x_max) {
+    if (canvas == NULL || y < 0 || y >= canvas->height) return false;
+    int lo = canvas->viewport_spans[2 * y];
+    int hi = canvas->viewport_spans[2 * y + 1];
+    if (lo > hi) return false;
+    *x_min = lo;
+    *x_max = hi;
+    return true;
 }
 
 // Helper to add weighted color to a pixel
 static void add_weighted_color(canvas_t *c, int px, int py, color_t src_color, float weight) {
     if (px >= 0 && px < c->width && py >= 0 && py < c->height) {
-        if (is_pixel_in_circular_viewport(c, px, py)) { // Check viewport for each sub-pixel
+        if (px >= c->viewport_spans[2 * py] && px <= c->viewport_spans[2 * py + 1]) { // Check viewport for each sub-pixel
             c->pixels[py][px].r = clamp_uchar(c->pixels[py][px].r + src_color.r * weight);
             c->pixels[py][px].g = clamp_uchar(c->pixels[py][px].g + src_color.g * weight);
             c->pixels[py][px].b = clamp_uchar(c->pixels[py][px].b + src_color.b * weight);
+            STATS_ADD(c->stats, pixels_written, 1);
         }
     }
 }
@@ -107,9 +221,22 @@ void set_pixel_f(canvas_t *canvas, float x, float y, color_t color) {
     add_weighted_color(canvas, x1, y1, color, w11);
 }
 
+// Round a pixel coordinate to 24.8 fixed point. Scaling by a power of two is exact, so the result does not
+// depend on FMA contraction; out-of-range values (and NaN) are clamped.
+static int32_t to_fixed(float v) {
+    float s = v * CANVAS_SUBPIXEL_ONE;
+    if (!(s > -2.0e9f)) return -2000000000;
+    if (!(s < 2.0e9f)) return 2000000000;
+    return (int32_t)floorf(s + 0.5f);
+}
+
 // draw_line_f now takes a color_t
 void draw_line_f(canvas_t *canvas, float x0, float y0, float x1, float y1, float thickness, color_t color) {
-    
+    if (canvas != NULL && canvas->line_mode == LINE_RASTER_FIXED) {
+        draw_line_fixed(canvas, to_fixed(x0), to_fixed(y0), to_fixed(x1), to_fixed(y1), color);
+        return;
+    }
+
     float dx = x1 - x0;
     float dy = y1 - y0;
 
@@ -128,8 +255,61 @@ void draw_line_f(canvas_t *canvas, float x0, float y0, float x1, float y1, float
     }
 }
 
+// Add color * weight / 65536 to a pixel inside the viewport (weight in [0, 65536]), truncating like add_weighted_color
+static void add_fixed_weight(canvas_t *c, int px, int py, color_t src_color, int weight) {
+    if (px >= 0 && px < c->width && py >= 0 && py < c->height &&
+        px >= c->viewport_spans[2 * py] && px <= c->viewport_spans[2 * py + 1]) {
+        color_t *p = &c->pixels[py][px];
+        int r = p->r + ((src_color.r * weight) >> 16);
+        int g = p->g + ((src_color.g * weight) >> 16);
+        int b = p->b + ((src_color.b * weight) >> 16);
+        p->r = (unsigned char)(r > 255 ? 255 : r);
+        p->g = (unsigned char)(g > 255 ? 255 : g);
+        p->b = (unsigned char)(b > 255 ? 255 : b);
+        STATS_ADD(c->stats, pixels_written, 1);
+    }
+}
+
+// Floor division (b > 0) without relying on how >> treats negative numbers
+static inline int64_t floor_div(int64_t a, int64_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Fixed-point DDA: the same step count as draw_line_f, with positions carried 16 bits below the 1/256 pixel
+// grid so the increments accumulate without drift
+void draw_line_fixed(canvas_t *canvas, int32_t x0, int32_t y0, int32_t x1, int32_t y1, color_t color) {
+    if (canvas == NULL) return;
+    int64_t dx = (int64_t)x1 - x0;
+    int64_t dy = (int64_t)y1 - y0;
+    int64_t adx = dx < 0 ? -dx : dx;
+    int64_t ady = dy < 0 ? -dy : dy;
+    int64_t steps = (adx > ady ? adx : ady) / CANVAS_SUBPIXEL_ONE + 1;
+
+    int64_t x_inc = dx * 65536 / steps;
+    int64_t y_inc = dy * 65536 / steps;
+    int64_t x = (int64_t)x0 * 65536;
+    int64_t y = (int64_t)y0 * 65536;
+    for (int64_t i = 0; i <= steps; ++i) {
+        // 24.8 position, then whole pixel and 8-bit fraction
+        int64_t fx = floor_div(x, 65536), fy = floor_div(y, 65536);
+        int64_t px = floor_div(fx, CANVAS_SUBPIXEL_ONE), py = floor_div(fy, CANVAS_SUBPIXEL_ONE);
+        int wx = (int)(fx - px * CANVAS_SUBPIXEL_ONE), wy = (int)(fy - py * CANVAS_SUBPIXEL_ONE);
+        if (px >= -1 && px < canvas->width && py >= -1 && py < canvas->height) {
+            int ix = (int)px, iy = (int)py;
+            int rx = CANVAS_SUBPIXEL_ONE - wx, ry = CANVAS_SUBPIXEL_ONE - wy;
+            add_fixed_weight(canvas, ix, iy, color, rx * ry);
+            add_fixed_weight(canvas, ix + 1, iy, color, wx * ry);
+            add_fixed_weight(canvas, ix, iy + 1, color, rx * wy);
+            add_fixed_weight(canvas, ix + 1, iy + 1, color, wx * wy);
+        }
+        x += x_inc;
+        y += y_inc;
+    }
+}
+
 // Save the canvas to a PGM file (will convert RGB to grayscale)
 void canvas_save_pgm(canvas_t *canvas, const char *filename) {
+    STATS_BEGIN(canvas->stats, start);
     FILE *f = fopen(filename, "w");
     if (!f) {
         fprintf(stderr, "Error: Could not open file %s for writing.\n", filename);
@@ -146,5 +326,302 @@ void canvas_save_pgm(canvas_t *canvas, const char *filename) {
         }
         fprintf(f, "\n");
     }
+    STATS_ADD(canvas->stats, bytes_written, (uint64_t)ftell(f));
+    fclose(f);
+    STATS_END(canvas->stats, STAGE_SAVE, start);
+}
+
+// Skip whitespace and '#' comments in a PNM header
+static void skip_pnm_space(FILE *f) {
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        if (c == '#') {
+            while ((c = fgetc(f)) != EOF && c != '\n') {}
+        } else if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            ungetc(c, f);
+            return;
+        }
+    }
+}
+
+// Load a P2 or P5 PGM into a new canvas
+canvas_t *canvas_load_pgm(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) return NULL;
+
+    char magic[3] = {0};
+    int width = 0, height = 0, maxval = 0;
+    bool ok = fread(magic, 1, 2, f) == 2 && magic[0] == 'P' && (magic[1] == '2' || magic[1] == '5');
+    if (ok) {
+        skip_pnm_space(f);
+        ok = fscanf(f, "%d", &width) == 1;
+        skip_pnm_space(f);
+        ok = ok && fscanf(f, "%d", &height) == 1;
+        skip_pnm_space(f);
+        ok = ok && fscanf(f, "%d", &maxval) == 1;
+        ok = ok && width > 0 && height > 0 && maxval > 0 && maxval <= 255;
+    }
+    canvas_t *canvas = ok ? canvas_create(width, height) : NULL;
+    if (!canvas) {
+        fclose(f);
+        return NULL;
+    }
+
+    if (magic[1] == '5') fgetc(f); // Single whitespace before the raster
+    for (int y = 0; y < height && ok; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int v;
+            if (magic[1] == '5') {
+                v = fgetc(f);
+                ok = v != EOF;
+            } else {
+                ok = fscanf(f, "%d", &v) == 1;
+            }
+            if (!ok) break;
+            unsigned char g = (unsigned char)(v * 255 / maxval);
+            canvas->pixels[y][x] = (color_t){g, g, g};
+        }
+    }
+    fclose(f);
+    if (!ok) {
+        canvas_destroy(canvas);
+        return NULL;
+    }
+    return canvas;
+}
+
+// Compare two canvases in the grayscale used by canvas_save_pgm
+bool canvas_compare(const canvas_t *a, const canvas_t *b, canvas_diff_t *diff) {
+    if (a == NULL || b == NULL || diff == NULL || a->width != b->width || a->height != b->height) return false;
+
+    int max_error = 0;
+    long num_different = 0;
+    double sum_sq = 0.0;
+    for (int y = 0; y < a->height; ++y) {
+        for (int x = 0; x < a->width; ++x) {
+            color_t p = a->pixels[y][x], q = b->pixels[y][x];
+            int ga = (int)((p.r + p.g + p.b) / 3.0f);
+            int gb = (int)((q.r + q.g + q.b) / 3.0f);
+            int d = ga > gb ? ga - gb : gb - ga;
+            if (d == 0) continue;
+            if (d > max_error) max_error = d;
+            num_different++;
+            sum_sq += (double)d * d;
+        }
+    }
+
+    diff->max_error = max_error;
+    diff->num_different = num_different;
+    diff->mse = sum_sq / ((double)a->width * a->height);
+    diff->psnr = diff->mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / diff->mse) : INFINITY;
+    return true;
+}
+
+// =======================
+// QOI Images
+// =======================
+
+#define QOI_OP_INDEX 0x00 // 00xxxxxx
+#define QOI_OP_DIFF  0x40 // 01xxxxxx
+#define QOI_OP_LUMA  0x80 // 10xxxxxx
+#define QOI_OP_RUN   0xc0 // 11xxxxxx
+#define QOI_OP_RGB   0xfe
+#define QOI_OP_RGBA  0xff
+#define QOI_HEADER_SIZE 14
+#define QOI_PADDING_SIZE 8
+
+// Position in the table of recently seen colors (alpha is always 255 here)
+static inline int qoi_hash(color_t c) {
+    return (c.r * 3 + c.g * 5 + c.b * 7 + 255 * 11) % 64;
+}
+
+static inline bool color_equal(color_t a, color_t b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+// Opaque color as stored in the encoder's table; the zeroed table starts with transparent black, as in the format
+static inline uint32_t qoi_opaque(color_t c) {
+    return (uint32_t)c.r | (uint32_t)c.g << 8 | (uint32_t)c.b << 16 | 0xff000000u;
+}
+
+static void put_u32_be(unsigned char *p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static uint32_t get_u32_be(const unsigned char *p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+// Encode the canvas as a 3-channel QOI image in one pass
+unsigned char *canvas_encode_qoi(const canvas_t *canvas, size_t *size) {
+    if (canvas == NULL || size == NULL) return NULL;
+    size_t count = (size_t)canvas->width * canvas->height;
+    unsigned char *out = malloc(QOI_HEADER_SIZE + count * 4 + QOI_PADDING_SIZE); // Worst case: QOI_OP_RGB per pixel
+    if (!out) return NULL;
+
+    memcpy(out, "qoif", 4);
+    put_u32_be(out + 4, (uint32_t)canvas->width);
+    put_u32_be(out + 8, (uint32_t)canvas->height);
+    out[12] = 3; // RGB
+    out[13] = 0; // sRGB with linear alpha
+    unsigned char *p = out + QOI_HEADER_SIZE;
+
+    uint32_t index[64];
+    memset(index, 0, sizeof(index));
+    color_t prev = {0, 0, 0};
+    int run = 0;
+    for (int y = 0; y < canvas->height; ++y) {
+        const color_t *row = canvas->pixels[y];
+        for (int x = 0; x < canvas->width; ++x) {
+            color_t c = row[x];
+            if (color_equal(c, prev)) {
+                if (++run == 62) {
+                    *p++ = QOI_OP_RUN | (run - 1);
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                *p++ = QOI_OP_RUN | (run - 1);
+                run = 0;
+            }
+            int h = qoi_hash(c);
+            uint32_t packed = qoi_opaque(c);
+            if (index[h] == packed) {
+                *p++ = QOI_OP_INDEX | h;
+            } else {
+                index[h] = packed;
+                signed char dr = (signed char)(c.r - prev.r);
+                signed char dg = (signed char)(c.g - prev.g);
+                signed char db = (signed char)(c.b - prev.b);
+                signed char dr_dg = (signed char)(dr - dg);
+                signed char db_dg = (signed char)(db - dg);
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    *p++ = QOI_OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2);
+                } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+                    *p++ = QOI_OP_LUMA | (dg + 32);
+                    *p++ = (dr_dg + 8) << 4 | (db_dg + 8);
+                } else {
+                    *p++ = QOI_OP_RGB;
+                    *p++ = c.r;
+                    *p++ = c.g;
+                    *p++ = c.b;
+                }
+            }
+            prev = c;
+        }
+    }
+    if (run > 0) *p++ = QOI_OP_RUN | (run - 1);
+    memcpy(p, "\0\0\0\0\0\0\0\1", QOI_PADDING_SIZE);
+    p += QOI_PADDING_SIZE;
+
+    *size = (size_t)(p - out);
+    return out;
+}
+
+// Decode a QOI image (3 or 4 channels; alpha is dropped) into a new canvas
+canvas_t *canvas_decode_qoi(const unsigned char *data, size_t size) {
+    if (data == NULL || size < QOI_HEADER_SIZE + QOI_PADDING_SIZE || memcmp(data, "qoif", 4) != 0) return NULL;
+    uint32_t width = get_u32_be(data + 4), height = get_u32_be(data + 8);
+    if (width == 0 || height == 0 || width > 65535 || height > 65535 || (data[12] != 3 && data[12] != 4)) return NULL;
+    canvas_t *canvas = canvas_create((int)width, (int)height);
+    if (!canvas) return NULL;
+
+    const unsigned char *p = data + QOI_HEADER_SIZE;
+    const unsigned char *end = data + size - QOI_PADDING_SIZE;
+    color_t index[64];
+    memset(index, 0, sizeof(index));
+    unsigned char alpha_index[64];
+    memset(alpha_index, 0, sizeof(alpha_index));
+    color_t c = {0, 0, 0};
+    unsigned char a = 255;
+    int run = 0;
+    bool ok = true;
+    for (uint32_t y = 0; y < height && ok; ++y) {
+        color_t *row = canvas->pixels[y];
+        for (uint32_t x = 0; x < width; ++x) {
+            if (run > 0) {
+                run--;
+            } else if (p < end) {
+                int op = *p++;
+                if (op == QOI_OP_RGB || op == QOI_OP_RGBA) {
+                    if (end - p < (op == QOI_OP_RGB ? 3 : 4)) {
+                        ok = false;
+                        break;
+                    }
+                    c = (color_t){p[0], p[1], p[2]};
+                    if (op == QOI_OP_RGBA) a = p[3];
+                    p += op == QOI_OP_RGB ? 3 : 4;
+                } else if ((op & 0xc0) == QOI_OP_INDEX) {
+                    c = index[op];
+                    a = alpha_index[op];
+                } else if ((op & 0xc0) == QOI_OP_DIFF) {
+                    c.r += ((op >> 4) & 3) - 2;
+                    c.g += ((op >> 2) & 3) - 2;
+                    c.b += (op & 3) - 2;
+                } else if ((op & 0xc0) == QOI_OP_LUMA) {
+                    if (p == end) {
+                        ok = false;
+                        break;
+                    }
+                    int dg = (op & 0x3f) - 32, b2 = *p++;
+                    c.r += dg - 8 + ((b2 >> 4) & 0x0f);
+                    c.g += dg;
+                    c.b += dg - 8 + (b2 & 0x0f);
+                } else {
+                    run = op & 0x3f;
+                }
+                // The index keeps RGBA colors; hash with the real alpha
+                int h = (c.r * 3 + c.g * 5 + c.b * 7 + a * 11) % 64;
+                index[h] = c;
+                alpha_index[h] = a;
+            } else {
+                ok = false;
+                break;
+            }
+            row[x] = c;
+        }
+    }
+    if (!ok) {
+        canvas_destroy(canvas);
+        return NULL;
+    }
+    return canvas;
+}
+
+bool canvas_save_qoi(canvas_t *canvas, const char *filename) {
+    if (canvas == NULL || filename == NULL) return false;
+    STATS_BEGIN(canvas->stats, start);
+    size_t size;
+    unsigned char *data = canvas_encode_qoi(canvas, &size);
+    if (!data) return false;
+    FILE *f = fopen(filename, "wb");
+    if (!f) {
+        fprintf(stderr, "Error: Could not open file %s for writing.\n", filename);
+        free(data);
+        return false;
+    }
+    bool ok = fwrite(data, 1, size, f) == size;
+    ok = fclose(f) == 0 && ok;
+    free(data);
+    STATS_ADD(canvas->stats, bytes_written, (uint64_t)size);
+    STATS_END(canvas->stats, STAGE_SAVE, start);
+    return ok;
+}
+
+canvas_t *canvas_load_qoi(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char *data = size > 0 ? malloc(size) : NULL;
+    bool ok = data && fread(data, 1, size, f) == (size_t)size;
     fclose(f);
-}
\ No newline at end of file
+    canvas_t *canvas = ok ? canvas_decode_qoi(data, (size_t)size) : NULL;
+    free(data);
+    return canvas;
+}
@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "tiny3d.h"
+#include "display_list.h"
+
+// Commands allocated when the list first grows
+#define DISPLAY_LIST_INITIAL_CAPACITY 16
+
+// Drop the cached projection of one command
+static void invalidate_cmd(draw_cmd_t *cmd) {
+    free(cmd->cached_lines);
+    cmd->cached_lines = NULL;
+    cmd->cached_count = 0;
+    cmd->cache_valid = false;
+}
+
+// Drop every cached projection (camera, lights, settings or canvas size changed)
+static void invalidate_all(display_list_t *list) {
+    for (int i = 0; i < list->count; ++i) {
+        invalidate_cmd(&list->cmds[i]);
+    }
+}
+
+// Look up a command by handle
+static draw_cmd_t *get_cmd(display_list_t *list, draw_handle_t handle) {
+    if (list == NULL || handle < 0 || handle >= list->count) return NULL;
+    return &list->cmds[handle];
+}
+
+// Append a command and return its handle
+static draw_handle_t push_cmd(display_list_t *list, const draw_cmd_t *cmd) {
+    if (list == NULL) return -1;
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? 2 * list->capacity : DISPLAY_LIST_INITIAL_CAPACITY;
+        draw_cmd_t *cmds = realloc(list->cmds, capacity * sizeof(draw_cmd_t));
+        if (!cmds) return -1;
+        list->cmds = cmds;
+        int *order = realloc(list->order, capacity * sizeof(int));
+        if (!order) return -1;
+        list->order = order;
+        list->capacity = capacity;
+    }
+    list->cmds[list->count] = *cmd;
+    list->order_dirty = true;
+    return list->count++;
+}
+
+// Command with the defaults shared by every kind
+static draw_cmd_t new_cmd(draw_kind_t kind, mat4 model_matrix) {
+    draw_cmd_t cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.kind = kind;
+    cmd.visible = true;
+    cmd.model = model_matrix;
+    cmd.color = (color_t){255, 255, 255};
+    return cmd;
+}
+
+// Create an empty display list
+display_list_t *display_list_create(void) {
+    display_list_t *list = calloc(1, sizeof(display_list_t));
+    if (!list) return NULL;
+    render_context_init(&list->ctx);
+    list->cached_ctx = list->ctx;
+    list->view = mat4_identity();
+    list->projection = mat4_identity();
+    return list;
+}
+
+// Free the list and its caches
+void display_list_destroy(display_list_t *list) {
+    if (!list) return;
+    display_list_clear(list);
+    free(list->cmds);
+    free(list->order);
+    free(list->lights);
+    free(list);
+}
+
+// Remove every command
+void display_list_clear(display_list_t *list) {
+    if (!list) return;
+    invalidate_all(list);
+    list->count = 0;
+    list->order_dirty = true;
+}
+
+// Record a wireframe draw
+draw_handle_t display_list_add_wireframe(display_list_t *list, object3d_t *object, mat4 model_matrix, float line_thickness) {
+    if (object == NULL) return -1;
+    draw_cmd_t cmd = new_cmd(DRAW_WIREFRAME, model_matrix);
+    cmd.object = object;
+    cmd.thickness = line_thickness;
+    return push_cmd(list, &cmd);
+}
+
+// Record a filled-triangle draw
+draw_handle_t display_list_add_solid(display_list_t *list, object3d_t *object, mat4 model_matrix) {
+    if (object == NULL) return -1;
+    draw_cmd_t cmd = new_cmd(DRAW_SOLID, model_matrix);
+    cmd.object = object;
+    return push_cmd(list, &cmd);
+}
+
+// Record a point-cloud draw
+draw_handle_t display_list_add_points(display_list_t *list, const point_cloud_t *cloud, mat4 model_matrix, float point_size, color_t color) {
+    if (cloud == NULL) return -1;
+    draw_cmd_t cmd = new_cmd(DRAW_POINTS, model_matrix);
+    cmd.cloud = cloud;
+    cmd.thickness = point_size;
+    cmd.color = color;
+    return push_cmd(list, &cmd);
+}
+
+// Record a screen-space line
+draw_handle_t display_list_add_line(display_list_t *list, float x0, float y0, float x1, float y1, float thickness, color_t color) {
+    draw_cmd_t cmd = new_cmd(DRAW_LINE_2D, mat4_identity());
+    cmd.line[0] = x0;
+    cmd.line[1] = y0;
+    cmd.line[2] = x1;
+    cmd.line[3] = y1;
+    cmd.thickness = thickness;
+    cmd.color = color;
+    return push_cmd(list, &cmd);
+}
+
+// Set the shared camera
+void display_list_set_camera(display_list_t *list, mat4 view_matrix, mat4 projection_matrix) {
+    if (!list) return;
+    if (memcmp(&list->view, &view_matrix, sizeof(mat4)) == 0 &&
+        memcmp(&list->projection, &projection_matrix, sizeof(mat4)) == 0) {
+        return;
+    }
+    list->view = view_matrix;
+    list->projection = projection_matrix;
+    invalidate_all(list);
+}
+
+// Set the shared lights (copied)
+void display_list_set_lights(display_list_t *list, const vec3 *light_dirs, int num_lights) {
+    if (!list) return;
+    if (num_lights < 0 || (num_lights > 0 && light_dirs == NULL)) num_lights = 0;
+    if (num_lights == list->num_lights) {
+        bool same = true;
+        for (int i = 0; i < num_lights && same; ++i) {
+            same = list->lights[i].x == light_dirs[i].x && list->lights[i].y == light_dirs[i].y &&
+                   list->lights[i].z == light_dirs[i].z;
+        }
+        if (same) return;
+    }
+
+    vec3 *lights = NULL;
+    if (num_lights > 0) {
+        lights = malloc(num_lights * sizeof(vec3));
+        if (!lights) return;
+        memcpy(lights, light_dirs, num_lights * sizeof(vec3));
+    }
+    free(list->lights);
+    list->lights = lights;
+    list->num_lights = num_lights;
+    invalidate_all(list);
+}
+
+// Patch a command's model matrix
+void display_list_set_transform(display_list_t *list, draw_handle_t handle, mat4 model_matrix) {
+    draw_cmd_t *cmd = get_cmd(list, handle);
+    if (!cmd || memcmp(&cmd->model, &model_matrix, sizeof(mat4)) == 0) return;
+    cmd->model = model_matrix;
+    invalidate_cmd(cmd);
+}
+
+// Patch a command's color (points and 2D lines; wireframe colors come from lighting)
+void display_list_set_color(display_list_t *list, draw_handle_t handle, color_t color) {
+    draw_cmd_t *cmd = get_cmd(list, handle);
+    if (cmd) cmd->color = color;
+}
+
+// Show or hide a command without losing its cache
+void display_list_set_visible(display_list_t *list, draw_handle_t handle, bool visible) {
+    draw_cmd_t *cmd = get_cmd(list, handle);
+    if (cmd) cmd->visible = visible;
+}
+
+// Drop a command's cache after its mesh changed
+void display_list_invalidate(display_list_t *list, draw_handle_t handle) {
+    draw_cmd_t *cmd = get_cmd(list, handle);
+    if (cmd) invalidate_cmd(cmd);
+}
+
+// Sort key of one command: kind, then mesh, then recording order
+typedef struct {
+    int kind;
+    uintptr_t mesh;
+    int index;
+} cmd_key_t;
+
+// Replay order: by kind, then by mesh so commands sharing geometry run back to back
+static int compare_cmd_keys(const void *a, const void *b) {
+    const cmd_key_t *ka = (const cmd_key_t *)a;
+    const cmd_key_t *kb = (const cmd_key_t *)b;
+    if (ka->kind != kb->kind) return ka->kind < kb->kind ? -1 : 1;
+    if (ka->mesh != kb->mesh) return ka->mesh < kb->mesh ? -1 : 1;
+    return ka->index - kb->index;
+}
+
+// Rebuild the replay order (falls back to recording order if it cannot allocate)
+static void sort_commands(display_list_t *list) {
+    cmd_key_t *keys = malloc((list->count > 0 ? list->count : 1) * sizeof(cmd_key_t));
+    for (int i = 0; i < list->count; ++i) {
+        list->order[i] = i;
+    }
+    if (keys) {
+        for (int i = 0; i < list->count; ++i) {
+            const draw_cmd_t *cmd = &list->cmds[i];
+            keys[i].kind = cmd->kind;
+            keys[i].mesh = cmd->object ? (uintptr_t)cmd->object : (uintptr_t)cmd->cloud;
+            keys[i].index = i;
+        }
+        qsort(keys, list->count, sizeof(cmd_key_t), compare_cmd_keys);
+        for (int i = 0; i < list->count; ++i) {
+            list->order[i] = keys[i].index;
+        }
+        free(keys);
+    }
+    list->order_dirty = false;
+}
+
+// Replay the list onto a canvas
+void display_list_render(display_list_t *list, canvas_t *canvas) {
+    if (list == NULL || canvas == NULL) return;
+
+    // Cached screen lines depend on the settings and the canvas size
+    if (memcmp(&list->ctx, &list->cached_ctx, sizeof(render_context_t)) != 0 ||
+        canvas->width != list->cached_width || canvas->height != list->cached_height) {
+        invalidate_all(list);
+        list->cached_ctx = list->ctx;
+        list->cached_width = canvas->width;
+        list->cached_height = canvas->height;
+    }
+
+    if (list->order_dirty) {
+        sort_commands(list);
+    }
+
+    for (int i = 0; i < list->count; ++i) {
+        draw_cmd_t *cmd = &list->cmds[list->order[i]];
+        if (!cmd->visible) continue;
+
+        switch (cmd->kind) {
+        case DRAW_SOLID:
+            render_solid(&list->ctx, canvas, cmd->object, cmd->model, list->view, list->projection, list->lights, list->num_lights);
+            break;
+
+        case DRAW_WIREFRAME:
+            if (!cmd->cache_valid) {
+                render_line_t *lines;
+                int count = render_wireframe_lines(&list->ctx, canvas, cmd->object, cmd->model, list->view, list->projection,
+                                                   list->lights, list->num_lights, &lines);
+                if (count < 0) break;
+                cmd->cached_lines = lines;
+                cmd->cached_count = count;
+                cmd->cache_valid = true;
+            }
+            render_lines(canvas, cmd->cached_lines, cmd->cached_count, cmd->thickness);
+            break;
+
+        case DRAW_POINTS:
+            render_point_cloud(&list->ctx, canvas, cmd->cloud, cmd->model, list->view, list->projection, cmd->thickness, cmd->color);
+            break;
+
+        case DRAW_LINE_2D:
+            draw_line_f(canvas, cmd->line[0], cmd->line[1], cmd->line[2], cmd->line[3], cmd->thickness, cmd->color);
+            break;
+        }
+    }
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "frame_ring.h"
+
+#define FRAME_RING_MAGIC "T3FR"
+#define FRAME_RING_VERSION 1
+#define FRAME_RING_MAX_SLOTS 1024
+#define FRAME_RING_PAGE 4096
+#define FRAME_RING_LINE 64
+
+// Start of the shared region; the producer fills in every field before the magic
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t width, height;
+    uint32_t num_slots;
+    uint32_t header_size;               // Offset of the first slot's pixels
+    uint64_t slot_size;                 // Bytes between slots' pixels
+    _Atomic uint64_t published;         // Frames published so far
+    _Atomic uint32_t finished;
+} ring_header_t;
+
+// Per-slot seqlock, one cache line each so readers of different slots do not share lines
+typedef struct {
+    _Atomic uint64_t seq;               // Odd while the producer writes the slot
+    _Atomic uint64_t frame;             // Frame number the slot holds
+    char padding[FRAME_RING_LINE - 2 * sizeof(uint64_t)];
+} ring_slot_t;
+
+struct frame_ring {
+    void *map;
+    size_t map_size;
+    ring_header_t *header;
+    ring_slot_t *slots;                 // Right after the header
+    unsigned char *data;                // Slot pixels
+    bool producer;
+    canvas_t **canvases;                // Producer: one wrapped canvas per slot, created on first use
+    int writing;                        // Producer: slot between begin_frame and publish, or -1
+};
+
+static size_t align_up(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// "/name" is a shared memory object, anything else a file
+static bool is_shm_name(const char *name) {
+    return name[0] == '/' && strchr(name + 1, '/') == NULL;
+}
+
+static int open_ring(const char *name, int flags, mode_t mode) {
+    return is_shm_name(name) ? shm_open(name, flags, mode) : open(name, flags, mode);
+}
+
+bool frame_ring_unlink(const char *name) {
+    if (name == NULL) return false;
+    return (is_shm_name(name) ? shm_unlink(name) : unlink(name)) == 0;
+}
+
+// =======================
+// Producer
+// =======================
+
+frame_ring_t *frame_ring_create(const char *name, int width, int height, int num_slots) {
+    if (name == NULL || width < 1 || height < 1 || width > 65535 || height > 65535 ||
+        num_slots < 2 || num_slots > FRAME_RING_MAX_SLOTS) {
+        return NULL;
+    }
+    size_t header_size = align_up(sizeof(ring_header_t), FRAME_RING_LINE) + num_slots * sizeof(ring_slot_t);
+    header_size = align_up(header_size, FRAME_RING_PAGE);
+    size_t slot_size = align_up((size_t)width * height * sizeof(color_t), FRAME_RING_LINE);
+    size_t map_size = header_size + num_slots * slot_size;
+
+    // Readers of an old ring keep their mapping; new readers get the new one
+    frame_ring_unlink(name);
+    int fd = open_ring(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        perror(name);
+        return NULL;
+    }
+    void *map = ftruncate(fd, (off_t)map_size) == 0 ? mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                                                    : MAP_FAILED;
+    close(fd);
+    frame_ring_t *ring = map != MAP_FAILED ? calloc(1, sizeof(frame_ring_t)) : NULL;
+    if (ring) ring->canvases = calloc(num_slots, sizeof(canvas_t *));
+    if (!ring || !ring->canvases) {
+        if (map != MAP_FAILED) munmap(map, map_size);
+        if (ring) free(ring);
+        frame_ring_unlink(name);
+        return NULL;
+    }
+
+    ring->map = map;
+    ring->map_size = map_size;
+    ring->header = map;
+    ring->slots = (ring_slot_t *)((char *)map + align_up(sizeof(ring_header_t), FRAME_RING_LINE));
+    ring->data = (unsigned char *)map + header_size;
+    ring->producer = true;
+    ring->writing = -1;
+
+    // The new file is zero-filled: no frames published, every slot sequence even
+    ring_header_t *h = ring->header;
+    h->version = FRAME_RING_VERSION;
+    h->width = (uint32_t)width;
+    h->height = (uint32_t)height;
+    h->num_slots = (uint32_t)num_slots;
+    h->header_size = (uint32_t)header_size;
+    h->slot_size = slot_size;
+    atomic_thread_fence(memory_order_release);
+    memcpy(h->magic, FRAME_RING_MAGIC, 4);
+    return ring;
+}
+
+canvas_t *frame_ring_begin_frame(frame_ring_t *ring) {
+    if (ring == NULL || !ring->producer) return NULL;
+    ring_header_t *h = ring->header;
+    int slot = (int)(atomic_load_explicit(&h->published, memory_order_relaxed) % h->num_slots);
+    if (ring->writing != slot) {
+        // Odd sequence: readers of the frame this slot held now fail their checks
+        ring_slot_t *s = &ring->slots[slot];
+        atomic_store_explicit(&s->seq, atomic_load_explicit(&s->seq, memory_order_relaxed) + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        ring->writing = slot;
+    }
+    if (!ring->canvases[slot]) {
+        color_t *pixels = (color_t *)(ring->data + slot * h->slot_size);
+        ring->canvases[slot] = canvas_wrap((int)h->width, (int)h->height, pixels, (int)h->width);
+    }
+    return ring->canvases[slot];
+}
+
+uint64_t frame_ring_publish(frame_ring_t *ring) {
+    if (ring == NULL || !ring->producer || ring->writing < 0) return UINT64_MAX;
+    ring_header_t *h = ring->header;
+    ring_slot_t *s = &ring->slots[ring->writing];
+    uint64_t frame = atomic_load_explicit(&h->published, memory_order_relaxed);
+    atomic_store_explicit(&s->frame, frame, memory_order_relaxed);
+    atomic_store_explicit(&s->seq, atomic_load_explicit(&s->seq, memory_order_relaxed) + 1, memory_order_release);
+    atomic_store_explicit(&h->published, frame + 1, memory_order_release);
+    ring->writing = -1;
+    return frame;
+}
+
+void frame_ring_finish(frame_ring_t *ring) {
+    if (ring == NULL || !ring->producer) return;
+    atomic_store_explicit(&ring->header->finished, 1, memory_order_release);
+}
+
+// =======================
+// Consumer
+// =======================
+
+frame_ring_t *frame_ring_open(const char *name) {
+    if (name == NULL) return NULL;
+    int fd = open_ring(name, O_RDONLY, 0);
+    if (fd < 0) return NULL;
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= FRAME_RING_PAGE) {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    size_t map_size = (size_t)st.st_size;
+    ring_header_t *h = map;
+    bool valid = memcmp(h->magic, FRAME_RING_MAGIC, 4) == 0;
+    atomic_thread_fence(memory_order_acquire);
+    valid = valid && h->version == FRAME_RING_VERSION && h->width >= 1 && h->height >= 1 &&
+            h->num_slots >= 2 && h->num_slots <= FRAME_RING_MAX_SLOTS &&
+            h->slot_size >= (uint64_t)h->width * h->height * sizeof(color_t) &&
+            h->header_size >= align_up(sizeof(ring_header_t), FRAME_RING_LINE) + h->num_slots * sizeof(ring_slot_t) &&
+            h->header_size + h->num_slots * h->slot_size <= map_size;
+    frame_ring_t *ring = valid ? calloc(1, sizeof(frame_ring_t)) : NULL;
+    if (!ring) {
+        munmap(map, map_size);
+        return NULL;
+    }
+    ring->map = map;
+    ring->map_size = map_size;
+    ring->header = h;
+    ring->slots = (ring_slot_t *)((char *)map + align_up(sizeof(ring_header_t), FRAME_RING_LINE));
+    ring->data = (unsigned char *)map + h->header_size;
+    ring->writing = -1;
+    return ring;
+}
+
+uint64_t frame_ring_published(const frame_ring_t *ring) {
+    return ring ? atomic_load_explicit(&ring->header->published, memory_order_acquire) : 0;
+}
+
+bool frame_ring_finished(const frame_ring_t *ring) {
+    return ring ? atomic_load_explicit(&ring->header->finished, memory_order_acquire) != 0 : true;
+}
+
+int frame_ring_width(const frame_ring_t *ring) { return ring ? (int)ring->header->width : 0; }
+int frame_ring_height(const frame_ring_t *ring) { return ring ? (int)ring->header->height : 0; }
+int frame_ring_slots(const frame_ring_t *ring) { return ring ? (int)ring->header->num_slots : 0; }
+
+bool frame_ring_read_begin(const frame_ring_t *ring, uint64_t frame, frame_view_t *view) {
+    if (ring == NULL || view == NULL) return false;
+    const ring_header_t *h = ring->header;
+    uint64_t published = atomic_load_explicit(&h->published, memory_order_acquire);
+    if (frame >= published || published - frame > h->num_slots) return false;
+
+    int slot = (int)(frame % h->num_slots);
+    ring_slot_t *s = &ring->slots[slot];
+    uint64_t seq = atomic_load_explicit(&s->seq, memory_order_acquire);
+    if ((seq & 1) || atomic_load_explicit(&s->frame, memory_order_relaxed) != frame) return false;
+
+    view->pixels = (const color_t *)(ring->data + slot * h->slot_size);
+    view->width = (int)h->width;
+    view->height = (int)h->height;
+    view->frame = frame;
+    view->seq = seq;
+    view->slot = slot;
+    return true;
+}
+
+bool frame_ring_read_end(const frame_ring_t *ring, const frame_view_t *view) {
+    if (ring == NULL || view == NULL) return false;
+    // Pixel reads may not move past the second sequence check
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&ring->slots[view->slot].seq, memory_order_relaxed) == view->seq;
+}
+
+void frame_ring_destroy(frame_ring_t *ring) {
+    if (ring == NULL) return;
+    if (ring->producer) {
+        frame_ring_finish(ring);
+        for (int i = 0; i < (int)ring->header->num_slots; ++i) canvas_destroy(ring->canvases[i]);
+        free(ring->canvases);
+    }
+    munmap(ring->map, ring->map_size);
+    free(ring);
+}
\ No newline at end of file
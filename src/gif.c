@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gif.h"
+
+#define GIF_MAX_CODES 4096        // 12-bit LZW codes
+#define GIF_HASH_BITS 13          // Twice the code count keeps probe chains short
+#define GIF_HASH_SIZE (1 << GIF_HASH_BITS)
+
+struct gif_writer {
+    FILE *file;
+    int width, height;
+    int delay_cs;
+    int palette_bits;
+    int transparent;              // Palette index of the transparent entry
+    int num_frames;
+    bool ok;
+    unsigned char gray_to_index[256];
+    unsigned char *previous;      // Palette indices of the image shown after the last frame
+    unsigned char *current;       // Palette indices of the frame being added
+    unsigned char *pixels;        // Indices written for the frame's rectangle
+
+    // LZW string table: key (prefix << 8 | index) -> code, open addressing
+    int32_t keys[GIF_HASH_SIZE];
+    uint16_t codes[GIF_HASH_SIZE];
+
+    // Bit packing into 255-byte data sub-blocks
+    uint32_t bit_buffer;
+    int bit_count;
+    unsigned char block[255];
+    int block_size;
+};
+
+static void put_byte(gif_writer_t *gif, int b) {
+    if (fputc(b, gif->file) == EOF) gif->ok = false;
+}
+
+static void put_u16(gif_writer_t *gif, int v) {
+    put_byte(gif, v & 0xFF);
+    put_byte(gif, (v >> 8) & 0xFF);
+}
+
+static void put_bytes(gif_writer_t *gif, const void *data, size_t size) {
+    if (fwrite(data, 1, size, gif->file) != size) gif->ok = false;
+}
+
+// =======================
+// LZW
+// =======================
+
+static void flush_block(gif_writer_t *gif) {
+    if (gif->block_size == 0) return;
+    put_byte(gif, gif->block_size);
+    put_bytes(gif, gif->block, gif->block_size);
+    gif->block_size = 0;
+}
+
+// Codes are packed least significant bit first
+static void put_code(gif_writer_t *gif, int code, int code_size) {
+    gif->bit_buffer |= (uint32_t)code << gif->bit_count;
+    gif->bit_count += code_size;
+    while (gif->bit_count >= 8) {
+        gif->block[gif->block_size++] = gif->bit_buffer & 0xFF;
+        if (gif->block_size == 255) flush_block(gif);
+        gif->bit_buffer >>= 8;
+        gif->bit_count -= 8;
+    }
+}
+
+static void reset_table(gif_writer_t *gif) {
+    memset(gif->keys, 0xFF, sizeof(gif->keys));
+}
+
+static uint32_t hash_key(uint32_t key) {
+    return (key * 2654435761u) >> (32 - GIF_HASH_BITS);
+}
+
+// Compress count palette indices as one image's data sub-blocks
+static void lzw_encode(gif_writer_t *gif, const unsigned char *pixels, int count) {
+    int min_code_size = gif->palette_bits < 2 ? 2 : gif->palette_bits;
+    int clear_code = 1 << min_code_size;
+    int code_size = min_code_size + 1;
+    int next_code = clear_code + 2;
+
+    put_byte(gif, min_code_size);
+    gif->bit_buffer = 0;
+    gif->bit_count = 0;
+    gif->block_size = 0;
+    reset_table(gif);
+    put_code(gif, clear_code, code_size);
+
+    int prefix = pixels[0];
+    for (int i = 1; i < count; ++i) {
+        int32_t key = (prefix << 8) | pixels[i];
+        uint32_t h = hash_key((uint32_t)key);
+        while (gif->keys[h] != -1 && gif->keys[h] != key) h = (h + 1) & (GIF_HASH_SIZE - 1);
+        if (gif->keys[h] == key) {
+            prefix = gif->codes[h];
+            continue;
+        }
+
+        put_code(gif, prefix, code_size);
+        if (next_code < GIF_MAX_CODES) {
+            gif->keys[h] = key;
+            gif->codes[h] = (uint16_t)next_code++;
+            // The decoder adds its entry one code later, so widen once the next code no longer fits
+            if (next_code > (1 << code_size)) code_size++;
+        } else {
+            // Table full: start over
+            put_code(gif, clear_code, code_size);
+            reset_table(gif);
+            code_size = min_code_size + 1;
+            next_code = clear_code + 2;
+        }
+        prefix = pixels[i];
+    }
+    put_code(gif, prefix, code_size);
+    put_code(gif, clear_code + 1, code_size); // End of information
+    if (gif->bit_count > 0) put_code(gif, 0, 8 - gif->bit_count);
+    flush_block(gif);
+    put_byte(gif, 0);
+}
+
+// =======================
+// Writer
+// =======================
+
+gif_writer_t *gif_writer_create(const char *filename, int width, int height, int delay_cs, int loop_count, int palette_bits) {
+    if (filename == NULL || width < 1 || height < 1 || width > 65535 || height > 65535 ||
+        palette_bits < 2 || palette_bits > 8) {
+        return NULL;
+    }
+    gif_writer_t *gif = calloc(1, sizeof(gif_writer_t));
+    if (!gif) return NULL;
+    size_t size = (size_t)width * height;
+    gif->previous = malloc(size);
+    gif->current = malloc(size);
+    gif->pixels = malloc(size);
+    gif->file = fopen(filename, "wb");
+    if (!gif->previous || !gif->current || !gif->pixels || !gif->file) {
+        if (!gif->file) fprintf(stderr, "Error: Could not open file %s for writing.\n", filename);
+        if (gif->file) fclose(gif->file);
+        free(gif->previous);
+        free(gif->current);
+        free(gif->pixels);
+        free(gif);
+        return NULL;
+    }
+    gif->width = width;
+    gif->height = height;
+    gif->delay_cs = delay_cs < 0 ? 0 : delay_cs > 65535 ? 65535 : delay_cs;
+    gif->palette_bits = palette_bits;
+    gif->ok = true;
+
+    // Evenly spaced gray levels from 0 to 255, then the transparent entry
+    int levels = (1 << palette_bits) - 1;
+    gif->transparent = levels;
+    for (int g = 0; g < 256; ++g) gif->gray_to_index[g] = (unsigned char)((g * (levels - 1) + 127) / 255);
+
+    put_bytes(gif, "GIF89a", 6);
+    put_u16(gif, width);
+    put_u16(gif, height);
+    put_byte(gif, 0x80 | ((palette_bits - 1) << 4) | (palette_bits - 1)); // Global color table of 2^bits entries
+    put_byte(gif, 0);                                                     // Background index
+    put_byte(gif, 0);                                                     // No aspect ratio
+    for (int i = 0; i <= levels; ++i) {
+        int gray = i < levels ? (i * 255 + (levels - 1) / 2) / (levels - 1) : 0;
+        unsigned char rgb[3] = {gray, gray, gray};
+        put_bytes(gif, rgb, 3);
+    }
+    if (loop_count >= 0) {
+        put_bytes(gif, "\x21\xFF\x0BNETSCAPE2.0\x03\x01", 16);
+        put_u16(gif, loop_count);
+        put_byte(gif, 0);
+    }
+    return gif;
+}
+
+bool gif_writer_add_frame(gif_writer_t *gif, const canvas_t *canvas) {
+    if (gif == NULL || canvas == NULL || canvas->width != gif->width || canvas->height != gif->height) return false;
+    STATS_BEGIN(canvas->stats, start);
+#if TINY3D_STATS
+    long start_offset = ftell(gif->file);
+#endif
+
+    // Palette indices in the gray of canvas_save_pgm, and the rectangle that changed
+    int x0 = gif->width, y0 = gif->height, x1 = -1, y1 = -1;
+    for (int y = 0; y < gif->height; ++y) {
+        unsigned char *row = gif->current + (size_t)y * gif->width;
+        const unsigned char *prev = gif->previous + (size_t)y * gif->width;
+        for (int x = 0; x < gif->width; ++x) {
+            color_t p = canvas->pixels[y][x];
+            row[x] = gif->gray_to_index[(int)((p.r + p.g + p.b) / 3.0f)];
+        }
+        if (gif->num_frames > 0 && memcmp(row, prev, gif->width) == 0) continue;
+        int first = 0, last = gif->width - 1;
+        if (gif->num_frames > 0) {
+            while (row[first] == prev[first]) first++;
+            while (row[last] == prev[last]) last--;
+        }
+        if (first < x0) x0 = first;
+        if (last > x1) x1 = last;
+        if (y0 > y) y0 = y;
+        y1 = y;
+    }
+
+    // Unchanged pixels inside the rectangle are transparent; a frame with no change keeps its delay with one pixel
+    int count;
+    if (x1 < 0) {
+        x0 = y0 = x1 = y1 = 0;
+        gif->pixels[0] = (unsigned char)gif->transparent;
+        count = 1;
+    } else {
+        count = 0;
+        for (int y = y0; y <= y1; ++y) {
+            const unsigned char *row = gif->current + (size_t)y * gif->width;
+            const unsigned char *prev = gif->previous + (size_t)y * gif->width;
+            for (int x = x0; x <= x1; ++x)
+                gif->pixels[count++] = gif->num_frames > 0 && row[x] == prev[x] ? (unsigned char)gif->transparent : row[x];
+        }
+    }
+
+    // Graphic control extension: keep the previous image under this one (disposal 1), transparency on
+    put_bytes(gif, "\x21\xF9\x04", 3);
+    put_byte(gif, (1 << 2) | 1);
+    put_u16(gif, gif->delay_cs);
+    put_byte(gif, gif->transparent);
+    put_byte(gif, 0);
+
+    // Image descriptor without a local color table
+    put_byte(gif, 0x2C);
+    put_u16(gif, x0);
+    put_u16(gif, y0);
+    put_u16(gif, x1 - x0 + 1);
+    put_u16(gif, y1 - y0 + 1);
+    put_byte(gif, 0);
+    lzw_encode(gif, gif->pixels, count);
+
+    unsigned char *shown = gif->previous;
+    gif->previous = gif->current;
+    gif->current = shown;
+    gif->num_frames++;
+
+    STATS_ADD(canvas->stats, bytes_written, (uint64_t)(ftell(gif->file) - start_offset));
+    STATS_END(canvas->stats, STAGE_SAVE, start);
+    return gif->ok;
+}
+
+bool gif_writer_close(gif_writer_t *gif) {
+    if (gif == NULL) return false;
+    put_byte(gif, 0x3B); // Trailer
+    bool ok = gif->ok;
+    if (fclose(gif->file) != 0) ok = false;
+    free(gif->previous);
+    free(gif->current);
+    free(gif->pixels);
+    free(gif);
+    return ok;
+}
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include <stdlib.h>
+#include <string.h>
+#include "layers.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+typedef struct {
+    canvas_t *canvas;
+    layer_kind_t kind;
+    layer_blend_t blend;
+    bool valid;                   // Static: the cached image is current
+    bool changed;                 // Redrawn since the last compose
+    canvas_rect_t bounds;         // Non-black pixels as of the last layer_end
+    canvas_rect_t composed;       // bounds when the layer was last composed
+} layer_t;
+
+struct layer_stack {
+    int width, height;
+    layer_t layers[LAYER_STACK_MAX_LAYERS];
+    int num_layers;
+    const canvas_t *last_output;  // Canvas of the last compose, NULL to compose everything next time
+};
+
+static const canvas_rect_t EMPTY_RECT = {0, 0, 0, 0};
+
+static bool rect_empty(canvas_rect_t r) {
+    return r.x0 >= r.x1 || r.y0 >= r.y1;
+}
+
+static canvas_rect_t rect_union(canvas_rect_t a, canvas_rect_t b) {
+    if (rect_empty(a)) return b;
+    if (rect_empty(b)) return a;
+    canvas_rect_t r = {a.x0 < b.x0 ? a.x0 : b.x0, a.y0 < b.y0 ? a.y0 : b.y0,
+                       a.x1 > b.x1 ? a.x1 : b.x1, a.y1 > b.y1 ? a.y1 : b.y1};
+    return r;
+}
+
+static bool rect_overlap(canvas_rect_t a, canvas_rect_t b) {
+    return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+}
+
+static bool valid_layer(const layer_stack_t *stack, int layer) {
+    return stack != NULL && layer >= 0 && layer < stack->num_layers;
+}
+
+// =======================
+// Stack
+// =======================
+
+layer_stack_t *layer_stack_create(int width, int height) {
+    if (width < 1 || height < 1) return NULL;
+    layer_stack_t *stack = calloc(1, sizeof(layer_stack_t));
+    if (!stack) return NULL;
+    stack->width = width;
+    stack->height = height;
+    return stack;
+}
+
+void layer_stack_destroy(layer_stack_t *stack) {
+    if (stack == NULL) return;
+    for (int i = 0; i < stack->num_layers; ++i) canvas_destroy(stack->layers[i].canvas);
+    free(stack);
+}
+
+int layer_stack_add(layer_stack_t *stack, layer_kind_t kind, layer_blend_t blend) {
+    if (stack == NULL || stack->num_layers >= LAYER_STACK_MAX_LAYERS) return -1;
+    canvas_t *canvas = canvas_create(stack->width, stack->height);
+    if (!canvas) return -1;
+    layer_t *l = &stack->layers[stack->num_layers];
+    l->canvas = canvas;
+    l->kind = kind;
+    l->blend = blend;
+    l->valid = false;
+    l->changed = false;
+    l->bounds = EMPTY_RECT;
+    l->composed = EMPTY_RECT;
+    return stack->num_layers++;
+}
+
+void layer_stack_invalidate_output(layer_stack_t *stack) {
+    if (stack) stack->last_output = NULL;
+}
+
+// =======================
+// Drawing
+// =======================
+
+canvas_t *layer_begin(layer_stack_t *stack, int layer) {
+    if (!valid_layer(stack, layer)) return NULL;
+    layer_t *l = &stack->layers[layer];
+    if (l->kind == LAYER_STATIC && l->valid) return NULL;
+
+    // Outside its bounds the layer is already black; a depth buffer may hold values anywhere
+    canvas_t *c = l->canvas;
+    if (c->depth) {
+        canvas_clear(c);
+    } else if (!rect_empty(l->bounds)) {
+        STATS_BEGIN(c->stats, start);
+        for (int y = l->bounds.y0; y < l->bounds.y1; ++y) {
+            memset(c->pixels[y] + l->bounds.x0, 0, (l->bounds.x1 - l->bounds.x0) * sizeof(color_t));
+        }
+        STATS_END(c->stats, STAGE_CLEAR, start);
+    }
+    l->bounds = EMPTY_RECT;
+    return c;
+}
+
+// Byte offset of the first non-zero byte in p[0..n), or -1
+static int first_nonzero(const unsigned char *p, int n) {
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        int zeros = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + i)), zero));
+        if (zeros != 0xFFFF) return i + __builtin_ctz(~zeros & 0xFFFF);
+    }
+#endif
+    for (; i < n; ++i) {
+        if (p[i]) return i;
+    }
+    return -1;
+}
+
+// Byte offset of the last non-zero byte in p[0..n), or -1
+static int last_nonzero(const unsigned char *p, int n) {
+    int i = n;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i - 16 >= 0; i -= 16) {
+        int zeros = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + i - 16)), zero));
+        if (zeros != 0xFFFF) return i - 16 + 31 - __builtin_clz(~zeros & 0xFFFF);
+    }
+#endif
+    while (--i >= 0) {
+        if (p[i]) return i;
+    }
+    return -1;
+}
+
+void layer_end(layer_stack_t *stack, int layer) {
+    if (!valid_layer(stack, layer)) return;
+    layer_t *l = &stack->layers[layer];
+    canvas_t *c = l->canvas;
+    int row_bytes = c->width * (int)sizeof(color_t);
+    canvas_rect_t bounds = {c->width, c->height, 0, 0};
+    for (int y = 0; y < c->height; ++y) {
+        const unsigned char *row = (const unsigned char *)c->pixels[y];
+        int first = first_nonzero(row, row_bytes);
+        if (first < 0) continue;
+        int last = last_nonzero(row, row_bytes);
+        int x0 = first / (int)sizeof(color_t), x1 = last / (int)sizeof(color_t) + 1;
+        if (x0 < bounds.x0) bounds.x0 = x0;
+        if (x1 > bounds.x1) bounds.x1 = x1;
+        if (y < bounds.y0) bounds.y0 = y;
+        bounds.y1 = y + 1;
+    }
+    l->bounds = rect_empty(bounds) ? EMPTY_RECT : bounds;
+    l->valid = true;
+    l->changed = true;
+}
+
+void layer_invalidate(layer_stack_t *stack, int layer) {
+    if (valid_layer(stack, layer)) stack->layers[layer].valid = false;
+}
+
+canvas_rect_t layer_bounds(const layer_stack_t *stack, int layer) {
+    return valid_layer(stack, layer) ? stack->layers[layer].bounds : EMPTY_RECT;
+}
+
+// =======================
+// Compositing
+// =======================
+
+// dst = min(255, dst + src) per channel
+static void blend_add(color_t *dst, const color_t *src, int count) {
+    unsigned char *d = (unsigned char *)dst;
+    const unsigned char *s = (const unsigned char *)src;
+    int n = count * (int)sizeof(color_t);
+    int i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        __m128i sum = _mm_adds_epu8(_mm_loadu_si128((const __m128i *)(d + i)), _mm_loadu_si128((const __m128i *)(s + i)));
+        _mm_storeu_si128((__m128i *)(d + i), sum);
+    }
+#endif
+    for (; i < n; ++i) {
+        int sum = d[i] + s[i];
+        d[i] = (unsigned char)(sum > 255 ? 255 : sum);
+    }
+}
+
+#if defined(__SSE2__)
+// Shift the 48 bytes (a, b, c) toward lower addresses by k bytes (a holds the lowest); zeros shift in at the top
+#define SHIFT_DOWN48(a, b, c, k, ra, rb, rc) do { \
+        ra = _mm_or_si128(_mm_srli_si128(a, k), _mm_slli_si128(b, 16 - (k))); \
+        rb = _mm_or_si128(_mm_srli_si128(b, k), _mm_slli_si128(c, 16 - (k))); \
+        rc = _mm_srli_si128(c, k); \
+    } while (0)
+
+// Shift the 48 bytes (a, b, c) toward higher addresses by k bytes; zeros shift in at the bottom
+#define SHIFT_UP48(a, b, c, k, ra, rb, rc) do { \
+        ra = _mm_slli_si128(a, k); \
+        rb = _mm_or_si128(_mm_slli_si128(b, k), _mm_srli_si128(a, 16 - (k))); \
+        rc = _mm_or_si128(_mm_slli_si128(c, k), _mm_srli_si128(b, 16 - (k))); \
+    } while (0)
+#endif
+
+// Non-black src pixels replace dst pixels
+static void blend_over(color_t *dst, const color_t *src, int count) {
+    int i = 0;
+#if defined(__SSE2__)
+    // 16 pixels in three registers; byte 3p is the first byte of pixel p
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i first0 = _mm_setr_epi8(-1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1);
+    const __m128i first1 = _mm_setr_epi8(0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0);
+    const __m128i first2 = _mm_setr_epi8(0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0);
+    for (; i + 16 <= count; i += 16) {
+        const __m128i *s = (const __m128i *)(src + i);
+        __m128i *d = (__m128i *)(dst + i);
+        __m128i s0 = _mm_loadu_si128(s), s1 = _mm_loadu_si128(s + 1), s2 = _mm_loadu_si128(s + 2);
+        __m128i z0 = _mm_cmpeq_epi8(s0, zero), z1 = _mm_cmpeq_epi8(s1, zero), z2 = _mm_cmpeq_epi8(s2, zero);
+
+        // A pixel is transparent when its byte and the next two are zero, read at its first byte
+        __m128i a0, a1, a2, b0, b1, b2;
+        SHIFT_DOWN48(z0, z1, z2, 1, a0, a1, a2);
+        SHIFT_DOWN48(z0, z1, z2, 2, b0, b1, b2);
+        __m128i t0 = _mm_and_si128(_mm_and_si128(z0, a0), _mm_and_si128(b0, first0));
+        __m128i t1 = _mm_and_si128(_mm_and_si128(z1, a1), _mm_and_si128(b1, first1));
+        __m128i t2 = _mm_and_si128(_mm_and_si128(z2, a2), _mm_and_si128(b2, first2));
+
+        // Spread the flag over the pixel's three bytes and select
+        SHIFT_UP48(t0, t1, t2, 1, a0, a1, a2);
+        SHIFT_UP48(t0, t1, t2, 2, b0, b1, b2);
+        __m128i m0 = _mm_or_si128(t0, _mm_or_si128(a0, b0));
+        __m128i m1 = _mm_or_si128(t1, _mm_or_si128(a1, b1));
+        __m128i m2 = _mm_or_si128(t2, _mm_or_si128(a2, b2));
+        _mm_storeu_si128(d, _mm_or_si128(_mm_and_si128(m0, _mm_loadu_si128(d)), _mm_andnot_si128(m0, s0)));
+        _mm_storeu_si128(d + 1, _mm_or_si128(_mm_and_si128(m1, _mm_loadu_si128(d + 1)), _mm_andnot_si128(m1, s1)));
+        _mm_storeu_si128(d + 2, _mm_or_si128(_mm_and_si128(m2, _mm_loadu_si128(d + 2)), _mm_andnot_si128(m2, s2)));
+    }
+#endif
+    for (; i < count; ++i) {
+        if (src[i].r | src[i].g | src[i].b) dst[i] = src[i];
+    }
+}
+
+// Compose pixels [x0, x1) of row y from every layer that has content there
+static void compose_row(const layer_stack_t *stack, canvas_t *out, int y, int x0, int x1) {
+    color_t *dst = out->pixels[y];
+    bool filled = false;
+    for (int i = 0; i < stack->num_layers; ++i) {
+        const layer_t *l = &stack->layers[i];
+        if (y < l->bounds.y0 || y >= l->bounds.y1) continue;
+        int a = x0 > l->bounds.x0 ? x0 : l->bounds.x0;
+        int b = x1 < l->bounds.x1 ? x1 : l->bounds.x1;
+        if (a >= b) continue;
+        const color_t *src = l->canvas->pixels[y];
+        if (!filled) {
+            // Onto black, both blend modes are a copy
+            memset(dst + x0, 0, (a - x0) * sizeof(color_t));
+            memcpy(dst + a, src + a, (b - a) * sizeof(color_t));
+            memset(dst + b, 0, (x1 - b) * sizeof(color_t));
+            filled = true;
+        } else if (l->blend == LAYER_BLEND_ADD) {
+            blend_add(dst + a, src + a, b - a);
+        } else {
+            blend_over(dst + a, src + a, b - a);
+        }
+    }
+    if (!filled) memset(dst + x0, 0, (x1 - x0) * sizeof(color_t));
+}
+
+long layer_stack_compose(layer_stack_t *stack, canvas_t *out) {
+    if (stack == NULL || out == NULL || out->width != stack->width || out->height != stack->height) return -1;
+    STATS_BEGIN(out->stats, start);
+
+    // Regions to rewrite: each redrawn layer's old and new bounds, with overlapping regions merged
+    canvas_rect_t dirty[LAYER_STACK_MAX_LAYERS];
+    int num_dirty = 0;
+    if (out != stack->last_output) {
+        dirty[num_dirty++] = (canvas_rect_t){0, 0, stack->width, stack->height};
+    } else {
+        for (int i = 0; i < stack->num_layers; ++i) {
+            const layer_t *l = &stack->layers[i];
+            canvas_rect_t r = rect_union(l->composed, l->bounds);
+            if (l->changed && !rect_empty(r)) dirty[num_dirty++] = r;
+        }
+        for (bool merged = true; merged;) {
+            merged = false;
+            for (int i = 0; i < num_dirty && !merged; ++i) {
+                for (int j = i + 1; j < num_dirty; ++j) {
+                    if (rect_overlap(dirty[i], dirty[j])) {
+                        dirty[i] = rect_union(dirty[i], dirty[j]);
+                        dirty[j] = dirty[--num_dirty];
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    long pixels = 0;
+    for (int k = 0; k < num_dirty; ++k) {
+        canvas_rect_t r = dirty[k];
+        for (int y = r.y0; y < r.y1; ++y) compose_row(stack, out, y, r.x0, r.x1);
+        pixels += (long)(r.x1 - r.x0) * (r.y1 - r.y0);
+    }
+    for (int i = 0; i < stack->num_layers; ++i) {
+        stack->layers[i].composed = stack->layers[i].bounds;
+        stack->layers[i].changed = false;
+    }
+    stack->last_output = out;
+    STATS_END(out->stats, STAGE_COMPOSITE, start);
+    return pixels;
+}
@@ -1,6 +1,76 @@
 #include <math.h>  
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <float.h>
+#include <pthread.h>
 #include "tiny3d.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Lights packed on the stack before falling back to the heap
+#define PACKED_LIGHTS_STACK 16
+
+// exp(-x) is tabulated for x in [0, FOG_EXP_RANGE]; beyond that the factor rounds to zero at 8 bits
+#define FOG_LUT_SIZE 256
+#define FOG_EXP_RANGE 8.0f
+
+// Boost curve sampled at LIGHT_LUT_SIZE points, already scaled to 8 bits
+static unsigned char boost_lut[LIGHT_LUT_SIZE];
+static pthread_once_t boost_lut_once = PTHREAD_ONCE_INIT;
+
+static void build_boost_lut(void) {
+    for (int i = 0; i < LIGHT_LUT_SIZE; ++i) {
+        float intensity = (float)i / (LIGHT_LUT_SIZE - 1);
+        boost_lut[i] = (unsigned char)(powf(intensity, LIGHT_BOOST_EXPONENT) * 255.0f);
+    }
+}
+
+// Build the lookup table once, safe to call from several render threads at a time
+static void init_boost_lut(void) {
+    pthread_once(&boost_lut_once, build_boost_lut);
+}
+
+// exp(-x) samples with one extra entry for interpolation
+static float fog_lut[FOG_LUT_SIZE + 1];
+static pthread_once_t fog_lut_once = PTHREAD_ONCE_INIT;
+
+static void build_fog_lut(void) {
+    for (int i = 0; i <= FOG_LUT_SIZE; ++i) {
+        fog_lut[i] = expf(-FOG_EXP_RANGE * i / FOG_LUT_SIZE);
+    }
+    fog_lut[FOG_LUT_SIZE] = 0.0f; // Meet the cut-off continuously
+}
+
+// Build the fog table once (thread-safe like init_boost_lut)
+static void init_fog_lut(void) {
+    pthread_once(&fog_lut_once, build_fog_lut);
+}
+
+// exp(-x) for x >= 0, linearly interpolated from the table
+static inline float fog_exp(float x) {
+    float t = x * (FOG_LUT_SIZE / FOG_EXP_RANGE);
+    if (!(t < (float)FOG_LUT_SIZE)) return 0.0f;
+    if (t < 0.0f) t = 0.0f;
+    int i = (int)t;
+    float frac = t - i;
+    return fog_lut[i] + (fog_lut[i + 1] - fog_lut[i]) * frac;
+}
+
+// LUT index of an intensity (clamped to [0, 1])
+static inline int lut_index(float intensity) {
+    intensity = fmaxf(0.0f, fminf(1.0f, intensity));
+    return (int)(intensity * (LIGHT_LUT_SIZE - 1) + 0.5f);
+}
+
+// Boost and quantize one intensity
+unsigned char lighting_quantize(float intensity) {
+    init_boost_lut();
+    return boost_lut[lut_index(intensity)];
+}
+
 // Function to compute the lighting intensity for an edge defined by two vertices
 float compute_edge_lighting(vec3 v1, vec3 v2, vec3* light_dirs, int num_lights) {
     
@@ -21,6 +91,437 @@ float compute_edge_lighting(vec3 v1, vec3 v2, vec3* light_dirs, int num_lights)
     }
 
     return intensity;
-    const float ambient = 0.2f;  // Minimum base light
-    return fminf(1.0f, ambient + intensity * (1.0f - ambient));
-}
\ No newline at end of file
+}
+
+// Scalar lighting of one edge, same arithmetic as the SIMD lanes
+static float light_edge_scalar(float dx, float dy, float dz, const float *lx, const float *ly, const float *lz,
+                               int num_lights, float inv_lights, bool unit) {
+    if (!unit) {
+        float len = sqrtf(dx * dx + dy * dy + dz * dz);
+        float inv_len = len > 1e-6f ? 1.0f / len : 1.0f; // Leave near-zero edges unnormalized
+        dx *= inv_len;
+        dy *= inv_len;
+        dz *= inv_len;
+    }
+
+    float intensity = 0.0f;
+    for (int l = 0; l < num_lights; ++l) {
+        intensity += fmaxf(0.0f, dx * lx[l] + dy * ly[l] + dz * lz[l]);
+    }
+    return intensity * inv_lights;
+}
+
+// Light many edges at once against a packed light array (unit: directions are already normalized)
+static void light_edges(const float *dir_x, const float *dir_y, const float *dir_z, int num_edges,
+                        const vec3* light_dirs, int num_lights, float ambient, unsigned char *out, bool unit) {
+    if (num_edges <= 0 || out == NULL) return;
+    init_boost_lut();
+    if (light_dirs == NULL || num_lights < 0) num_lights = 0;
+
+    // Pack the light directions as structure-of-arrays
+    float stack_lights[3 * PACKED_LIGHTS_STACK];
+    float *packed = num_lights <= PACKED_LIGHTS_STACK ? stack_lights : malloc(3 * num_lights * sizeof(float));
+    if (packed == NULL) {
+        num_lights = 0; // Out of memory: shade with ambient only
+        packed = stack_lights;
+    }
+    float *lx = packed;
+    float *ly = packed + num_lights;
+    float *lz = packed + 2 * num_lights;
+    for (int l = 0; l < num_lights; ++l) {
+        vec4 d = vec4_from_vec3(light_dirs[l], 0.0f);
+        lx[l] = d.x;
+        ly[l] = d.y;
+        lz[l] = d.z;
+    }
+
+    float inv_lights = num_lights > 0 ? 1.0f / num_lights : 0.0f;
+    ambient = fmaxf(0.0f, fminf(1.0f, ambient));
+    float diffuse_scale = 1.0f - ambient;
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 min_len = _mm_set1_ps(1e-6f);
+    const __m128 v_inv_lights = _mm_set1_ps(inv_lights);
+    const __m128 v_ambient = _mm_set1_ps(ambient);
+    const __m128 v_diffuse = _mm_set1_ps(diffuse_scale);
+    const __m128 v_lut_scale = _mm_set1_ps((float)(LIGHT_LUT_SIZE - 1));
+    const __m128 v_half = _mm_set1_ps(0.5f);
+
+    for (; i + 4 <= num_edges; i += 4) {
+        __m128 dx = _mm_loadu_ps(dir_x + i);
+        __m128 dy = _mm_loadu_ps(dir_y + i);
+        __m128 dz = _mm_loadu_ps(dir_z + i);
+
+        // Normalize (near-zero edges keep their length, like vec3_normalize_fast)
+        if (!unit) {
+            __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+            __m128 big = _mm_cmpgt_ps(len, min_len);
+            __m128 inv_len = _mm_or_ps(_mm_and_ps(big, _mm_div_ps(one, len)), _mm_andnot_ps(big, one));
+            dx = _mm_mul_ps(dx, inv_len);
+            dy = _mm_mul_ps(dy, inv_len);
+            dz = _mm_mul_ps(dz, inv_len);
+        }
+
+        // Sum of clamped Lambert terms over the lights
+        __m128 intensity = zero;
+        for (int l = 0; l < num_lights; ++l) {
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_set1_ps(lx[l])), _mm_mul_ps(dy, _mm_set1_ps(ly[l]))),
+                                    _mm_mul_ps(dz, _mm_set1_ps(lz[l])));
+            intensity = _mm_add_ps(intensity, _mm_max_ps(zero, dot));
+        }
+        intensity = _mm_mul_ps(intensity, v_inv_lights);
+
+        // Ambient floor, clamp and LUT index
+        intensity = _mm_add_ps(v_ambient, _mm_mul_ps(intensity, v_diffuse));
+        intensity = _mm_min_ps(one, _mm_max_ps(zero, intensity));
+        __m128i index = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(intensity, v_lut_scale), v_half));
+
+        int idx[4];
+        _mm_storeu_si128((__m128i *)idx, index);
+        out[i + 0] = boost_lut[idx[0]];
+        out[i + 1] = boost_lut[idx[1]];
+        out[i + 2] = boost_lut[idx[2]];
+        out[i + 3] = boost_lut[idx[3]];
+    }
+#endif
+
+    // Remaining edges (or all of them without SSE2)
+    for (; i < num_edges; ++i) {
+        float intensity = light_edge_scalar(dir_x[i], dir_y[i], dir_z[i], lx, ly, lz, num_lights, inv_lights, unit);
+        out[i] = boost_lut[lut_index(ambient + intensity * diffuse_scale)];
+    }
+
+    if (packed != stack_lights) {
+        free(packed);
+    }
+}
+
+// Light many edges at once
+void compute_edge_lighting_batch(const float *dir_x, const float *dir_y, const float *dir_z, int num_edges,
+                                 const vec3* light_dirs, int num_lights, float ambient, unsigned char *out) {
+    light_edges(dir_x, dir_y, dir_z, num_edges, light_dirs, num_lights, ambient, out, false);
+}
+
+// Light many edges with unit directions at once
+void compute_edge_lighting_batch_unit(const float *dir_x, const float *dir_y, const float *dir_z, int num_edges,
+                                      const vec3* light_dirs, int num_lights, float ambient, unsigned char *out) {
+    light_edges(dir_x, dir_y, dir_z, num_edges, light_dirs, num_lights, ambient, out, true);
+}
+
+// Distance where the fog factor reaches zero
+float fog_max_distance(fog_mode_t mode, float fog_start, float fog_end, float fog_density) {
+    (void)fog_start;
+    switch (mode) {
+        case FOG_LINEAR:
+            return fog_end;
+        case FOG_EXP:
+            return fog_density > 0.0f ? FOG_EXP_RANGE / fog_density : FLT_MAX;
+        case FOG_EXP2:
+            return fog_density > 0.0f ? sqrtf(FOG_EXP_RANGE) / fog_density : FLT_MAX;
+        default:
+            return FLT_MAX;
+    }
+}
+
+// Scale lit edges by their fog factor
+void compute_edge_fog_batch(const float *depth, int num_edges, fog_mode_t mode, float fog_start, float fog_end,
+                            float fog_density, unsigned char *gray) {
+    if (num_edges <= 0 || depth == NULL || gray == NULL || mode == FOG_NONE) return;
+    int i = 0;
+
+    if (mode == FOG_LINEAR) {
+        float range = fog_end - fog_start;
+        float inv_range = fabsf(range) > 1e-6f ? 1.0f / range : 1e6f; // Degenerate range: hard cut at fog_end
+
+#if defined(__SSE2__)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 v_end = _mm_set1_ps(fog_end);
+        const __m128 v_inv_range = _mm_set1_ps(inv_range);
+        const __m128 v_half = _mm_set1_ps(0.5f);
+
+        for (; i + 4 <= num_edges; i += 4) {
+            __m128 f = _mm_mul_ps(_mm_sub_ps(v_end, _mm_loadu_ps(depth + i)), v_inv_range);
+            f = _mm_min_ps(one, _mm_max_ps(zero, f));
+
+            __m128 g = _mm_setr_ps(gray[i], gray[i + 1], gray[i + 2], gray[i + 3]);
+            int scaled[4];
+            _mm_storeu_si128((__m128i *)scaled, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(g, f), v_half)));
+            gray[i + 0] = (unsigned char)scaled[0];
+            gray[i + 1] = (unsigned char)scaled[1];
+            gray[i + 2] = (unsigned char)scaled[2];
+            gray[i + 3] = (unsigned char)scaled[3];
+        }
+#endif
+
+        for (; i < num_edges; ++i) {
+            float f = fmaxf(0.0f, fminf(1.0f, (fog_end - depth[i]) * inv_range));
+            gray[i] = (unsigned char)(gray[i] * f + 0.5f);
+        }
+        return;
+    }
+
+    // Exponential modes: one table lookup per edge instead of expf
+    init_fog_lut();
+    for (; i < num_edges; ++i) {
+        float x = fog_density * fmaxf(0.0f, depth[i]);
+        if (mode == FOG_EXP2) x *= x;
+        gray[i] = (unsigned char)(gray[i] * fog_exp(x) + 0.5f);
+    }
+}
+
+
+// =======================
+// Light Objects
+// =======================
+
+// Scale a 3-vector to unit length (left unchanged if near zero)
+static void normalize_dir(float d[3]) {
+    float len = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    if (len > 1e-6f) {
+        d[0] /= len;
+        d[1] /= len;
+        d[2] /= len;
+    }
+}
+
+// Directional light
+light_t light_directional(float dx, float dy, float dz, float intensity) {
+    light_t light = {0};
+    light.type = LIGHT_DIRECTIONAL;
+    light.direction[0] = dx;
+    light.direction[1] = dy;
+    light.direction[2] = dz;
+    normalize_dir(light.direction);
+    light.intensity = intensity;
+    return light;
+}
+
+// Point light
+light_t light_point(float x, float y, float z, float range, float intensity) {
+    light_t light = {0};
+    light.type = LIGHT_POINT;
+    light.position[0] = x;
+    light.position[1] = y;
+    light.position[2] = z;
+    light.range = range;
+    light.intensity = intensity;
+    return light;
+}
+
+// Spot light
+light_t light_spot(float x, float y, float z, float dx, float dy, float dz, float range, float inner_angle, float outer_angle, float intensity) {
+    light_t light = light_point(x, y, z, range, intensity);
+    light.type = LIGHT_SPOT;
+    light.direction[0] = dx;
+    light.direction[1] = dy;
+    light.direction[2] = dz;
+    normalize_dir(light.direction);
+    light.inner_cos = cosf(inner_angle);
+    light.outer_cos = cosf(outer_angle);
+    return light;
+}
+
+// Free the lists of a light grid
+void light_grid_free(light_grid_t *grid) {
+    if (!grid) return;
+    free(grid->global_lights);
+    free(grid->tile_offsets);
+    free(grid->tile_lights);
+    grid->global_lights = NULL;
+    grid->tile_offsets = NULL;
+    grid->tile_lights = NULL;
+}
+
+// Tile coordinate clamped to [0, count - 1]
+static inline int clamp_tile(float t, int count) {
+    return t <= 0.0f ? 0 : t >= (float)(count - 1) ? count - 1 : (int)t;
+}
+
+// Screen tile rectangle covered by a local light, or false if it surrounds the camera
+static bool light_tile_rect(const light_t *light, mat4 view_matrix, mat4 projection_matrix, int width, int height,
+                            int tiles_x, int tiles_y, int rect[4]) {
+    vec4 c = mat4_mul_vec4(view_matrix, (vec4){light->position[0], light->position[1], light->position[2], 1.0f});
+    float r = light->range;
+
+    // The camera looks down -Z: a sphere reaching z >= 0 has no finite projection
+    if (c.z + r >= -1e-4f) return false;
+
+    // Project the corners of the sphere's view-space bounding box
+    float min_x = 1e30f, min_y = 1e30f, max_x = -1e30f, max_y = -1e30f;
+    for (int k = 0; k < 8; ++k) {
+        vec4 corner = {c.x + ((k & 1) ? r : -r), c.y + ((k & 2) ? r : -r), c.z + ((k & 4) ? r : -r), 1.0f};
+        vec4 p = mat4_mul_vec4(projection_matrix, corner);
+        if (p.w <= 1e-6f) return false;
+        float sx = (p.x / p.w + 1.0f) * 0.5f * width;
+        float sy = (1.0f - p.y / p.w) * 0.5f * height;
+        min_x = fminf(min_x, sx);
+        max_x = fmaxf(max_x, sx);
+        min_y = fminf(min_y, sy);
+        max_y = fmaxf(max_y, sy);
+    }
+
+    // Clamp into the grid: a light beside the screen lands on the border tiles, where the edges whose midpoints
+    // project off-screen are binned too, instead of being dropped
+    rect[0] = clamp_tile(floorf(min_x / LIGHT_TILE_SIZE), tiles_x);
+    rect[1] = clamp_tile(floorf(min_y / LIGHT_TILE_SIZE), tiles_y);
+    rect[2] = clamp_tile(floorf(max_x / LIGHT_TILE_SIZE), tiles_x);
+    rect[3] = clamp_tile(floorf(max_y / LIGHT_TILE_SIZE), tiles_y);
+    return true;
+}
+
+// Cull lights to an object and bin them per screen tile
+bool light_grid_build(light_grid_t *grid, const light_t *lights, int num_lights, mat4 view_matrix, mat4 projection_matrix,
+                      int width, int height, const float bounds_center[3], float bounds_radius) {
+    memset(grid, 0, sizeof(*grid));
+    grid->lights = lights;
+    grid->tiles_x = (width + LIGHT_TILE_SIZE - 1) / LIGHT_TILE_SIZE;
+    grid->tiles_y = (height + LIGHT_TILE_SIZE - 1) / LIGHT_TILE_SIZE;
+    if (grid->tiles_x < 1) grid->tiles_x = 1;
+    if (grid->tiles_y < 1) grid->tiles_y = 1;
+    int num_tiles = grid->tiles_x * grid->tiles_y;
+    if (lights == NULL || num_lights < 0) num_lights = 0;
+
+    int *rects = malloc((num_lights > 0 ? num_lights : 1) * 4 * sizeof(int));
+    unsigned char *kind = malloc(num_lights > 0 ? num_lights : 1); // 0 culled, 1 global, 2 tiled
+    grid->global_lights = malloc((num_lights > 0 ? num_lights : 1) * sizeof(int));
+    grid->tile_offsets = calloc(num_tiles + 1, sizeof(int));
+    if (!rects || !kind || !grid->global_lights || !grid->tile_offsets) {
+        free(rects);
+        free(kind);
+        light_grid_free(grid);
+        return false;
+    }
+
+    // Classify every light and count tile entries
+    for (int i = 0; i < num_lights; ++i) {
+        const light_t *light = &lights[i];
+        kind[i] = 0;
+        if (light->intensity == 0.0f) continue;
+
+        if (light->type == LIGHT_DIRECTIONAL) {
+            kind[i] = 1;
+        } else {
+            if (light->range <= 0.0f) continue;
+
+            // Object bounds: the light sphere must overlap the object's sphere
+            if (bounds_radius >= 0.0f && bounds_center != NULL) {
+                float dx = light->position[0] - bounds_center[0];
+                float dy = light->position[1] - bounds_center[1];
+                float dz = light->position[2] - bounds_center[2];
+                float reach = light->range + bounds_radius;
+                if (dx * dx + dy * dy + dz * dz > reach * reach) continue;
+            }
+
+            if (!light_tile_rect(light, view_matrix, projection_matrix, width, height, grid->tiles_x, grid->tiles_y, rects + 4 * i)) {
+                kind[i] = 1; // Around the camera: reaches every tile
+            } else {
+                kind[i] = 2;
+                for (int ty = rects[4 * i + 1]; ty <= rects[4 * i + 3]; ++ty)
+                    for (int tx = rects[4 * i]; tx <= rects[4 * i + 2]; ++tx)
+                        grid->tile_offsets[ty * grid->tiles_x + tx + 1]++;
+            }
+        }
+
+        if (kind[i] == 1) {
+            grid->global_lights[grid->num_global++] = i;
+        }
+    }
+
+    // Prefix sums, then fill the per-tile lists
+    for (int t = 0; t < num_tiles; ++t) {
+        grid->tile_offsets[t + 1] += grid->tile_offsets[t];
+    }
+    int total = grid->tile_offsets[num_tiles];
+    grid->tile_lights = malloc((total > 0 ? total : 1) * sizeof(int));
+    int *cursor = malloc(num_tiles * sizeof(int));
+    if (!grid->tile_lights || !cursor) {
+        free(cursor);
+        free(rects);
+        free(kind);
+        light_grid_free(grid);
+        return false;
+    }
+    memcpy(cursor, grid->tile_offsets, num_tiles * sizeof(int));
+    for (int i = 0; i < num_lights; ++i) {
+        if (kind[i] != 2) continue;
+        for (int ty = rects[4 * i + 1]; ty <= rects[4 * i + 3]; ++ty)
+            for (int tx = rects[4 * i]; tx <= rects[4 * i + 2]; ++tx)
+                grid->tile_lights[cursor[ty * grid->tiles_x + tx]++] = i;
+    }
+
+    free(cursor);
+    free(rects);
+    free(kind);
+    return true;
+}
+
+// Contribution of one light object to an edge with unit direction d at world point p
+static float light_object_term(const light_t *light, const float d[3], const float p[3]) {
+    if (light->type == LIGHT_DIRECTIONAL) {
+        return light->intensity * fmaxf(0.0f, d[0] * light->direction[0] + d[1] * light->direction[1] + d[2] * light->direction[2]);
+    }
+
+    // Vector to the light and range test
+    float lx = light->position[0] - p[0];
+    float ly = light->position[1] - p[1];
+    float lz = light->position[2] - p[2];
+    float dist_sq = lx * lx + ly * ly + lz * lz;
+    float range_sq = light->range * light->range;
+    if (dist_sq >= range_sq) return 0.0f;
+
+    float inv_dist = dist_sq > 1e-12f ? 1.0f / sqrtf(dist_sq) : 0.0f;
+    lx *= inv_dist;
+    ly *= inv_dist;
+    lz *= inv_dist;
+
+    // Smooth window that reaches zero at the range
+    float falloff = 1.0f - dist_sq / range_sq;
+    float attenuation = falloff * falloff;
+
+    if (light->type == LIGHT_SPOT) {
+        // Angle between the cone axis and the light-to-point direction
+        float cos_angle = -(lx * light->direction[0] + ly * light->direction[1] + lz * light->direction[2]);
+        if (cos_angle <= light->outer_cos) return 0.0f;
+        float span = light->inner_cos - light->outer_cos;
+        float t = span > 1e-6f ? fminf(1.0f, (cos_angle - light->outer_cos) / span) : 1.0f;
+        attenuation *= t * t * (3.0f - 2.0f * t); // Smoothstep between the two cones
+    }
+
+    return light->intensity * attenuation * fmaxf(0.0f, d[0] * lx + d[1] * ly + d[2] * lz);
+}
+
+// Light many edges against a light grid
+void compute_edge_lighting_grid(const float *dir_x, const float *dir_y, const float *dir_z,
+                                const float *mid_x, const float *mid_y, const float *mid_z, const int *tiles, int num_edges,
+                                const light_grid_t *grid, float ambient, unsigned char *out) {
+    if (num_edges <= 0 || out == NULL || grid == NULL) return;
+    init_boost_lut();
+    ambient = fmaxf(0.0f, fminf(1.0f, ambient));
+    int num_tiles = grid->tiles_x * grid->tiles_y;
+
+    for (int i = 0; i < num_edges; ++i) {
+        float d[3] = {dir_x[i], dir_y[i], dir_z[i]};
+        normalize_dir(d);
+        float p[3] = {mid_x[i], mid_y[i], mid_z[i]};
+
+        // Lights that reach everything
+        float intensity = 0.0f;
+        for (int k = 0; k < grid->num_global; ++k) {
+            intensity += light_object_term(&grid->lights[grid->global_lights[k]], d, p);
+        }
+
+        // Local lights overlapping this edge's tile only
+        int tile = tiles[i];
+        if (tile >= 0 && tile < num_tiles) {
+            for (int k = grid->tile_offsets[tile]; k < grid->tile_offsets[tile + 1]; ++k) {
+                intensity += light_object_term(&grid->lights[grid->tile_lights[k]], d, p);
+            }
+        }
+
+        out[i] = boost_lut[lut_index(ambient + fminf(1.0f, intensity) * (1.0f - ambient))];
+    }
+}
@@ -276,6 +276,19 @@ mat4 mat4_perspective(float l, float r, float b, float t, float n, float f) {
     return m;
 }
 
+// Parallel projection of the box [l, r] x [b, t] x [-n, -f] onto NDC
+mat4 mat4_orthographic(float l, float r, float b, float t, float n, float f) {
+    mat4 m = {{0}};
+    m.m[0] = 2.0f / (r - l);
+    m.m[5] = 2.0f / (t - b);
+    m.m[10] = -2.0f / (f - n);
+    m.m[12] = -(r + l) / (r - l);
+    m.m[13] = -(t + b) / (t - b);
+    m.m[14] = -(f + n) / (f - n);
+    m.m[15] = 1.0f;
+    return m;
+}
+
 // Multiply two 4x4 matrices
 mat4 mat4_mul(mat4 a, mat4 b) {
     mat4 result;
@@ -299,4 +312,146 @@ vec4 mat4_mul_vec4(mat4 m, vec4 v) {
     result.z = m.m[2] * v.x + m.m[6] * v.y + m.m[10] * v.z + m.m[14] * v.w;
     result.w = m.m[3] * v.x + m.m[7] * v.y + m.m[11] * v.z + m.m[15] * v.w;
     return result;
+}
+
+
+// =======================
+// Quaternion Operations
+// =======================
+
+// Identity rotation
+quat quat_identity(void) {
+    return (quat){0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+// Rotation of angle radians around an axis (normalized here)
+quat quat_from_axis_angle(float ax, float ay, float az, float angle) {
+    float len = sqrtf(ax * ax + ay * ay + az * az);
+    if (len < 1e-8f) return quat_identity();
+    float s = sinf(0.5f * angle) / len;
+    return (quat){ax * s, ay * s, az * s, cosf(0.5f * angle)};
+}
+
+// Rotation around X, then Y, then Z (matches mat4_rotate_xyz = Rz * Ry * Rx)
+quat quat_from_euler_xyz(float rx, float ry, float rz) {
+    quat qx = quat_from_axis_angle(1.0f, 0.0f, 0.0f, rx);
+    quat qy = quat_from_axis_angle(0.0f, 1.0f, 0.0f, ry);
+    quat qz = quat_from_axis_angle(0.0f, 0.0f, 1.0f, rz);
+    return quat_mul(qz, quat_mul(qy, qx));
+}
+
+// Hamilton product: rotate by b, then by a
+quat quat_mul(quat a, quat b) {
+    return (quat){
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+    };
+}
+
+// Scale a quaternion to unit length
+quat quat_normalize(quat q) {
+    float len = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (len < 1e-8f) return quat_identity();
+    float inv = 1.0f / len;
+    return (quat){q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+}
+
+// Spherical linear interpolation between two rotations
+quat quat_slerp(quat a, quat b, float t) {
+    float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+
+    // q and -q are the same rotation: take the shorter way round
+    if (dot < 0.0f) {
+        b = (quat){-b.x, -b.y, -b.z, -b.w};
+        dot = -dot;
+    }
+
+    float wa, wb;
+    if (dot > 0.9995f) {
+        // Nearly parallel: lerp is accurate and avoids dividing by sin(~0)
+        wa = 1.0f - t;
+        wb = t;
+    } else {
+        float theta = acosf(dot);
+        float inv_sin = 1.0f / sinf(theta);
+        wa = sinf((1.0f - t) * theta) * inv_sin;
+        wb = sinf(t * theta) * inv_sin;
+    }
+    return quat_normalize((quat){wa * a.x + wb * b.x, wa * a.y + wb * b.y, wa * a.z + wb * b.z, wa * a.w + wb * b.w});
+}
+
+// Rotation matrix of a unit quaternion
+mat4 mat4_from_quat(quat q) {
+    float one[3] = {1.0f, 1.0f, 1.0f};
+    float zero[3] = {0.0f, 0.0f, 0.0f};
+    return mat4_from_trs(zero, q, one);
+}
+
+// Translation * rotation * scale in one step
+mat4 mat4_from_trs(const float translation[3], quat q, const float scale[3]) {
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    mat4 m;
+    m.m[0] = (1.0f - 2.0f * (yy + zz)) * scale[0];
+    m.m[1] = 2.0f * (xy + wz) * scale[0];
+    m.m[2] = 2.0f * (xz - wy) * scale[0];
+    m.m[3] = 0.0f;
+
+    m.m[4] = 2.0f * (xy - wz) * scale[1];
+    m.m[5] = (1.0f - 2.0f * (xx + zz)) * scale[1];
+    m.m[6] = 2.0f * (yz + wx) * scale[1];
+    m.m[7] = 0.0f;
+
+    m.m[8] = 2.0f * (xz + wy) * scale[2];
+    m.m[9] = 2.0f * (yz - wx) * scale[2];
+    m.m[10] = (1.0f - 2.0f * (xx + yy)) * scale[2];
+    m.m[11] = 0.0f;
+
+    m.m[12] = translation[0];
+    m.m[13] = translation[1];
+    m.m[14] = translation[2];
+    m.m[15] = 1.0f;
+    return m;
+}
+
+// Detect rotation * uniform scale + translation and extract the rotation
+bool mat4_rigid_rotation(mat4 m, float rotation[9]) {
+    const float tolerance = 1e-4f;
+
+    // No projective row
+    if (fabsf(m.m[3]) > tolerance || fabsf(m.m[7]) > tolerance || fabsf(m.m[11]) > tolerance ||
+        fabsf(m.m[15] - 1.0f) > tolerance) {
+        return false;
+    }
+
+    // Columns of the upper 3x3 must share one length...
+    const float *c0 = &m.m[0], *c1 = &m.m[4], *c2 = &m.m[8];
+    float l0 = c0[0] * c0[0] + c0[1] * c0[1] + c0[2] * c0[2];
+    float l1 = c1[0] * c1[0] + c1[1] * c1[1] + c1[2] * c1[2];
+    float l2 = c2[0] * c2[0] + c2[1] * c2[1] + c2[2] * c2[2];
+    if (l0 < 1e-12f || fabsf(l1 - l0) > tolerance * l0 || fabsf(l2 - l0) > tolerance * l0) {
+        return false;
+    }
+
+    // ...and be mutually orthogonal
+    float d01 = c0[0] * c1[0] + c0[1] * c1[1] + c0[2] * c1[2];
+    float d02 = c0[0] * c2[0] + c0[1] * c2[1] + c0[2] * c2[2];
+    float d12 = c1[0] * c2[0] + c1[1] * c2[1] + c1[2] * c2[2];
+    if (fabsf(d01) > tolerance * l0 || fabsf(d02) > tolerance * l0 || fabsf(d12) > tolerance * l0) {
+        return false;
+    }
+
+    if (rotation != NULL) {
+        float inv_scale = 1.0f / sqrtf(l0);
+        for (int c = 0; c < 3; ++c) {
+            for (int r = 0; r < 3; ++r) {
+                rotation[3 * c + r] = m.m[4 * c + r] * inv_scale;
+            }
+        }
+    }
+    return true;
 }
\ No newline at end of file
@@ -0,0 +1,652 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "tiny3d.h"
+#include "mesh.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Largest magnitude of a quantized coordinate (symmetric int16 range)
+#define QUANT16_MAX 32767.0f
+
+// Vertex counts up to this limit can be addressed with 16-bit indices
+#define INDEX16_MAX_VERTICES 65536
+
+// Marks an empty slot in the edge hash map
+#define EDGE_MAP_EMPTY UINT64_MAX
+
+// =======================
+// Edge Hash Map
+// =======================
+
+// Open-addressing map from an undirected vertex pair to an edge number
+typedef struct {
+    uint64_t *keys;
+    int *values;
+    int mask;       // Capacity - 1 (capacity is a power of two)
+} edge_map_t;
+
+// Key for an undirected edge (order independent)
+static uint64_t edge_key(int a, int b) {
+    uint32_t lo = (uint32_t)(a < b ? a : b);
+    uint32_t hi = (uint32_t)(a < b ? b : a);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+// Mix the key bits so neighbouring vertex pairs spread across the table
+static uint32_t edge_hash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (uint32_t)key;
+}
+
+// Allocate a map with room for at least expected_edges entries at <= 50% load
+static bool edge_map_init(edge_map_t *map, int expected_edges) {
+    int capacity = 16;
+    while (capacity < 2 * expected_edges) capacity <<= 1;
+
+    map->keys = malloc(capacity * sizeof(uint64_t));
+    map->values = malloc(capacity * sizeof(int));
+    if (!map->keys || !map->values) {
+        free(map->keys);
+        free(map->values);
+        return false;
+    }
+    memset(map->keys, 0xff, capacity * sizeof(uint64_t)); // All slots EDGE_MAP_EMPTY
+    map->mask = capacity - 1;
+    return true;
+}
+
+static void edge_map_free(edge_map_t *map) {
+    free(map->keys);
+    free(map->values);
+}
+
+// Find the edge (a, b), or insert it with the given value. Returns the stored value.
+static int edge_map_find_or_insert(edge_map_t *map, int a, int b, int value) {
+    uint64_t key = edge_key(a, b);
+    uint32_t slot = edge_hash(key) & map->mask;
+    while (map->keys[slot] != EDGE_MAP_EMPTY) {
+        if (map->keys[slot] == key) return map->values[slot];
+        slot = (slot + 1) & map->mask;
+    }
+    map->keys[slot] = key;
+    map->values[slot] = value;
+    return value;
+}
+
+// Find the edge (a, b), or -1 if it is not in the map
+static int edge_map_find(const edge_map_t *map, int a, int b) {
+    uint64_t key = edge_key(a, b);
+    uint32_t slot = edge_hash(key) & map->mask;
+    while (map->keys[slot] != EDGE_MAP_EMPTY) {
+        if (map->keys[slot] == key) return map->values[slot];
+        slot = (slot + 1) & map->mask;
+    }
+    return -1;
+}
+
+// =======================
+// Compact Meshes
+// =======================
+
+// Read the Cartesian position of an object vertex
+static void object_vertex_position(const object3d_t *object, int i, float out[3]) {
+    vec4 v = vec4_from_vec3(object->vertices[i], 1.0f);
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+// Pack positions as float3, or quantize them to int16 over the bounding box
+static bool pack_positions(compact_mesh_t *mesh, const object3d_t *object) {
+    int n = object->num_vertices;
+
+    if (mesh->position_format == MESH_POSITIONS_FLOAT3) {
+        float *positions = malloc(3 * n * sizeof(float));
+        if (!positions) return false;
+        for (int i = 0; i < n; ++i) {
+            object_vertex_position(object, i, positions + 3 * i);
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            mesh->dequant_offset[axis] = 0.0f;
+            mesh->dequant_scale[axis] = 1.0f;
+        }
+        mesh->positions = positions;
+        return true;
+    }
+
+    // Bounding box of the object
+    float bb_min[3], bb_max[3];
+    object_vertex_position(object, 0, bb_min);
+    object_vertex_position(object, 0, bb_max);
+    for (int i = 1; i < n; ++i) {
+        float p[3];
+        object_vertex_position(object, i, p);
+        for (int axis = 0; axis < 3; ++axis) {
+            bb_min[axis] = fminf(bb_min[axis], p[axis]);
+            bb_max[axis] = fmaxf(bb_max[axis], p[axis]);
+        }
+    }
+
+    // Map the box onto [-32767, 32767] around its center
+    float inv_scale[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        float half_extent = 0.5f * (bb_max[axis] - bb_min[axis]);
+        if (half_extent <= 0.0f) half_extent = 1.0f; // Flat axis, any scale works
+        mesh->dequant_offset[axis] = 0.5f * (bb_min[axis] + bb_max[axis]);
+        mesh->dequant_scale[axis] = half_extent / QUANT16_MAX;
+        inv_scale[axis] = QUANT16_MAX / half_extent;
+    }
+
+    int16_t *positions = malloc(3 * n * sizeof(int16_t));
+    if (!positions) return false;
+    for (int i = 0; i < n; ++i) {
+        float p[3];
+        object_vertex_position(object, i, p);
+        for (int axis = 0; axis < 3; ++axis) {
+            float q = (p[axis] - mesh->dequant_offset[axis]) * inv_scale[axis];
+            q = fmaxf(-QUANT16_MAX, fminf(QUANT16_MAX, q));
+            positions[3 * i + axis] = (int16_t)lrintf(q);
+        }
+    }
+    mesh->positions = positions;
+    return true;
+}
+
+// Copy the valid edges of the object into 16- or 32-bit index storage
+static bool pack_indices(compact_mesh_t *mesh, const object3d_t *object) {
+    int n = object->num_vertices;
+    mesh->index_size = (n <= INDEX16_MAX_VERTICES) ? 2 : 4;
+
+    mesh->indices = malloc((object->num_indices & ~1) * mesh->index_size);
+    if (!mesh->indices) return false;
+
+    mesh->num_indices = 0;
+    for (int i = 0; i + 1 < object->num_indices; i += 2) {
+        int a = object->indices[i];
+        int b = object->indices[i + 1];
+
+        // Drop edges that would alias a valid vertex once narrowed
+        if (a < 0 || a >= n || b < 0 || b >= n) {
+            fprintf(stderr, "Warning: Invalid vertex index in object->indices\n");
+            continue;
+        }
+
+        if (mesh->index_size == 2) {
+            uint16_t *idx = mesh->indices;
+            idx[mesh->num_indices] = (uint16_t)a;
+            idx[mesh->num_indices + 1] = (uint16_t)b;
+        } else {
+            uint32_t *idx = mesh->indices;
+            idx[mesh->num_indices] = (uint32_t)a;
+            idx[mesh->num_indices + 1] = (uint32_t)b;
+        }
+        mesh->num_indices += 2;
+    }
+    return true;
+}
+
+// Build a compact copy of an object
+compact_mesh_t *compact_mesh_create(const object3d_t *object, mesh_position_format_t format) {
+    if (object == NULL || object->vertices == NULL || object->indices == NULL || object->num_vertices <= 0) {
+        return NULL;
+    }
+
+    compact_mesh_t *mesh = calloc(1, sizeof(compact_mesh_t));
+    if (!mesh) return NULL;
+
+    mesh->position_format = format;
+    mesh->num_vertices = object->num_vertices;
+
+    if (!pack_positions(mesh, object) || !pack_indices(mesh, object)) {
+        compact_mesh_destroy(mesh);
+        return NULL;
+    }
+    return mesh;
+}
+
+// Free the memory used by a compact mesh
+void compact_mesh_destroy(compact_mesh_t *mesh) {
+    if (!mesh) return;
+    free(mesh->positions);
+    free(mesh->indices);
+    free(mesh);
+}
+
+// Matrix that maps stored positions back to object space
+mat4 compact_mesh_dequant_matrix(const compact_mesh_t *mesh) {
+    mat4 m = mat4_scale(mesh->dequant_scale[0], mesh->dequant_scale[1], mesh->dequant_scale[2]);
+    m.m[12] = mesh->dequant_offset[0];
+    m.m[13] = mesh->dequant_offset[1];
+    m.m[14] = mesh->dequant_offset[2];
+    return m;
+}
+
+// =======================
+// Face Adjacency
+// =======================
+
+// Build object->edge_faces from object->faces and the edge list
+int object3d_build_edge_faces(object3d_t *object) {
+    if (object == NULL || object->indices == NULL || object->faces == NULL) {
+        return -1;
+    }
+
+    int num_edges = object->num_indices / 2;
+    int *edge_faces = malloc((num_edges > 0 ? num_edges : 1) * 2 * sizeof(int));
+    if (!edge_faces) return -1;
+    for (int e = 0; e < 2 * num_edges; ++e) {
+        edge_faces[e] = -1;
+    }
+
+    edge_map_t map;
+    if (!edge_map_init(&map, num_edges)) {
+        free(edge_faces);
+        return -1;
+    }
+
+    // Index the edge list (duplicate edges keep their first occurrence)
+    for (int e = 0; e < num_edges; ++e) {
+        edge_map_find_or_insert(&map, object->indices[2 * e], object->indices[2 * e + 1], e);
+    }
+
+    // Attach every face to the listed edges it borders
+    for (int f = 0; f < object->num_faces; ++f) {
+        const int *tri = object->faces + 3 * f;
+        for (int k = 0; k < 3; ++k) {
+            int e = edge_map_find(&map, tri[k], tri[(k + 1) % 3]);
+            if (e < 0) continue; // Face edge not drawn (e.g. a quad diagonal)
+
+            if (edge_faces[2 * e] < 0) {
+                edge_faces[2 * e] = f;
+            } else if (edge_faces[2 * e + 1] < 0) {
+                edge_faces[2 * e + 1] = f;
+            }
+            // Non-manifold edges keep their first two faces
+        }
+    }
+
+    edge_map_free(&map);
+    free(object->edge_faces);
+    object->edge_faces = edge_faces;
+    return 0;
+}
+
+
+// Build object->edge_dirs from the vertex positions and the edge list
+int object3d_build_edge_dirs(object3d_t *object) {
+    if (object == NULL || object->vertices == NULL || object->indices == NULL) {
+        return -1;
+    }
+
+    int num_edges = object->num_indices / 2;
+    float *edge_dirs = malloc((num_edges > 0 ? num_edges : 1) * 3 * sizeof(float));
+    if (!edge_dirs) return -1;
+
+    for (int e = 0; e < num_edges; ++e) {
+        float *d = edge_dirs + 3 * e;
+        d[0] = d[1] = d[2] = 0.0f;
+
+        int i0 = object->indices[2 * e];
+        int i1 = object->indices[2 * e + 1];
+        if (i0 < 0 || i0 >= object->num_vertices || i1 < 0 || i1 >= object->num_vertices) {
+            continue; // Skipped by the renderer anyway
+        }
+
+        vec4 p0 = vec4_from_vec3(object->vertices[i0], 1.0f);
+        vec4 p1 = vec4_from_vec3(object->vertices[i1], 1.0f);
+        d[0] = p1.x - p0.x;
+        d[1] = p1.y - p0.y;
+        d[2] = p1.z - p0.z;
+
+        // Same rule as the lighting pass: near-zero edges keep their length
+        float len = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        if (len > 1e-6f) {
+            d[0] /= len;
+            d[1] /= len;
+            d[2] /= len;
+        }
+    }
+
+    free(object->edge_dirs);
+    object->edge_dirs = edge_dirs;
+    return 0;
+}
+
+// =======================
+// Procedural Meshes
+// =======================
+
+// Highest icosphere level; level 10 already has 31M edges
+#define ICOSPHERE_MAX_LEVEL 10
+
+// Truncated icosahedron vertex and edge counts
+#define SOCCER_VERTICES 60
+#define SOCCER_EDGES 90
+
+// Vertex from Cartesian coordinates (spherical form computed on demand)
+static vec3 cartesian_vertex(float x, float y, float z) {
+    vec3 v = {x, y, z, 0, 0, 0, true, false};
+    return v;
+}
+
+// Allocate an object with room for the given counts (num_faces may be 0)
+static object3d_t *object_alloc(int num_vertices, int num_edges, int num_faces) {
+    object3d_t *object = calloc(1, sizeof(object3d_t));
+    if (!object) return NULL;
+
+    object->vertices = malloc(num_vertices * sizeof(vec3));
+    object->indices = malloc(2 * (size_t)num_edges * sizeof(int));
+    object->faces = num_faces > 0 ? malloc(3 * (size_t)num_faces * sizeof(int)) : NULL;
+    if (!object->vertices || !object->indices || (num_faces > 0 && !object->faces)) {
+        object3d_destroy(object);
+        return NULL;
+    }
+    object->num_vertices = num_vertices;
+    object->num_indices = 2 * num_edges;
+    object->num_faces = num_faces;
+    return object;
+}
+
+static void set_edge(object3d_t *object, int e, int a, int b) {
+    object->indices[2 * e] = a;
+    object->indices[2 * e + 1] = b;
+}
+
+static void set_face(object3d_t *object, int f, int a, int b, int c) {
+    object->faces[3 * f] = a;
+    object->faces[3 * f + 1] = b;
+    object->faces[3 * f + 2] = c;
+}
+
+// Two triangles for the quad a-b-c-d (counter-clockwise)
+static void set_quad(object3d_t *object, int f, int a, int b, int c, int d) {
+    set_face(object, f, a, b, c);
+    set_face(object, f + 1, a, c, d);
+}
+
+// Index of the normalized midpoint of edge (a, b), creating the vertex the first time the edge is seen
+static int icosphere_midpoint(object3d_t *object, edge_map_t *map, int a, int b) {
+    int index = edge_map_find_or_insert(map, a, b, object->num_vertices);
+    if (index == object->num_vertices) {
+        vec3 p = object->vertices[a], q = object->vertices[b];
+        float x = p.x + q.x, y = p.y + q.y, z = p.z + q.z;
+        float inv = 1.0f / sqrtf(x * x + y * y + z * z);
+        object->vertices[object->num_vertices++] = cartesian_vertex(x * inv, y * inv, z * inv);
+    }
+    return index;
+}
+
+object3d_t *mesh_create_truncated_icosahedron(void) {
+    static const float positions[SOCCER_VERTICES][3] = {
+        {-0.97943199f, 0.0f, -0.201774f}, {-0.97943199f, 0.0f, 0.201774f}, {-0.854729f, -0.32647699f, -0.403548f},
+        {-0.854729f, -0.32647699f, 0.403548f}, {-0.854729f, 0.32647699f, -0.403548f}, {-0.854729f, 0.32647699f, 0.403548f},
+        {-0.73002601f, -0.652955f, -0.201774f}, {-0.73002601f, -0.652955f, 0.201774f}, {-0.73002601f, 0.652955f, -0.201774f},
+        {-0.73002601f, 0.652955f, 0.201774f}, {-0.652955f, -0.201774f, -0.73002601f}, {-0.652955f, -0.201774f, 0.73002601f},
+        {-0.652955f, 0.201774f, -0.73002601f}, {-0.652955f, 0.201774f, 0.73002601f}, {-0.403548f, -0.854729f, -0.32647699f},
+        {-0.403548f, -0.854729f, 0.32647699f}, {-0.403548f, 0.854729f, -0.32647699f}, {-0.403548f, 0.854729f, 0.32647699f},
+        {-0.32647699f, -0.403548f, -0.854729f}, {-0.32647699f, -0.403548f, 0.854729f}, {-0.32647699f, 0.403548f, -0.854729f},
+        {-0.32647699f, 0.403548f, 0.854729f}, {-0.201774f, -0.97943199f, 0.0f}, {-0.201774f, -0.73002601f, -0.652955f},
+        {-0.201774f, -0.73002601f, 0.652955f}, {-0.201774f, 0.73002601f, -0.652955f}, {-0.201774f, 0.73002601f, 0.652955f},
+        {-0.201774f, 0.97943199f, 0.0f}, {0.0f, -0.201774f, -0.97943199f}, {0.0f, -0.201774f, 0.97943199f},
+        {0.0f, 0.201774f, -0.97943199f}, {0.0f, 0.201774f, 0.97943199f}, {0.201774f, -0.97943199f, 0.0f},
+        {0.201774f, -0.73002601f, -0.652955f}, {0.201774f, -0.73002601f, 0.652955f}, {0.201774f, 0.73002601f, -0.652955f},
+        {0.201774f, 0.73002601f, 0.652955f}, {0.201774f, 0.97943199f, 0.0f}, {0.32647699f, -0.403548f, -0.854729f},
+        {0.32647699f, -0.403548f, 0.854729f}, {0.32647699f, 0.403548f, -0.854729f}, {0.32647699f, 0.403548f, 0.854729f},
+        {0.403548f, -0.854729f, -0.32647699f}, {0.403548f, -0.854729f, 0.32647699f}, {0.403548f, 0.854729f, -0.32647699f},
+        {0.403548f, 0.854729f, 0.32647699f}, {0.652955f, -0.201774f, -0.73002601f}, {0.652955f, -0.201774f, 0.73002601f},
+        {0.652955f, 0.201774f, -0.73002601f}, {0.652955f, 0.201774f, 0.73002601f}, {0.73002601f, -0.652955f, -0.201774f},
+        {0.73002601f, -0.652955f, 0.201774f}, {0.73002601f, 0.652955f, -0.201774f}, {0.73002601f, 0.652955f, 0.201774f},
+        {0.854729f, -0.32647699f, -0.403548f}, {0.854729f, -0.32647699f, 0.403548f}, {0.854729f, 0.32647699f, -0.403548f},
+        {0.854729f, 0.32647699f, 0.403548f}, {0.97943199f, 0.0f, -0.201774f}, {0.97943199f, 0.0f, 0.201774f}
+    };
+    object3d_t *object = object_alloc(SOCCER_VERTICES, SOCCER_EDGES, 0);
+    if (!object) return NULL;
+    for (int i = 0; i < SOCCER_VERTICES; ++i) {
+        object->vertices[i] = cartesian_vertex(positions[i][0], positions[i][1], positions[i][2]);
+    }
+
+    // Every edge has the length of edge 0-1; the pair loop is cheap at 60 vertices
+    float dx = positions[1][0] - positions[0][0];
+    float dy = positions[1][1] - positions[0][1];
+    float dz = positions[1][2] - positions[0][2];
+    float edge_length = sqrtf(dx * dx + dy * dy + dz * dz);
+    int e = 0;
+    for (int i = 0; i < SOCCER_VERTICES; ++i) {
+        for (int j = i + 1; j < SOCCER_VERTICES && e < SOCCER_EDGES; ++j) {
+            dx = positions[j][0] - positions[i][0];
+            dy = positions[j][1] - positions[i][1];
+            dz = positions[j][2] - positions[i][2];
+            if (fabsf(sqrtf(dx * dx + dy * dy + dz * dz) - edge_length) < 0.0001f) set_edge(object, e++, i, j);
+        }
+    }
+    object->num_indices = 2 * e;
+    return object;
+}
+
+object3d_t *mesh_create_icosphere(int level) {
+    if (level < 0 || level > ICOSPHERE_MAX_LEVEL) return NULL;
+
+    static const int base_faces[20 * 3] = {
+        0, 11, 5,   0, 5, 1,    0, 1, 7,    0, 7, 10,   0, 10, 11,
+        1, 5, 9,    5, 11, 4,   11, 10, 2,  10, 7, 6,   7, 1, 8,
+        3, 9, 4,    3, 4, 2,    3, 2, 6,    3, 6, 8,    3, 8, 9,
+        4, 9, 5,    2, 4, 11,   6, 2, 10,   8, 6, 7,    9, 8, 1
+    };
+    int scale = 1 << (2 * level); // 4^level
+    int num_faces = 20 * scale;
+    object3d_t *object = object_alloc(10 * scale + 2, 30 * scale, num_faces);
+    int *scratch = level > 0 ? malloc(3 * (size_t)num_faces * sizeof(int)) : NULL;
+    if (!object || (level > 0 && !scratch)) {
+        object3d_destroy(object);
+        return NULL;
+    }
+
+    // Icosahedron on the unit sphere
+    const float t = 1.6180340f; // Golden ratio
+    const float base[12][3] = {
+        {-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+        {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+        {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}
+    };
+    float inv = 1.0f / sqrtf(1.0f + t * t);
+    for (int i = 0; i < 12; ++i) {
+        object->vertices[i] = cartesian_vertex(base[i][0] * inv, base[i][1] * inv, base[i][2] * inv);
+    }
+    object->num_vertices = 12;
+
+    // Ping-pong between the scratch buffer and object->faces so the last level lands in object->faces
+    int *src = (level % 2 == 0) ? object->faces : scratch;
+    int *dst = (level % 2 == 0) ? scratch : object->faces;
+    memcpy(src, base_faces, sizeof(base_faces));
+    int count = 20;
+    for (int l = 0; l < level; ++l) {
+        edge_map_t map;
+        if (!edge_map_init(&map, 3 * count / 2)) {
+            free(scratch);
+            object3d_destroy(object);
+            return NULL;
+        }
+        for (int f = 0; f < count; ++f) {
+            int a = src[3 * f], b = src[3 * f + 1], c = src[3 * f + 2];
+            int ab = icosphere_midpoint(object, &map, a, b);
+            int bc = icosphere_midpoint(object, &map, b, c);
+            int ca = icosphere_midpoint(object, &map, c, a);
+            int *out = dst + 12 * f;
+            out[0] = a;   out[1] = ab;  out[2] = ca;
+            out[3] = b;   out[4] = bc;  out[5] = ab;
+            out[6] = c;   out[7] = ca;  out[8] = bc;
+            out[9] = ab;  out[10] = bc; out[11] = ca;
+        }
+        edge_map_free(&map);
+        int *tmp = src;
+        src = dst;
+        dst = tmp;
+        count *= 4;
+    }
+    free(scratch);
+
+    // Closed and consistently wound: every edge is a -> b in one face and b -> a in its neighbour
+    int e = 0;
+    for (int k = 0; k < 3 * num_faces; ++k) {
+        int a = object->faces[k];
+        int b = object->faces[k % 3 == 2 ? k - 2 : k + 1];
+        if (a < b) set_edge(object, e++, a, b);
+    }
+    return object;
+}
+
+object3d_t *mesh_create_grid(int cols, int rows, float width, float depth) {
+    if (cols < 1 || rows < 1 || (int64_t)(cols + 1) * (rows + 1) > INT32_MAX / 6) return NULL;
+
+    int stride = cols + 1;
+    object3d_t *object = object_alloc(stride * (rows + 1), 2 * cols * rows + cols + rows, 2 * cols * rows);
+    if (!object) return NULL;
+
+    for (int j = 0; j <= rows; ++j) {
+        float z = depth * ((float)j / rows - 0.5f);
+        for (int i = 0; i <= cols; ++i) {
+            object->vertices[j * stride + i] = cartesian_vertex(width * ((float)i / cols - 0.5f), 0.0f, z);
+        }
+    }
+
+    int e = 0, f = 0;
+    for (int j = 0; j <= rows; ++j) {
+        for (int i = 0; i <= cols; ++i) {
+            int v = j * stride + i;
+            if (i < cols) set_edge(object, e++, v, v + 1);
+            if (j < rows) set_edge(object, e++, v, v + stride);
+            if (i < cols && j < rows) {
+                set_quad(object, f, v, v + stride, v + stride + 1, v + 1); // Counter-clockwise seen from +y
+                f += 2;
+            }
+        }
+    }
+    return object;
+}
+
+object3d_t *mesh_create_torus(int major_segments, int minor_segments, float major_radius, float minor_radius) {
+    if (major_segments < 3 || minor_segments < 3 || (int64_t)major_segments * minor_segments > INT32_MAX / 6) {
+        return NULL;
+    }
+
+    int n = major_segments * minor_segments;
+    object3d_t *object = object_alloc(n, 2 * n, 2 * n);
+    if (!object) return NULL;
+
+    for (int i = 0; i < major_segments; ++i) {
+        float u = 2.0f * (float)M_PI * i / major_segments;
+        float cu = cosf(u), su = sinf(u);
+        for (int j = 0; j < minor_segments; ++j) {
+            float v = 2.0f * (float)M_PI * j / minor_segments;
+            float ring = major_radius + minor_radius * cosf(v);
+            object->vertices[i * minor_segments + j] = cartesian_vertex(ring * cu, minor_radius * sinf(v), ring * su);
+        }
+    }
+
+    int e = 0, f = 0;
+    for (int i = 0; i < major_segments; ++i) {
+        int next_i = (i + 1) % major_segments;
+        for (int j = 0; j < minor_segments; ++j) {
+            int next_j = (j + 1) % minor_segments;
+            int a = i * minor_segments + j;
+            int b = i * minor_segments + next_j;
+            int c = next_i * minor_segments + next_j;
+            int d = next_i * minor_segments + j;
+            set_edge(object, e++, a, b); // Around the tube
+            set_edge(object, e++, a, d); // Around the axis
+            set_quad(object, f, a, b, c, d);
+            f += 2;
+        }
+    }
+    return object;
+}
+
+object3d_t *mesh_create_cylinder(int segments, int stacks, float radius, float height, bool capped) {
+    if (segments < 3 || stacks < 1 || (int64_t)segments * (stacks + 1) > INT32_MAX / 6) return NULL;
+
+    int ring_vertices = segments * (stacks + 1);
+    int num_edges = segments * (2 * stacks + 1) + (capped ? 2 * segments : 0);
+    int num_faces = 2 * segments * stacks + (capped ? 2 * segments : 0);
+    object3d_t *object = object_alloc(ring_vertices + (capped ? 2 : 0), num_edges, num_faces);
+    if (!object) return NULL;
+
+    for (int s = 0; s < segments; ++s) {
+        float a = 2.0f * (float)M_PI * s / segments;
+        float x = radius * cosf(a), z = radius * sinf(a);
+        for (int k = 0; k <= stacks; ++k) {
+            object->vertices[k * segments + s] = cartesian_vertex(x, height * ((float)k / stacks - 0.5f), z);
+        }
+    }
+
+    int e = 0, f = 0;
+    for (int k = 0; k <= stacks; ++k) {
+        for (int s = 0; s < segments; ++s) {
+            int v = k * segments + s;
+            int next = k * segments + (s + 1) % segments;
+            set_edge(object, e++, v, next); // Ring
+            if (k < stacks) {
+                set_edge(object, e++, v, v + segments); // Side
+                set_quad(object, f, v, v + segments, next + segments, next);
+                f += 2;
+            }
+        }
+    }
+
+    if (capped) {
+        int bottom = ring_vertices, top = ring_vertices + 1;
+        int top_ring = stacks * segments;
+        object->vertices[bottom] = cartesian_vertex(0.0f, -0.5f * height, 0.0f);
+        object->vertices[top] = cartesian_vertex(0.0f, 0.5f * height, 0.0f);
+        for (int s = 0; s < segments; ++s) {
+            int next = (s + 1) % segments;
+            set_edge(object, e++, bottom, s);
+            set_edge(object, e++, top, top_ring + s);
+            set_face(object, f++, bottom, s, next);
+            set_face(object, f++, top, top_ring + next, top_ring + s);
+        }
+    }
+    return object;
+}
+
+object3d_t *mesh_create_random_lines(int num_lines, float extent, float max_length, uint32_t seed) {
+    if (num_lines < 1 || num_lines > INT32_MAX / 4) return NULL;
+
+    object3d_t *object = object_alloc(2 * num_lines, num_lines, 0);
+    if (!object) return NULL;
+
+    // xorshift32 (a zero state would stay zero)
+    uint32_t state = seed ? seed : 0x9e3779b9u;
+    float p[6];
+    for (int i = 0; i < num_lines; ++i) {
+        for (int k = 0; k < 6; ++k) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            p[k] = (state >> 8) * (2.0f / 16777216.0f) - 1.0f; // [-1, 1)
+        }
+        float x = p[0] * extent, y = p[1] * extent, z = p[2] * extent;
+        object->vertices[2 * i] = cartesian_vertex(x, y, z);
+        object->vertices[2 * i + 1] = cartesian_vertex(x + p[3] * max_length * 0.57735027f,
+                                                       y + p[4] * max_length * 0.57735027f,
+                                                       z + p[5] * max_length * 0.57735027f);
+        set_edge(object, i, 2 * i, 2 * i + 1);
+    }
+    return object;
+}
+
+void object3d_destroy(object3d_t *object) {
+    if (object == NULL) return;
+    free(object->vertices);
+    free(object->indices);
+    free(object->faces);
+    free(object->edge_faces);
+    free(object->edge_dirs);
+    free(object);
+}
\ No newline at end of file
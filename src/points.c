@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <float.h>
+#include "tiny3d.h"
+#include "points.h"
+
+// Points transformed per batch, small enough for the scratch arrays to stay in cache
+#define POINT_BATCH 1024
+
+// Sub-pixel positions per axis that get their own footprint kernel
+#define KERNEL_PHASES 4
+
+// Coverage samples per pixel axis used when building disc footprints
+#define KERNEL_SUPERSAMPLES 4
+
+// Fixed-point weight of a fully covered pixel
+#define KERNEL_WEIGHT_ONE 256
+
+// Screen bins are (1 << BIN_TILE_SHIFT) pixels square
+#define BIN_TILE_SHIFT 6
+
+// Same near-plane epsilon as the wireframe renderer
+#define W_CLIP_EPSILON FLT_EPSILON * 100.0f
+
+// Precomputed footprints for one point size, one kernel per sub-pixel phase
+typedef struct {
+    int size;            // Kernels are size x size pixels
+    int offset;          // Kernel pixel 0 sits at floor(center) - offset
+    uint16_t *weights;   // KERNEL_PHASES * KERNEL_PHASES kernels, row-major
+} footprint_set_t;
+
+// Screen positions of the points that survived projection
+typedef struct {
+    float *x;
+    float *y;
+    int count;
+} splat_list_t;
+
+// Build the footprint kernels for a point diameter (bilinear for points up to one pixel)
+static bool build_footprints(footprint_set_t *fp, float point_size) {
+    float radius = 0.5f * point_size;
+    bool bilinear = point_size <= 1.0f;
+    fp->offset = bilinear ? 0 : (int)ceilf(radius);
+    fp->size = bilinear ? 2 : 2 * fp->offset + 2;
+
+    int kernel_len = fp->size * fp->size;
+    fp->weights = malloc(KERNEL_PHASES * KERNEL_PHASES * kernel_len * sizeof(uint16_t));
+    if (!fp->weights) return false;
+
+    for (int py = 0; py < KERNEL_PHASES; ++py) {
+        for (int px = 0; px < KERNEL_PHASES; ++px) {
+            // Representative sub-pixel position of this phase
+            float fx = (px + 0.5f) / KERNEL_PHASES;
+            float fy = (py + 0.5f) / KERNEL_PHASES;
+            uint16_t *k = fp->weights + (py * KERNEL_PHASES + px) * kernel_len;
+
+            for (int j = 0; j < fp->size; ++j) {
+                for (int i = 0; i < fp->size; ++i) {
+                    // Pixel center relative to the point center (pixel centers on integers, as in set_pixel_f)
+                    float dx = (i - fp->offset) - fx;
+                    float dy = (j - fp->offset) - fy;
+                    float coverage;
+
+                    if (bilinear) {
+                        coverage = fmaxf(0.0f, 1.0f - fabsf(dx)) * fmaxf(0.0f, 1.0f - fabsf(dy));
+                    } else {
+                        int inside = 0;
+                        for (int sy = 0; sy < KERNEL_SUPERSAMPLES; ++sy) {
+                            for (int sx = 0; sx < KERNEL_SUPERSAMPLES; ++sx) {
+                                float ox = dx - 0.5f + (sx + 0.5f) / KERNEL_SUPERSAMPLES;
+                                float oy = dy - 0.5f + (sy + 0.5f) / KERNEL_SUPERSAMPLES;
+                                inside += (ox * ox + oy * oy) <= radius * radius;
+                            }
+                        }
+                        coverage = (float)inside / (KERNEL_SUPERSAMPLES * KERNEL_SUPERSAMPLES);
+                    }
+                    k[j * fp->size + i] = (uint16_t)lrintf(coverage * KERNEL_WEIGHT_ONE);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Add one footprint to the canvas, clipped to the canvas and its circular viewport
+static void splat_point(canvas_t *canvas, const footprint_set_t *fp, float x, float y, color_t color) {
+    int ix = (int)floorf(x);
+    int iy = (int)floorf(y);
+    int phase_x = (int)((x - ix) * KERNEL_PHASES);
+    int phase_y = (int)((y - iy) * KERNEL_PHASES);
+    if (phase_x >= KERNEL_PHASES) phase_x = KERNEL_PHASES - 1;
+    if (phase_y >= KERNEL_PHASES) phase_y = KERNEL_PHASES - 1;
+    const uint16_t *k = fp->weights + (phase_y * KERNEL_PHASES + phase_x) * fp->size * fp->size;
+
+    int x0 = ix - fp->offset;
+    int y0 = iy - fp->offset;
+    int written = 0;
+    for (int j = 0; j < fp->size; ++j) {
+        int py = y0 + j;
+        int lo, hi;
+        if (!canvas_row_viewport(canvas, py, &lo, &hi)) continue;
+
+        int i_start = lo - x0 > 0 ? lo - x0 : 0;
+        int i_end = hi - x0 < fp->size - 1 ? hi - x0 : fp->size - 1;
+        color_t *row = canvas->pixels[py];
+        const uint16_t *w = k + j * fp->size;
+        for (int i = i_start; i <= i_end; ++i) {
+            if (w[i] == 0) continue;
+            color_t *dst = &row[x0 + i];
+            int r = dst->r + ((color.r * w[i]) >> 8);
+            int g = dst->g + ((color.g * w[i]) >> 8);
+            int b = dst->b + ((color.b * w[i]) >> 8);
+            dst->r = (unsigned char)(r > 255 ? 255 : r);
+            dst->g = (unsigned char)(g > 255 ? 255 : g);
+            dst->b = (unsigned char)(b > 255 ? 255 : b);
+            written++;
+        }
+    }
+    STATS_ADD(canvas->stats, pixels_written, (uint64_t)written);
+}
+
+// Project one batch to screen space and append the visible points to the list
+static void project_batch(const float *x, const float *y, const float *z, int n, const mat4 *mvp,
+                          const canvas_t *canvas, float margin, splat_list_t *out) {
+    float sx[POINT_BATCH], sy[POINT_BATCH], sw[POINT_BATCH];
+    const float *m = mvp->m;
+    float half_w = 0.5f * canvas->width;
+    float half_h = 0.5f * canvas->height;
+
+    // Branch-free transform so the compiler can vectorize it
+    for (int i = 0; i < n; ++i) {
+        float cx = m[0] * x[i] + m[4] * y[i] + m[8] * z[i] + m[12];
+        float cy = m[1] * x[i] + m[5] * y[i] + m[9] * z[i] + m[13];
+        float cw = m[3] * x[i] + m[7] * y[i] + m[11] * z[i] + m[15];
+        float inv_w = 1.0f / cw;
+        sx[i] = (cx * inv_w + 1.0f) * half_w;
+        sy[i] = (1.0f - cy * inv_w) * half_h; // Invert Y-axis for screen coordinates (Y-down)
+        sw[i] = cw;
+    }
+
+    // Keep points in front of the near plane whose footprint can touch the canvas
+    for (int i = 0; i < n; ++i) {
+        if (!(sw[i] > W_CLIP_EPSILON)) continue;
+        if (!(sx[i] > -margin && sx[i] < canvas->width + margin &&
+              sy[i] > -margin && sy[i] < canvas->height + margin)) continue;
+        out->x[out->count] = sx[i];
+        out->y[out->count] = sy[i];
+        out->count++;
+    }
+}
+
+// Reorder the splats so each screen tile is drawn in one go (counting sort, O(n))
+static bool bin_splats(const canvas_t *canvas, splat_list_t *list) {
+    int tiles_x = (canvas->width >> BIN_TILE_SHIFT) + 1;
+    int tiles_y = (canvas->height >> BIN_TILE_SHIFT) + 1;
+    int num_tiles = tiles_x * tiles_y;
+
+    int *offsets = calloc(num_tiles + 1, sizeof(int));
+    int *tile_of = malloc(list->count * sizeof(int));
+    float *sorted = malloc(2 * list->count * sizeof(float));
+    if (!offsets || !tile_of || !sorted) {
+        free(offsets);
+        free(tile_of);
+        free(sorted);
+        return false;
+    }
+
+    for (int i = 0; i < list->count; ++i) {
+        int tx = (int)list->x[i] >> BIN_TILE_SHIFT;
+        int ty = (int)list->y[i] >> BIN_TILE_SHIFT;
+        tx = tx < 0 ? 0 : (tx >= tiles_x ? tiles_x - 1 : tx);
+        ty = ty < 0 ? 0 : (ty >= tiles_y ? tiles_y - 1 : ty);
+        tile_of[i] = ty * tiles_x + tx;
+        offsets[tile_of[i] + 1]++;
+    }
+    for (int t = 0; t < num_tiles; ++t) {
+        offsets[t + 1] += offsets[t];
+    }
+
+    float *sorted_x = sorted;
+    float *sorted_y = sorted + list->count;
+    for (int i = 0; i < list->count; ++i) {
+        int dst = offsets[tile_of[i]]++;
+        sorted_x[dst] = list->x[i];
+        sorted_y[dst] = list->y[i];
+    }
+    for (int i = 0; i < list->count; ++i) {
+        list->x[i] = sorted_x[i];
+        list->y[i] = sorted_y[i];
+    }
+
+    free(offsets);
+    free(tile_of);
+    free(sorted);
+    return true;
+}
+
+// Render a point cloud with sized, anti-aliased splats
+void render_point_cloud(render_context_t *ctx, canvas_t *canvas, const point_cloud_t *cloud, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float point_size, color_t color) {
+    if (ctx == NULL || canvas == NULL || cloud == NULL || cloud->x == NULL || cloud->y == NULL || cloud->z == NULL || cloud->count <= 0) {
+        return;
+    }
+
+    footprint_set_t fp;
+    if (!build_footprints(&fp, point_size)) {
+        perror("Failed to allocate point footprints");
+        return;
+    }
+
+    // Binning needs every splat up front, otherwise one batch is splatted at a time
+    int capacity = ctx->bin_points ? cloud->count : POINT_BATCH;
+    splat_list_t list;
+    list.count = 0;
+    list.x = malloc(2 * capacity * sizeof(float));
+    if (!list.x) {
+        perror("Failed to allocate point splats");
+        free(fp.weights);
+        return;
+    }
+    list.y = list.x + capacity;
+
+    mat4 mvp = mat4_mul(projection_matrix, mat4_mul(view_matrix, model_matrix));
+    float margin = (float)(fp.offset + 1);
+
+    for (int base = 0; base < cloud->count; base += POINT_BATCH) {
+        int n = cloud->count - base < POINT_BATCH ? cloud->count - base : POINT_BATCH;
+        STATS_BEGIN(ctx->stats, project_start);
+        project_batch(cloud->x + base, cloud->y + base, cloud->z + base, n, &mvp, canvas, margin, &list);
+        STATS_END(ctx->stats, STAGE_PROJECT, project_start);
+        STATS_ADD(ctx->stats, vertices_transformed, (uint64_t)n);
+
+        if (!ctx->bin_points) {
+            STATS_BEGIN(ctx->stats, raster_start);
+            for (int i = 0; i < list.count; ++i) {
+                splat_point(canvas, &fp, list.x[i], list.y[i], color);
+            }
+            STATS_END(ctx->stats, STAGE_RASTER, raster_start);
+            STATS_ADD(ctx->stats, points_drawn, (uint64_t)list.count);
+            list.count = 0;
+        }
+    }
+
+    if (ctx->bin_points) {
+        STATS_BEGIN(ctx->stats, sort_start);
+        bin_splats(canvas, &list); // Falls back to submission order if it cannot allocate
+        STATS_END(ctx->stats, STAGE_SORT, sort_start);
+        STATS_BEGIN(ctx->stats, raster_start);
+        for (int i = 0; i < list.count; ++i) {
+            splat_point(canvas, &fp, list.x[i], list.y[i], color);
+        }
+        STATS_END(ctx->stats, STAGE_RASTER, raster_start);
+        STATS_ADD(ctx->stats, points_drawn, (uint64_t)list.count);
+    }
+
+    free(list.x);
+    free(fp.weights);
+}
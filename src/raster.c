@@ -0,0 +1,236 @@
+#include <math.h>
+#include <stdbool.h>
+#include "tiny3d.h"
+#include "raster.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Tiles are TILE_SIZE x TILE_SIZE pixels, tested against the edges as a whole first
+#define TILE_SIZE 8
+
+// Pixels shaded per inner-loop step
+#define BLOCK_WIDTH 4
+
+// Half-space edge function E(x, y) = a * x + b * y + c, positive inside the triangle
+typedef struct {
+    float a, b, c;
+    bool top_left;   // Pixels exactly on a top or left edge belong to this triangle
+} edge_fn_t;
+
+// Attribute plane v(x, y) = a * x + b * y + c
+typedef struct {
+    float a, b, c;
+} plane_t;
+
+// Triangle setup shared by every tile
+typedef struct {
+    edge_fn_t edges[3];
+    plane_t depth;
+    plane_t intensity;
+    color_t color;
+} triangle_setup_t;
+
+// Edge from p to q. c is computed as a single cross term so a shared edge walked in
+// the opposite direction gives exactly the negated function (no cracks, no double hits).
+static edge_fn_t make_edge(const raster_vertex_t *p, const raster_vertex_t *q) {
+    edge_fn_t e;
+    e.a = p->y - q->y;
+    e.b = q->x - p->x;
+    e.c = p->x * q->y - p->y * q->x;
+    float dy = q->y - p->y;
+    float dx = q->x - p->x;
+    e.top_left = (dy < 0.0f) || (dy == 0.0f && dx > 0.0f);
+    return e;
+}
+
+// Plane through the three vertex attribute values, using the edge functions as barycentrics
+static plane_t make_plane(const edge_fn_t *edges, float area, float v0, float v1, float v2) {
+    // edges[0] is opposite v0, edges[1] opposite v1, edges[2] opposite v2
+    float inv_area = 1.0f / area;
+    plane_t p;
+    p.a = (edges[0].a * v0 + edges[1].a * v1 + edges[2].a * v2) * inv_area;
+    p.b = (edges[0].b * v0 + edges[1].b * v1 + edges[2].b * v2) * inv_area;
+    p.c = (edges[0].c * v0 + edges[1].c * v1 + edges[2].c * v2) * inv_area;
+    return p;
+}
+
+// Check whether the edge is positive anywhere / everywhere over a tile
+static void tile_edge_range(const edge_fn_t *e, float x0, float y0, float x1, float y1, float *e_min, float *e_max) {
+    float ax0 = e->a * x0, ax1 = e->a * x1;
+    float by0 = e->b * y0, by1 = e->b * y1;
+    *e_min = fminf(ax0, ax1) + fminf(by0, by1) + e->c;
+    *e_max = fmaxf(ax0, ax1) + fmaxf(by0, by1) + e->c;
+}
+
+// Write a shaded pixel
+static void write_pixel(color_t *dst, color_t color, float intensity) {
+    intensity = fmaxf(0.0f, fminf(1.0f, intensity));
+    dst->r = (unsigned char)(color.r * intensity);
+    dst->g = (unsigned char)(color.g * intensity);
+    dst->b = (unsigned char)(color.b * intensity);
+}
+
+#if defined(__SSE2__)
+
+// Inside mask of one edge for 4 pixels, honoring the top-left rule
+static inline __m128 edge_mask4(const edge_fn_t *e, __m128 xs, float row) {
+    __m128 v = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e->a), xs), _mm_set1_ps(row));
+    return e->top_left ? _mm_cmpge_ps(v, _mm_setzero_ps()) : _mm_cmpgt_ps(v, _mm_setzero_ps());
+}
+
+// Shade pixels [x, x + 4) of one row, keeping only lanes inside [x_lo, x_hi]
+static void shade_block4(canvas_t *canvas, const triangle_setup_t *t, int x, int y, int x_lo, int x_hi, bool full) {
+    const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    __m128 xi = _mm_add_ps(_mm_set1_ps((float)x), lane);
+    __m128 xs = _mm_add_ps(xi, _mm_set1_ps(0.5f));
+    float py = y + 0.5f;
+
+    // Lanes inside the span
+    __m128 mask = _mm_and_ps(_mm_cmpge_ps(xi, _mm_set1_ps((float)x_lo)),
+                             _mm_cmple_ps(xi, _mm_set1_ps((float)x_hi)));
+
+    // Edge tests are skipped for tiles fully inside the triangle
+    if (!full) {
+        for (int k = 0; k < 3; ++k) {
+            const edge_fn_t *e = &t->edges[k];
+            mask = _mm_and_ps(mask, edge_mask4(e, xs, e->b * py + e->c));
+        }
+    }
+    if (_mm_movemask_ps(mask) == 0) return;
+
+    // Interpolated depth and intensity
+    __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t->depth.a), xs), _mm_set1_ps(t->depth.b * py + t->depth.c));
+    __m128 shade = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t->intensity.a), xs), _mm_set1_ps(t->intensity.b * py + t->intensity.c));
+
+    // Depth test and write
+    if (canvas->depth) {
+        float *depth_row = canvas->depth + y * canvas->width + x;
+        __m128 d = _mm_loadu_ps(depth_row);
+        mask = _mm_and_ps(mask, _mm_cmplt_ps(z, d));
+        _mm_storeu_ps(depth_row, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, d)));
+    }
+
+    int bits = _mm_movemask_ps(mask);
+    if (bits == 0) return;
+
+    float shades[BLOCK_WIDTH];
+    _mm_storeu_ps(shades, shade);
+    color_t *row = canvas->pixels[y];
+    for (int i = 0; i < BLOCK_WIDTH; ++i) {
+        if (bits & (1 << i)) write_pixel(&row[x + i], t->color, shades[i]);
+    }
+    STATS_ADD(canvas->stats, pixels_written, (uint64_t)__builtin_popcount(bits));
+}
+
+#else
+
+// Inside test of one edge for one pixel, honoring the top-left rule
+static inline bool edge_inside(const edge_fn_t *e, float px, float row) {
+    float v = e->a * px + row;
+    return e->top_left ? v >= 0.0f : v > 0.0f;
+}
+
+// Scalar fallback with the same arithmetic as the SSE2 path
+static void shade_block4(canvas_t *canvas, const triangle_setup_t *t, int x, int y, int x_lo, int x_hi, bool full) {
+    float py = y + 0.5f;
+    float rows[3];
+    for (int k = 0; k < 3; ++k) rows[k] = t->edges[k].b * py + t->edges[k].c;
+    float z_row = t->depth.b * py + t->depth.c;
+    float shade_row = t->intensity.b * py + t->intensity.c;
+
+    for (int i = 0; i < BLOCK_WIDTH; ++i) {
+        int px = x + i;
+        if (px < x_lo || px > x_hi) continue;
+        float xs = (float)px + 0.5f;
+        if (!full && !(edge_inside(&t->edges[0], xs, rows[0]) &&
+                       edge_inside(&t->edges[1], xs, rows[1]) &&
+                       edge_inside(&t->edges[2], xs, rows[2]))) {
+            continue;
+        }
+
+        float z = t->depth.a * xs + z_row;
+        if (canvas->depth) {
+            float *d = canvas->depth + y * canvas->width + px;
+            if (!(z < *d)) continue;
+            *d = z;
+        }
+        write_pixel(&canvas->pixels[y][px], t->color, t->intensity.a * xs + shade_row);
+        STATS_ADD(canvas->stats, pixels_written, 1);
+    }
+}
+
+#endif
+
+// Fill a triangle with tiled half-space edge functions
+void draw_triangle_f(canvas_t *canvas, const raster_vertex_t *v0, const raster_vertex_t *v1, const raster_vertex_t *v2, color_t color) {
+    if (canvas == NULL || v0 == NULL || v1 == NULL || v2 == NULL) return;
+
+    // Orient the triangle so the edge functions are positive inside
+    float area = (v1->x - v0->x) * (v2->y - v0->y) - (v1->y - v0->y) * (v2->x - v0->x);
+    if (!(fabsf(area) > 0.0f)) return; // Degenerate (or NaN) triangle
+    if (area < 0.0f) {
+        const raster_vertex_t *tmp = v1;
+        v1 = v2;
+        v2 = tmp;
+        area = -area;
+    }
+
+    triangle_setup_t t;
+    t.edges[0] = make_edge(v1, v2);
+    t.edges[1] = make_edge(v2, v0);
+    t.edges[2] = make_edge(v0, v1);
+    t.depth = make_plane(t.edges, area, v0->z, v1->z, v2->z);
+    t.intensity = make_plane(t.edges, area, v0->intensity, v1->intensity, v2->intensity);
+    t.color = color;
+
+    // Bounding box clipped to the canvas
+    int min_x = (int)floorf(fminf(v0->x, fminf(v1->x, v2->x)));
+    int max_x = (int)ceilf(fmaxf(v0->x, fmaxf(v1->x, v2->x)));
+    int min_y = (int)floorf(fminf(v0->y, fminf(v1->y, v2->y)));
+    int max_y = (int)ceilf(fmaxf(v0->y, fmaxf(v1->y, v2->y)));
+    if (min_x < 0) min_x = 0;
+    if (min_y < 0) min_y = 0;
+    if (max_x > canvas->width - 1) max_x = canvas->width - 1;
+    if (max_y > canvas->height - 1) max_y = canvas->height - 1;
+    if (min_x > max_x || min_y > max_y) return;
+
+    // Walk the bounding box tile by tile
+    for (int ty = min_y & ~(TILE_SIZE - 1); ty <= max_y; ty += TILE_SIZE) {
+        for (int tx = min_x & ~(TILE_SIZE - 1); tx <= max_x; tx += TILE_SIZE) {
+
+            // Classify the tile against each edge using the pixel centers at its corners
+            float cx0 = tx + 0.5f, cy0 = ty + 0.5f;
+            float cx1 = tx + TILE_SIZE - 0.5f, cy1 = ty + TILE_SIZE - 0.5f;
+            bool full = true;
+            bool empty = false;
+            for (int k = 0; k < 3; ++k) {
+                float e_min, e_max;
+                tile_edge_range(&t.edges[k], cx0, cy0, cx1, cy1, &e_min, &e_max);
+                if (e_max < 0.0f) {
+                    empty = true;
+                    break;
+                }
+                if (!(e_min > 0.0f)) full = false;
+            }
+            if (empty) continue;
+
+            int y_end = ty + TILE_SIZE - 1 < max_y ? ty + TILE_SIZE - 1 : max_y;
+            for (int y = ty > min_y ? ty : min_y; y <= y_end; ++y) {
+                int span_lo, span_hi;
+                if (!canvas_row_viewport(canvas, y, &span_lo, &span_hi)) continue;
+                int x_lo = tx > min_x ? tx : min_x;
+                int x_hi = tx + TILE_SIZE - 1 < max_x ? tx + TILE_SIZE - 1 : max_x;
+                if (x_lo < span_lo) x_lo = span_lo;
+                if (x_hi > span_hi) x_hi = span_hi;
+                if (x_lo > x_hi) continue;
+
+                for (int x = tx; x <= x_hi; x += BLOCK_WIDTH) {
+                    if (x + BLOCK_WIDTH - 1 < x_lo) continue;
+                    shade_block4(canvas, &t, x, y, x_lo, x_hi, full);
+                }
+            }
+        }
+    }
+}
@@ -2,9 +2,13 @@
 #include <stdlib.h>
 #include <math.h>
 #include <float.h> 
+#include <stdint.h>
+#include <string.h>
 #include "tiny3d.h"
-
-#define LIGHT_BOOST_EXPONENT 0.5f
+#include "raster.h"
+#if TINY3D_THREADS
+#include <pthread.h>
+#endif
 
 // Define a small epsilon for floating-point comparisons to avoid division by zero or near-zero w
 #define W_CLIP_EPSILON FLT_EPSILON * 100.0f // A slightly larger epsilon for robustness
@@ -25,14 +29,6 @@ vec4 project_vertex(vec3 vertex, mat4 model_matrix, mat4 view_matrix, mat4 proje
     return v_clip_homogeneous;
 }
 
-// Structure to hold line data for depth sorting
-typedef struct {
-    vec3 start_screen;
-    vec3 end_screen;
-    float average_z; // Average Z of the two projected vertices for sorting
-    color_t color;   // Store color for the line
-} render_line_t;
-
 // Comparison function for qsort to sort lines by average Z (back to front)
 int compare_render_lines(const void *a, const void *b) {
     render_line_t *line_a = (render_line_t *)a;
@@ -47,37 +43,197 @@ int compare_render_lines(const void *a, const void *b) {
     }
 }
 
-// render_wireframe now accepts light_dirs and num_lights
-void render_wireframe(canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, vec3* light_dirs, int num_lights) {
-    if (canvas == NULL || object == NULL || object->vertices == NULL || object->indices == NULL) {
-        return;
+// Vertex and index source shared by the object3d_t and compact_mesh_t paths
+typedef struct {
+    const vec3* vertices;                 // object3d_t positions (NULL for compact meshes)
+    const void* positions;                // Packed compact positions
+    mesh_position_format_t position_format;
+    int num_vertices;
+    const void* indices;
+    int index_size;                       // 2 for uint16_t indices, 4 for int/uint32_t indices
+    int num_indices;
+    const int* faces;                     // Optional triangles for edge culling
+    int num_faces;
+    const int* edge_faces;                // Optional edge -> face adjacency
+    const float* edge_dirs;               // Optional cached unit edge directions in object space
+} mesh_source_t;
+
+// Lights for one wireframe draw: plain direction vectors, or light objects culled through a tile grid
+typedef struct {
+    vec3* light_dirs;
+    int num_lights;
+    const light_grid_t *grid;             // Light objects (NULL when using light_dirs)
+    const float *edge_dirs;               // Unit object-space edge directions, light_dirs then in object space (NULL: world space)
+    const unsigned char *edge_gray;       // Gray level of every edge, already lit (multi-view), or NULL
+} edge_lights_t;
+
+// Fetch the i-th edge index regardless of its storage width
+static inline int source_index(const mesh_source_t *src, int i) {
+    if (src->index_size == 2) {
+        return ((const uint16_t *)src->indices)[i];
     }
+    return ((const int *)src->indices)[i];
+}
 
-    // Allocate memory to store projected lines for sorting
-    render_line_t *lines_to_render = malloc(object->num_indices / 2 * sizeof(render_line_t));
-    if (lines_to_render == NULL) {
-        perror("Failed to allocate memory for lines_to_render");
-        return;
+// Object-space position of the i-th vertex regardless of its storage format
+static inline vec4 source_position(const mesh_source_t *src, int i) {
+    if (src->vertices != NULL) {
+        return vec4_from_vec3(src->vertices[i], 1.0f);
+    } else if (src->position_format == MESH_POSITIONS_QUANT16) {
+        const int16_t *q = (const int16_t *)src->positions + 3 * i;
+        return (vec4){q[0], q[1], q[2], 1.0f};
+    }
+    const float *p = (const float *)src->positions + 3 * i;
+    return (vec4){p[0], p[1], p[2], 1.0f};
+}
+
+// Transform every vertex straight to clip space when no world positions are needed
+static void transform_source_clip(const mesh_source_t *src, mat4 model_view_projection, vec4 *clip, render_stats_t *stats) {
+    STATS_BEGIN(stats, start);
+    for (int i = 0; i < src->num_vertices; ++i) {
+        clip[i] = mat4_mul_vec4(model_view_projection, source_position(src, i));
+    }
+    STATS_ADD(stats, vertices_transformed, (uint64_t)src->num_vertices);
+    STATS_END(stats, STAGE_TRANSFORM, start);
+}
+
+// Transform every vertex once to world space (for lighting) and clip space (for projection)
+static void transform_source_vertices(const mesh_source_t *src, mat4 model_matrix, mat4 view_projection, float *world, vec4 *clip, render_stats_t *stats) {
+    STATS_BEGIN(stats, start);
+    for (int i = 0; i < src->num_vertices; ++i) {
+        vec4 v_world = mat4_mul_vec4(model_matrix, source_position(src, i));
+        world[3 * i + 0] = v_world.x;
+        world[3 * i + 1] = v_world.y;
+        world[3 * i + 2] = v_world.z;
+        clip[i] = mat4_mul_vec4(view_projection, v_world);
+    }
+    STATS_ADD(stats, vertices_transformed, (uint64_t)src->num_vertices);
+    STATS_END(stats, STAGE_TRANSFORM, start);
+}
+
+// Mark the faces whose projected triangle winds counter-clockwise (towards the camera).
+// Faces touching the near plane are treated as front-facing so their edges are kept.
+static void classify_faces(const mesh_source_t *src, const vec4 *clip, unsigned char *front) {
+    for (int f = 0; f < src->num_faces; ++f) {
+        const int *tri = src->faces + 3 * f;
+        if (tri[0] < 0 || tri[0] >= src->num_vertices ||
+            tri[1] < 0 || tri[1] >= src->num_vertices ||
+            tri[2] < 0 || tri[2] >= src->num_vertices) {
+            front[f] = 1;
+            continue;
+        }
+
+        vec4 a = clip[tri[0]];
+        vec4 b = clip[tri[1]];
+        vec4 c = clip[tri[2]];
+        if (a.w <= W_CLIP_EPSILON || b.w <= W_CLIP_EPSILON || c.w <= W_CLIP_EPSILON) {
+            front[f] = 1;
+            continue;
+        }
+
+        // Signed area in NDC (Y up)
+        float ax = a.x / a.w, ay = a.y / a.w;
+        float bx = b.x / b.w, by = b.y / b.w;
+        float cx = c.x / c.w, cy = c.y / c.w;
+        float area = (bx - ax) * (cy - ay) - (cx - ax) * (by - ay);
+        front[f] = area > 0.0f;
+    }
+}
+
+// Decide whether an edge survives the context's culling mode
+static bool edge_visible(edge_cull_mode_t mode, const mesh_source_t *src, const unsigned char *front, int edge) {
+    int f0 = src->edge_faces[2 * edge];
+    int f1 = src->edge_faces[2 * edge + 1];
+    bool has0 = f0 >= 0 && f0 < src->num_faces;
+    bool has1 = f1 >= 0 && f1 < src->num_faces;
+
+    // Edges without adjacent faces are always drawn
+    if (!has0 && !has1) return true;
+
+    int front_count = (has0 && front[f0]) + (has1 && front[f1]);
+    if (mode == EDGE_CULL_BACKFACE) {
+        return front_count > 0;
+    }
+
+    // Silhouette: one side towards the camera, the other away (or a front-facing open boundary)
+    return front_count == 1;
+}
+
+// Set the renderer defaults
+void render_context_init(render_context_t *ctx) {
+    if (ctx == NULL) return;
+    memset(ctx, 0, sizeof(*ctx)); // Zero padding too, so contexts can be compared with memcmp
+    ctx->cull_mode = EDGE_CULL_NONE;
+    ctx->shade_mode = SHADE_FLAT;
+    ctx->double_sided = false;
+    ctx->edge_overlay = false;
+    ctx->fill_color = (color_t){255, 255, 255};
+    ctx->bin_points = false;
+    ctx->ambient = 0.0f;
+    ctx->fog_mode = FOG_NONE;
+    ctx->fog_start = 0.0f;
+    ctx->fog_end = 0.0f;
+    ctx->fog_density = 0.0f;
+    ctx->stats = NULL;
+}
+
+// Light and depth-sort the edges of already transformed vertices.
+// lines_to_render needs room for num_indices / 2 lines. Returns the number of lines kept.
+static int build_source_lines(render_context_t *ctx, canvas_t *canvas, const mesh_source_t *src, const float *world, const vec4 *clip, const edge_lights_t *lights, render_line_t *lines_to_render) {
+    // Classify faces once so culled edges skip lighting, sorting and rasterization
+    unsigned char *front_faces = NULL;
+    bool cull_edges = ctx->cull_mode != EDGE_CULL_NONE && src->faces != NULL && src->edge_faces != NULL && src->num_faces > 0;
+    if (cull_edges) {
+        front_faces = malloc(src->num_faces);
+        if (front_faces == NULL) {
+            cull_edges = false; // Fall back to drawing every edge
+        } else {
+            STATS_BEGIN(ctx->stats, cull_start);
+            classify_faces(src, clip, front_faces);
+            STATS_END(ctx->stats, STAGE_CULL, cull_start);
+        }
+    }
+
+    // Lighting scratch: edge directions (structure-of-arrays), eye depths for fog and resulting gray levels.
+    // Light objects also need each edge's world midpoint and screen tile.
+    int max_lines = src->num_indices / 2;
+    int lanes = lights->grid != NULL ? 8 : 4;
+    float *dir_x = malloc((max_lines > 0 ? max_lines : 1) * (lanes * sizeof(float) + 1));
+    if (dir_x == NULL) {
+        perror("Failed to allocate memory for edge lighting");
+        free(front_faces);
+        return 0;
     }
+    float *dir_y = dir_x + max_lines;
+    float *dir_z = dir_y + max_lines;
+    float *depth = dir_z + max_lines;
+    float *mid_x = depth + max_lines;
+    float *mid_y = mid_x + max_lines;
+    float *mid_z = mid_y + max_lines;
+    int *tiles = (int *)(mid_z + max_lines);
+    unsigned char *gray = (unsigned char *)(dir_x + lanes * max_lines);
+
     int line_count = 0;
+    float fog_cutoff = fog_max_distance(ctx->fog_mode, ctx->fog_start, ctx->fog_end, ctx->fog_density);
 
-    // Project all vertices and store lines
-    for (int i = 0; i < object->num_indices; i += 2) {
-        int v_idx0 = object->indices[i];
-        int v_idx1 = object->indices[i + 1];
+    // Build lines from the edge list
+    STATS_BEGIN(ctx->stats, project_start);
+    for (int i = 0; i + 1 < src->num_indices; i += 2) {
+        int v_idx0 = source_index(src, i);
+        int v_idx1 = source_index(src, i + 1);
 
-        if (v_idx0 < 0 || v_idx0 >= object->num_vertices ||
-            v_idx1 < 0 || v_idx1 >= object->num_vertices) {
+        if (v_idx0 < 0 || v_idx0 >= src->num_vertices ||
+            v_idx1 < 0 || v_idx1 >= src->num_vertices) {
             fprintf(stderr, "Warning: Invalid vertex index in object->indices\n");
             continue;
         }
 
-        vec3 v0_object = object->vertices[v_idx0];
-        vec3 v1_object = object->vertices[v_idx1];
+        if (cull_edges && !edge_visible(ctx->cull_mode, src, front_faces, i / 2)) {
+            continue;
+        }
 
-        // Project vertices to clip space (homogeneous coordinates)
-        vec4 p0_clip = project_vertex(v0_object, model_matrix, view_matrix, projection_matrix);
-        vec4 p1_clip = project_vertex(v1_object, model_matrix, view_matrix, projection_matrix);
+        vec4 p0_clip = clip[v_idx0];
+        vec4 p1_clip = clip[v_idx1];
 
         // Check if either endpoint is behind or at the near clipping plane (w <= 0)
         // If so, skip drawing this line to avoid artifacts.
@@ -85,95 +241,722 @@ void render_wireframe(canvas_t *canvas, object3d_t *object, mat4 model_matrix, m
             continue; // Skip this line
         }
 
-        // Perform perspective divide to get Normalized Device Coordinates (NDC)
-        vec3 p0_ndc = vec3_from_cartesian(p0_clip.x / p0_clip.w, p0_clip.y / p0_clip.w, p0_clip.z / p0_clip.w);
-        vec3 p1_ndc = vec3_from_cartesian(p1_clip.x / p1_clip.w, p1_clip.y / p1_clip.w, p1_clip.z / p1_clip.w);
-
-        // Convert NDC to screen coordinates
-        vec3 p0_screen;
-        p0_screen.x = (p0_ndc.x + 1.0f) * 0.5f * canvas->width;
-        p0_screen.y = (1.0f - p0_ndc.y) * 0.5f * canvas->height; // Invert Y-axis for screen coordinates (Y-down)
-        p0_screen.z = p0_ndc.z; // Keep Z for depth sorting
-
-        vec3 p1_screen;
-        p1_screen.x = (p1_ndc.x + 1.0f) * 0.5f * canvas->width;
-        p1_screen.y = (1.0f - p1_ndc.y) * 0.5f * canvas->height; // Invert Y-axis for screen coordinates (Y-down)
-        p1_screen.z = p1_ndc.z; // Keep Z for depth sorting
-
-        // Calculate world-space positions for lighting
-        vec3 p0_world = vec3_from_vec4(mat4_mul_vec4(model_matrix, vec4_from_vec3(v0_object, 1.0f)));
-        vec3 p1_world = vec3_from_vec4(mat4_mul_vec4(model_matrix, vec4_from_vec3(v1_object, 1.0f)));
-
-        // Calculate lighting intensity for this edge
-        float intensity = compute_edge_lighting(p0_world, p1_world, light_dirs, num_lights);
-
-        // Clamp intensity to [0, 1]
-        intensity = fmaxf(0.0f, fminf(1.0f, intensity));
+        // Eye distance of the midpoint (clip w is linear in depth, unlike NDC z); skip edges lost in the fog
+        depth[line_count] = 0.5f * (p0_clip.w + p1_clip.w);
+        if (depth[line_count] >= fog_cutoff) {
+            continue;
+        }
 
-        // Apply a power function to boost lower intensities, making them more visible.
-        intensity = powf(intensity, LIGHT_BOOST_EXPONENT);
+        // Perspective divide and NDC to screen mapping
+        float p0_x = (p0_clip.x / p0_clip.w + 1.0f) * 0.5f * canvas->width;
+        float p0_y = (1.0f - p0_clip.y / p0_clip.w) * 0.5f * canvas->height; // Invert Y-axis for screen coordinates (Y-down)
+        float p0_z = p0_clip.z / p0_clip.w; // Keep Z for depth sorting
+
+        float p1_x = (p1_clip.x / p1_clip.w + 1.0f) * 0.5f * canvas->width;
+        float p1_y = (1.0f - p1_clip.y / p1_clip.w) * 0.5f * canvas->height; // Invert Y-axis for screen coordinates (Y-down)
+        float p1_z = p1_clip.z / p1_clip.w; // Keep Z for depth sorting
+
+        // Edge direction for the batched lighting pass: cached in object space, or from the world positions
+        if (lights->edge_gray != NULL) {
+            gray[line_count] = lights->edge_gray[i / 2];
+        } else if (lights->edge_dirs != NULL) {
+            const float *d = lights->edge_dirs + 3 * (i / 2);
+            dir_x[line_count] = d[0];
+            dir_y[line_count] = d[1];
+            dir_z[line_count] = d[2];
+        } else {
+            const float *w0 = world + 3 * v_idx0;
+            const float *w1 = world + 3 * v_idx1;
+            dir_x[line_count] = w1[0] - w0[0];
+            dir_y[line_count] = w1[1] - w0[1];
+            dir_z[line_count] = w1[2] - w0[2];
+        }
 
-        // Map intensity to a grayscale color
-        unsigned char color_val = (unsigned char)(intensity * 255.0f);
-        color_t edge_color = {color_val, color_val, color_val};
+        if (lights->grid != NULL) {
+            const float *w0 = world + 3 * v_idx0;
+            const float *w1 = world + 3 * v_idx1;
+            mid_x[line_count] = 0.5f * (w0[0] + w1[0]);
+            mid_y[line_count] = 0.5f * (w0[1] + w1[1]);
+            mid_z[line_count] = 0.5f * (w0[2] + w1[2]);
+
+            // Tile of the projected midpoint (the midpoint of the clip positions, so it lies on the edge), clamped
+            // to the border tiles like the light rectangles so partly visible edges keep their local lights
+            float mid_w = 0.5f * (p0_clip.w + p1_clip.w);
+            float sx = (0.5f * (p0_clip.x + p1_clip.x) / mid_w + 1.0f) * 0.5f * canvas->width;
+            float sy = (1.0f - 0.5f * (p0_clip.y + p1_clip.y) / mid_w) * 0.5f * canvas->height;
+            sx = fmaxf(0.0f, fminf(sx, canvas->width - 1.0f)); // Also maps NaN into the grid
+            sy = fmaxf(0.0f, fminf(sy, canvas->height - 1.0f));
+            int tx = (int)(sx / LIGHT_TILE_SIZE);
+            int ty = (int)(sy / LIGHT_TILE_SIZE);
+            if (tx > lights->grid->tiles_x - 1) tx = lights->grid->tiles_x - 1;
+            if (ty > lights->grid->tiles_y - 1) ty = lights->grid->tiles_y - 1;
+            tiles[line_count] = ty * lights->grid->tiles_x + tx;
+        }
 
         // Store the line and its average Z for sorting, along with its color
-        lines_to_render[line_count].start_screen = p0_screen;
-        lines_to_render[line_count].end_screen = p1_screen;
-        lines_to_render[line_count].average_z = (p0_screen.z + p1_screen.z) / 2.0f;
-        lines_to_render[line_count].color = edge_color; // Store the calculated color
+        lines_to_render[line_count].x0 = p0_x;
+        lines_to_render[line_count].y0 = p0_y;
+        lines_to_render[line_count].x1 = p1_x;
+        lines_to_render[line_count].y1 = p1_y;
+        lines_to_render[line_count].average_z = (p0_z + p1_z) / 2.0f;
         line_count++;
     }
+    STATS_END(ctx->stats, STAGE_PROJECT, project_start);
+    STATS_ADD(ctx->stats, edges_submitted, (uint64_t)max_lines);
+
+    // Light every kept edge in one pass and map the intensities to grayscale colors
+    STATS_BEGIN(ctx->stats, lighting_start);
+    if (lights->edge_gray != NULL) {
+        // Lit before projection
+    } else if (lights->grid != NULL) {
+        compute_edge_lighting_grid(dir_x, dir_y, dir_z, mid_x, mid_y, mid_z, tiles, line_count, lights->grid, ctx->ambient, gray);
+    } else if (lights->edge_dirs != NULL) {
+        compute_edge_lighting_batch_unit(dir_x, dir_y, dir_z, line_count, lights->light_dirs, lights->num_lights, ctx->ambient, gray);
+    } else {
+        compute_edge_lighting_batch(dir_x, dir_y, dir_z, line_count, lights->light_dirs, lights->num_lights, ctx->ambient, gray);
+    }
+    if (ctx->fog_mode == FOG_NONE) {
+        for (int i = 0; i < line_count; ++i) {
+            lines_to_render[i].color = (color_t){gray[i], gray[i], gray[i]};
+        }
+    } else {
+        // Fade with distance in the same batch and drop the edges that fade out completely
+        compute_edge_fog_batch(depth, line_count, ctx->fog_mode, ctx->fog_start, ctx->fog_end, ctx->fog_density, gray);
+        int kept = 0;
+        for (int i = 0; i < line_count; ++i) {
+            if (gray[i] == 0) continue;
+            lines_to_render[kept] = lines_to_render[i];
+            lines_to_render[kept].color = (color_t){gray[i], gray[i], gray[i]};
+            kept++;
+        }
+        line_count = kept;
+    }
+    STATS_END(ctx->stats, STAGE_LIGHTING, lighting_start);
+    STATS_ADD(ctx->stats, edges_culled, (uint64_t)(max_lines - line_count));
 
     // Sort lines by depth (Z-value) from back to front
+    STATS_BEGIN(ctx->stats, sort_start);
     qsort(lines_to_render, line_count, sizeof(render_line_t), compare_render_lines);
+    STATS_END(ctx->stats, STAGE_SORT, sort_start);
+
+    free(dir_x);
+    free(front_faces);
+    return line_count;
+}
 
-    // Draw sorted lines
-    for (int i = 0; i < line_count; ++i) {
-        render_line_t current_line = lines_to_render[i];
+// Draw lines in the order given
+void render_lines(canvas_t *canvas, const render_line_t *lines, int count, float line_thickness) {
+    if (canvas == NULL || lines == NULL) return;
+    STATS_BEGIN(canvas->stats, start);
+    for (int i = 0; i < count; ++i) {
+        const render_line_t *current_line = &lines[i];
         
         // Pass the calculated color to draw_line_f
-        draw_line_f(canvas, current_line.start_screen.x, current_line.start_screen.y, 
-                     current_line.end_screen.x, current_line.end_screen.y, 
-                     line_thickness, current_line.color);
+        draw_line_f(canvas, current_line->x0, current_line->y0, 
+                     current_line->x1, current_line->y1, 
+                     line_thickness, current_line->color);
+    }
+    STATS_ADD(canvas->stats, lines_drawn, (uint64_t)(count > 0 ? count : 0));
+    STATS_END(canvas->stats, STAGE_RASTER, start);
+}
+
+// Light, sort and rasterize the edges of already transformed vertices
+static void draw_source_edges(render_context_t *ctx, canvas_t *canvas, const mesh_source_t *src, const float *world, const vec4 *clip, float line_thickness, const edge_lights_t *lights) {
+    // Allocate memory to store projected lines for sorting
+    render_line_t *lines_to_render = malloc(src->num_indices / 2 * sizeof(render_line_t));
+    if (lines_to_render == NULL) {
+        perror("Failed to allocate memory for lines_to_render");
+        return;
     }
 
+    int line_count = build_source_lines(ctx, canvas, src, world, clip, lights, lines_to_render);
+    render_lines(canvas, lines_to_render, line_count, line_thickness);
+
     free(lines_to_render);
 }
 
+// Allocate per-vertex scratch: world-space xyz followed by clip-space positions
+static float *alloc_transformed(int num_vertices, vec4 **clip) {
+    float *world = malloc(num_vertices * (3 * sizeof(float) + sizeof(vec4)));
+    if (world == NULL) {
+        perror("Failed to allocate memory for transformed vertices");
+        return NULL;
+    }
+    *clip = (vec4 *)(world + 3 * num_vertices);
+    return world;
+}
 
-// Renders a 3D object as a series of points (particles) on the given canvas.
-// It projects each vertex and draws a small circle at that screen location.
-void render_object_as_points(canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float point_size) {
-    if (canvas == NULL || object == NULL || object->vertices == NULL) {
+// Vertices transformed for one wireframe draw, with the lights to shade their edges
+typedef struct {
+    void *block;                          // Single allocation holding the arrays below
+    float *world;                         // World-space xyz (NULL when lighting in object space)
+    vec4 *clip;
+    edge_lights_t lights;
+} edge_pass_t;
+
+// Rotate world-space light directions into object space: inverse rotation = transpose, so dot each light
+// with the rotation's columns
+static void lights_to_object_space(const float rotation[9], const vec3 *light_dirs, int num_lights, vec3 *object_lights) {
+    for (int l = 0; l < num_lights; ++l) {
+        vec4 d = vec4_from_vec3(light_dirs[l], 0.0f);
+        float x = rotation[0] * d.x + rotation[1] * d.y + rotation[2] * d.z;
+        float y = rotation[3] * d.x + rotation[4] * d.y + rotation[5] * d.z;
+        float z = rotation[6] * d.x + rotation[7] * d.y + rotation[8] * d.z;
+        object_lights[l] = (vec3){x, y, z, 0.0f, 0.0f, 0.0f, true, false};
+    }
+}
+
+// Project every vertex once and pick the lighting space. Rigid models with cached edge directions
+// rotate the few lights into object space instead of computing world positions and edge directions.
+static bool edge_pass_begin(edge_pass_t *pass, const mesh_source_t *src, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, vec3* light_dirs, int num_lights, render_stats_t *stats) {
+    memset(pass, 0, sizeof(*pass));
+    mat4 view_projection = mat4_mul(projection_matrix, view_matrix);
+    if (light_dirs == NULL || num_lights < 0) num_lights = 0;
+
+    float rotation[9];
+    if (src->edge_dirs != NULL && mat4_rigid_rotation(model_matrix, rotation)) {
+        pass->block = malloc(src->num_vertices * sizeof(vec4) + num_lights * sizeof(vec3) + 1);
+        if (pass->block == NULL) {
+            perror("Failed to allocate memory for transformed vertices");
+            return false;
+        }
+        pass->clip = pass->block;
+        vec3 *object_lights = (vec3 *)(pass->clip + src->num_vertices);
+
+        lights_to_object_space(rotation, light_dirs, num_lights, object_lights);
+        transform_source_clip(src, mat4_mul(view_projection, model_matrix), pass->clip, stats);
+        pass->lights = (edge_lights_t){.light_dirs = object_lights, .num_lights = num_lights, .edge_dirs = src->edge_dirs};
+        return true;
+    }
+
+    pass->world = alloc_transformed(src->num_vertices, &pass->clip);
+    if (pass->world == NULL) return false;
+    pass->block = pass->world;
+    transform_source_vertices(src, model_matrix, view_projection, pass->world, pass->clip, stats);
+    pass->lights = (edge_lights_t){.light_dirs = light_dirs, .num_lights = num_lights};
+    return true;
+}
+
+// Shared wireframe pipeline: transform vertices, light and sort edges, then rasterize
+static void render_wireframe_source(render_context_t *ctx, canvas_t *canvas, const mesh_source_t *src, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, vec3* light_dirs, int num_lights) {
+    edge_pass_t pass;
+    if (!edge_pass_begin(&pass, src, model_matrix, view_matrix, projection_matrix, light_dirs, num_lights, ctx->stats)) return;
+
+    draw_source_edges(ctx, canvas, src, pass.world, pass.clip, line_thickness, &pass.lights);
+
+    free(pass.block);
+}
+
+// World-space bounding sphere of transformed vertices (centered on their bounding box)
+static float world_bounds(const float *world, int num_vertices, float center[3]) {
+    float lo[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float hi[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (int i = 0; i < num_vertices; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = fminf(lo[k], world[3 * i + k]);
+            hi[k] = fmaxf(hi[k], world[3 * i + k]);
+        }
+    }
+    for (int k = 0; k < 3; ++k) {
+        center[k] = 0.5f * (lo[k] + hi[k]);
+    }
+
+    float radius_sq = 0.0f;
+    for (int i = 0; i < num_vertices; ++i) {
+        float dx = world[3 * i] - center[0];
+        float dy = world[3 * i + 1] - center[1];
+        float dz = world[3 * i + 2] - center[2];
+        radius_sq = fmaxf(radius_sq, dx * dx + dy * dy + dz * dz);
+    }
+    return sqrtf(radius_sq);
+}
+
+// Describe an object3d_t as a mesh source
+static mesh_source_t object_source(const object3d_t *object) {
+    mesh_source_t src = {0};
+    src.vertices = object->vertices;
+    src.num_vertices = object->num_vertices;
+    src.indices = object->indices;
+    src.index_size = sizeof(int);
+    src.num_indices = object->num_indices;
+    src.faces = object->faces;
+    src.num_faces = object->num_faces;
+    src.edge_faces = object->edge_faces;
+    src.edge_dirs = object->edge_dirs;
+    return src;
+}
+
+// render_wireframe now accepts light_dirs and num_lights
+void render_wireframe(canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, vec3* light_dirs, int num_lights) {
+    if (canvas == NULL) {
+        return;
+    }
+
+    render_context_t ctx;
+    render_context_init(&ctx);
+    ctx.stats = canvas->stats; // Default settings report to the canvas's stats, if any
+    render_wireframe_ctx(&ctx, canvas, object, model_matrix, view_matrix, projection_matrix, line_thickness, light_dirs, num_lights);
+}
+
+// Render an object with explicit renderer settings
+void render_wireframe_ctx(render_context_t *ctx, canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, vec3* light_dirs, int num_lights) {
+    if (ctx == NULL || canvas == NULL || object == NULL || object->vertices == NULL || object->indices == NULL) {
         return;
     }
 
-    // Iterate through each vertex in the object
-    for (int i = 0; i < object->num_vertices; ++i) {
-        vec3 vertex_object = object->vertices[i];
+    mesh_source_t src = object_source(object);
+    render_wireframe_source(ctx, canvas, &src, model_matrix, view_matrix, projection_matrix, line_thickness, light_dirs, num_lights);
+}
+
+// Render an object lit by point, spot and directional light objects
+void render_wireframe_lit(render_context_t *ctx, canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, const light_t *lights, int num_lights) {
+    if (ctx == NULL || canvas == NULL || object == NULL || object->vertices == NULL || object->indices == NULL) {
+        return;
+    }
+
+    mesh_source_t src = object_source(object);
+    vec4 *clip;
+    float *world = alloc_transformed(src.num_vertices, &clip);
+    if (world == NULL) return;
+    transform_source_vertices(&src, model_matrix, mat4_mul(projection_matrix, view_matrix), world, clip, ctx->stats);
+
+    // Drop lights that cannot reach the object, then bin the rest per screen tile
+    float center[3];
+    float radius = world_bounds(world, src.num_vertices, center);
+    light_grid_t grid;
+    if (!light_grid_build(&grid, lights, num_lights, view_matrix, projection_matrix, canvas->width, canvas->height, center, radius)) {
+        perror("Failed to allocate memory for the light grid");
+        free(world);
+        return;
+    }
+
+    edge_lights_t edge_lights = {.grid = &grid};
+    draw_source_edges(ctx, canvas, &src, world, clip, line_thickness, &edge_lights);
+
+    light_grid_free(&grid);
+    free(world);
+}
+
+// Project, light and depth-sort an object's edges without drawing them
+int render_wireframe_lines(render_context_t *ctx, canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, vec3* light_dirs, int num_lights, render_line_t **lines) {
+    if (lines == NULL) return -1;
+    *lines = NULL;
+    if (ctx == NULL || canvas == NULL || object == NULL || object->vertices == NULL || object->indices == NULL) {
+        return -1;
+    }
+
+    mesh_source_t src = object_source(object);
+    render_line_t *out = malloc((src.num_indices / 2 > 0 ? src.num_indices / 2 : 1) * sizeof(render_line_t));
+    if (out == NULL) {
+        perror("Failed to allocate memory for lines_to_render");
+        return -1;
+    }
+
+    edge_pass_t pass;
+    if (!edge_pass_begin(&pass, &src, model_matrix, view_matrix, projection_matrix, light_dirs, num_lights, ctx->stats)) {
+        free(out);
+        return -1;
+    }
+    int count = build_source_lines(ctx, canvas, &src, pass.world, pass.clip, &pass.lights, out);
+
+    free(pass.block);
+    *lines = out;
+    return count;
+}
+
+// Render a compact mesh, folding its dequantization transform into the model matrix
+void render_wireframe_compact(canvas_t *canvas, const compact_mesh_t *mesh, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float line_thickness, vec3* light_dirs, int num_lights) {
+    if (canvas == NULL || mesh == NULL || mesh->positions == NULL || mesh->indices == NULL) {
+        return;
+    }
+
+    mesh_source_t src = {0};
+    src.positions = mesh->positions;
+    src.position_format = mesh->position_format;
+    src.num_vertices = mesh->num_vertices;
+    src.indices = mesh->indices;
+    src.index_size = mesh->index_size;
+    src.num_indices = mesh->num_indices;
+
+    render_context_t ctx;
+    render_context_init(&ctx);
+    ctx.stats = canvas->stats; // Default settings report to the canvas's stats, if any
+
+    mat4 model_dequant = mat4_mul(model_matrix, compact_mesh_dequant_matrix(mesh));
+    render_wireframe_source(&ctx, canvas, &src, model_dequant, view_matrix, projection_matrix, line_thickness, light_dirs, num_lights);
+}
+
+// =======================
+// Multi-view
+// =======================
+
+// Views handled by one thread of render_wireframe_views: first_view, first_view + view_step, ...
+typedef struct {
+    render_context_t ctx;                 // The caller's settings (without stats on worker threads)
+    const mesh_source_t *src;
+    const render_view_t *views;
+    int num_views;
+    int first_view;
+    int view_step;
+    mat4 model_matrix;                    // Folded into each view's matrix when world is NULL
+    const vec4 *world;                    // World positions shared by the views, or NULL
+    const edge_lights_t *lights;          // Edges lit once for all views
+    float line_thickness;
+    bool running;                         // Started on its own thread
+} view_job_t;
+
+static void *render_view_job(void *arg) {
+    view_job_t *job = arg;
+    const mesh_source_t *src = job->src;
+    vec4 *clip = malloc((src->num_vertices > 0 ? src->num_vertices : 1) * sizeof(vec4));
+    render_line_t *lines = malloc((src->num_indices / 2 > 0 ? src->num_indices / 2 : 1) * sizeof(render_line_t));
+    if (clip == NULL || lines == NULL) {
+        perror("Failed to allocate memory for a view");
+        free(clip);
+        free(lines);
+        return NULL;
+    }
+
+    for (int v = job->first_view; v < job->num_views; v += job->view_step) {
+        const render_view_t *view = &job->views[v];
+        if (view->canvas == NULL) continue;
+        mat4 view_projection = mat4_mul(view->projection_matrix, view->view_matrix);
+        if (job->world != NULL) {
+            STATS_BEGIN(job->ctx.stats, start);
+            for (int i = 0; i < src->num_vertices; ++i) clip[i] = mat4_mul_vec4(view_projection, job->world[i]);
+            STATS_ADD(job->ctx.stats, vertices_transformed, (uint64_t)src->num_vertices);
+            STATS_END(job->ctx.stats, STAGE_TRANSFORM, start);
+        } else {
+            transform_source_clip(src, mat4_mul(view_projection, job->model_matrix), clip, job->ctx.stats);
+        }
+        int count = build_source_lines(&job->ctx, view->canvas, src, NULL, clip, job->lights, lines);
+        render_lines(view->canvas, lines, count, job->line_thickness);
+    }
+
+    free(clip);
+    free(lines);
+    return NULL;
+}
+
+// Render an object from several cameras, transforming and lighting it once
+void render_wireframe_views(render_context_t *ctx, object3d_t *object, mat4 model_matrix, const render_view_t *views, int num_views, float line_thickness, vec3* light_dirs, int num_lights, int num_threads) {
+    if (ctx == NULL || object == NULL || object->vertices == NULL || object->indices == NULL || views == NULL || num_views < 1) {
+        return;
+    }
+    mesh_source_t src = object_source(object);
+    if (light_dirs == NULL || num_lights < 0) num_lights = 0;
+    int num_edges = src.num_indices / 2;
+
+    // Light in the same space as edge_pass_begin, so each view matches render_wireframe_ctx
+    float rotation[9];
+    bool object_space = src.edge_dirs != NULL && mat4_rigid_rotation(model_matrix, rotation);
+    size_t world_size = object_space ? 0 : src.num_vertices * sizeof(vec4);
+    char *block = malloc(world_size + num_edges * (3 * sizeof(float) + 1) + num_lights * sizeof(vec3) + 1);
+    if (block == NULL) {
+        perror("Failed to allocate memory for multi-view lighting");
+        return;
+    }
+    vec4 *world = object_space ? NULL : (vec4 *)block;
+    float *dir_x = (float *)(block + world_size);
+    float *dir_y = dir_x + num_edges;
+    float *dir_z = dir_y + num_edges;
+    vec3 *object_lights = (vec3 *)(dir_z + num_edges);
+    unsigned char *gray = (unsigned char *)(object_lights + num_lights);
+
+    if (object_space) {
+        lights_to_object_space(rotation, light_dirs, num_lights, object_lights);
+        for (int e = 0; e < num_edges; ++e) {
+            dir_x[e] = src.edge_dirs[3 * e];
+            dir_y[e] = src.edge_dirs[3 * e + 1];
+            dir_z[e] = src.edge_dirs[3 * e + 2];
+        }
+    } else {
+        STATS_BEGIN(ctx->stats, transform_start);
+        for (int i = 0; i < src.num_vertices; ++i) world[i] = mat4_mul_vec4(model_matrix, source_position(&src, i));
+        STATS_ADD(ctx->stats, vertices_transformed, (uint64_t)src.num_vertices);
+        STATS_END(ctx->stats, STAGE_TRANSFORM, transform_start);
+        for (int e = 0; e < num_edges; ++e) {
+            int i0 = source_index(&src, 2 * e), i1 = source_index(&src, 2 * e + 1);
+            bool valid = i0 >= 0 && i0 < src.num_vertices && i1 >= 0 && i1 < src.num_vertices;
+            dir_x[e] = valid ? world[i1].x - world[i0].x : 0.0f;
+            dir_y[e] = valid ? world[i1].y - world[i0].y : 0.0f;
+            dir_z[e] = valid ? world[i1].z - world[i0].z : 0.0f;
+        }
+    }
+    STATS_BEGIN(ctx->stats, lighting_start);
+    if (object_space) {
+        compute_edge_lighting_batch_unit(dir_x, dir_y, dir_z, num_edges, object_lights, num_lights, ctx->ambient, gray);
+    } else {
+        compute_edge_lighting_batch(dir_x, dir_y, dir_z, num_edges, light_dirs, num_lights, ctx->ambient, gray);
+    }
+    STATS_END(ctx->stats, STAGE_LIGHTING, lighting_start);
+    edge_lights_t lights = {.edge_gray = gray};
+
+    view_job_t job = {*ctx, &src, views, num_views, 0, 1, model_matrix, world, &lights, line_thickness, false};
+    if (num_threads > num_views) num_threads = num_views;
+#if TINY3D_THREADS
+    view_job_t *jobs = num_threads > 1 ? malloc(num_threads * sizeof(view_job_t)) : NULL;
+    pthread_t *threads = jobs ? malloc(num_threads * sizeof(pthread_t)) : NULL;
+    if (threads != NULL) {
+        for (int t = 0; t < num_threads; ++t) {
+            jobs[t] = job;
+            jobs[t].ctx.stats = NULL;
+            jobs[t].first_view = t;
+            jobs[t].view_step = num_threads;
+        }
+        // The caller is thread 0
+        for (int t = 1; t < num_threads; ++t) {
+            jobs[t].running = pthread_create(&threads[t], NULL, render_view_job, &jobs[t]) == 0;
+        }
+        render_view_job(&jobs[0]);
+        for (int t = 1; t < num_threads; ++t) {
+            if (jobs[t].running) {
+                pthread_join(threads[t], NULL);
+            } else {
+                render_view_job(&jobs[t]); // The thread did not start: draw its views here
+            }
+        }
+        free(threads);
+        free(jobs);
+        free(block);
+        return;
+    }
+    free(jobs);
+#endif
+    render_view_job(&job);
+    free(block);
+}
 
-        // Project the vertex to clip space
-        vec4 p_clip = project_vertex(vertex_object, model_matrix, view_matrix, projection_matrix);
 
-        // NEW: Check if the point is behind or at the near clipping plane.
-        if (p_clip.w <= W_CLIP_EPSILON) {
-            continue; // Skip this point
+// A polygon corner in clip space with its lighting intensity
+typedef struct {
+    vec4 clip;
+    float intensity;
+} clip_vertex_t;
+
+// Lambertian intensity of a unit surface normal over the scene lights, boosted like edges
+static float surface_lighting(const float n[3], vec3* light_dirs, int num_lights, float ambient) {
+    float intensity = 0.0f;
+    for (int i = 0; i < num_lights; ++i) {
+        intensity += fmaxf(0.0f, n[0] * light_dirs[i].x + n[1] * light_dirs[i].y + n[2] * light_dirs[i].z);
+    }
+    if (num_lights > 0) {
+        intensity /= (float)num_lights;
+    }
+    intensity = ambient + intensity * (1.0f - ambient);
+    intensity = fmaxf(0.0f, fminf(1.0f, intensity));
+    return powf(intensity, LIGHT_BOOST_EXPONENT);
+}
+
+// Unnormalized (area-weighted) world-space normal of a triangle
+static void face_normal(const float *world, const int *tri, float n[3]) {
+    const float *a = world + 3 * tri[0];
+    const float *b = world + 3 * tri[1];
+    const float *c = world + 3 * tri[2];
+    float ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+    float vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+    n[0] = uy * vz - uz * vy;
+    n[1] = uz * vx - ux * vz;
+    n[2] = ux * vy - uy * vx;
+}
+
+// Scale a vector to unit length (left unchanged if near zero)
+static void normalize3(float n[3]) {
+    float len = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (len > 1e-12f) {
+        n[0] /= len;
+        n[1] /= len;
+        n[2] /= len;
+    }
+}
+
+// Clip a convex polygon against the near plane (z >= -w). Returns the new vertex count.
+static int clip_polygon_near(const clip_vertex_t *in, int count, clip_vertex_t *out) {
+    int out_count = 0;
+    for (int i = 0; i < count; ++i) {
+        const clip_vertex_t *a = &in[i];
+        const clip_vertex_t *b = &in[(i + 1) % count];
+        float da = a->clip.z + a->clip.w;
+        float db = b->clip.z + b->clip.w;
+
+        if (da >= 0.0f) {
+            out[out_count++] = *a;
+        }
+        if ((da >= 0.0f) != (db >= 0.0f)) {
+            float t = da / (da - db);
+            clip_vertex_t v;
+            v.clip.x = a->clip.x + (b->clip.x - a->clip.x) * t;
+            v.clip.y = a->clip.y + (b->clip.y - a->clip.y) * t;
+            v.clip.z = a->clip.z + (b->clip.z - a->clip.z) * t;
+            v.clip.w = a->clip.w + (b->clip.w - a->clip.w) * t;
+            v.intensity = a->intensity + (b->intensity - a->intensity) * t;
+            out[out_count++] = v;
+        }
+    }
+    return out_count;
+}
+
+// Perspective divide and viewport mapping for a filled-triangle corner
+static raster_vertex_t to_raster_vertex(const canvas_t *canvas, const clip_vertex_t *v) {
+    raster_vertex_t r;
+    float inv_w = 1.0f / v->clip.w;
+    r.x = (v->clip.x * inv_w + 1.0f) * 0.5f * canvas->width;
+    r.y = (1.0f - v->clip.y * inv_w) * 0.5f * canvas->height; // Invert Y-axis for screen coordinates (Y-down)
+    r.z = v->clip.z * inv_w;
+    r.intensity = v->intensity;
+    return r;
+}
+
+// Render object faces as lit, depth-tested, filled triangles
+void render_solid(render_context_t *ctx, canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, vec3* light_dirs, int num_lights) {
+    if (ctx == NULL || canvas == NULL || object == NULL || object->vertices == NULL || object->faces == NULL) {
+        return;
+    }
+    if (!canvas_enable_depth(canvas)) {
+        fprintf(stderr, "Warning: No depth buffer, filled triangles are drawn unsorted\n");
+    }
+
+    mesh_source_t src = object_source(object);
+    vec4 *clip;
+    float *world = alloc_transformed(src.num_vertices, &clip);
+    if (world == NULL) return;
+    transform_source_vertices(&src, model_matrix, mat4_mul(projection_matrix, view_matrix), world, clip, ctx->stats);
+
+    // Gouraud: light area-weighted vertex normals once per vertex
+    float *vertex_intensity = NULL;
+    if (ctx->shade_mode == SHADE_GOURAUD) {
+        float *normals = calloc(3 * src.num_vertices, sizeof(float));
+        vertex_intensity = malloc(src.num_vertices * sizeof(float));
+        if (normals == NULL || vertex_intensity == NULL) {
+            perror("Failed to allocate memory for vertex normals");
+            free(normals);
+            free(vertex_intensity);
+            free(world);
+            return;
+        }
+        for (int f = 0; f < object->num_faces; ++f) {
+            const int *tri = object->faces + 3 * f;
+            if (tri[0] < 0 || tri[0] >= src.num_vertices || tri[1] < 0 || tri[1] >= src.num_vertices ||
+                tri[2] < 0 || tri[2] >= src.num_vertices) {
+                continue;
+            }
+            float n[3];
+            face_normal(world, tri, n);
+            for (int k = 0; k < 3; ++k) {
+                normals[3 * tri[k] + 0] += n[0];
+                normals[3 * tri[k] + 1] += n[1];
+                normals[3 * tri[k] + 2] += n[2];
+            }
+        }
+        for (int v = 0; v < src.num_vertices; ++v) {
+            normalize3(normals + 3 * v);
+            vertex_intensity[v] = surface_lighting(normals + 3 * v, light_dirs, num_lights, ctx->ambient);
+        }
+        free(normals);
+    }
+
+    STATS_BEGIN(ctx->stats, raster_start);
+    for (int f = 0; f < object->num_faces; ++f) {
+        const int *tri = object->faces + 3 * f;
+        if (tri[0] < 0 || tri[0] >= src.num_vertices || tri[1] < 0 || tri[1] >= src.num_vertices ||
+            tri[2] < 0 || tri[2] >= src.num_vertices) {
+            fprintf(stderr, "Warning: Invalid vertex index in object->faces\n");
+            continue;
+        }
+
+        float flat_intensity = 0.0f;
+        if (ctx->shade_mode == SHADE_FLAT) {
+            float n[3];
+            face_normal(world, tri, n);
+            normalize3(n);
+            flat_intensity = surface_lighting(n, light_dirs, num_lights, ctx->ambient);
+        }
+
+        clip_vertex_t polygon[3];
+        for (int k = 0; k < 3; ++k) {
+            polygon[k].clip = clip[tri[k]];
+            polygon[k].intensity = vertex_intensity ? vertex_intensity[tri[k]] : flat_intensity;
+        }
+
+        // Clip against the near plane only when a corner is in front of it
+        clip_vertex_t clipped[4];
+        const clip_vertex_t *poly = polygon;
+        int count = 3;
+        if (polygon[0].clip.z < -polygon[0].clip.w || polygon[1].clip.z < -polygon[1].clip.w ||
+            polygon[2].clip.z < -polygon[2].clip.w) {
+            count = clip_polygon_near(polygon, 3, clipped);
+            poly = clipped;
+        }
+        if (count < 3) continue;
+
+        raster_vertex_t corners[4];
+        for (int k = 0; k < count; ++k) {
+            if (poly[k].clip.w <= W_CLIP_EPSILON) {
+                count = 0; // Degenerate after clipping
+                break;
+            }
+            corners[k] = to_raster_vertex(canvas, &poly[k]);
+        }
+        if (count < 3) continue;
+
+        // Counter-clockwise in NDC becomes clockwise (negative area) with the Y-down flip
+        float area = (corners[1].x - corners[0].x) * (corners[2].y - corners[0].y) -
+                     (corners[1].y - corners[0].y) * (corners[2].x - corners[0].x);
+        if (!ctx->double_sided && area >= 0.0f) continue;
+
+        for (int k = 1; k + 1 < count; ++k) {
+            draw_triangle_f(canvas, &corners[0], &corners[k], &corners[k + 1], ctx->fill_color);
+        }
+        STATS_ADD(ctx->stats, triangles_drawn, (uint64_t)(count - 2));
+    }
+    STATS_END(ctx->stats, STAGE_RASTER, raster_start);
+
+    // Edges on top, hiding those whose faces all point away when adjacency is available
+    if (ctx->edge_overlay && object->indices != NULL) {
+        render_context_t overlay = *ctx;
+        if (overlay.cull_mode == EDGE_CULL_NONE) {
+            overlay.cull_mode = EDGE_CULL_BACKFACE;
         }
+        edge_lights_t lights = {.light_dirs = light_dirs, .num_lights = num_lights};
+        draw_source_edges(&overlay, canvas, &src, world, clip, 1.0f, &lights);
+    }
 
-        // Perform perspective divide
-        vec3 p_ndc = vec3_from_cartesian(p_clip.x / p_clip.w, p_clip.y / p_clip.w, p_clip.z / p_clip.w);
+    free(vertex_intensity);
+    free(world);
+}
 
-        // Convert NDC to screen coordinates
-        vec3 p_screen;
-        p_screen.x = (p_ndc.x + 1.0f) * 0.5f * canvas->width;
-        p_screen.y = (1.0f - p_ndc.y) * 0.5f * canvas->height; // Invert Y-axis for screen coordinates (Y-down)
-        p_screen.z = p_ndc.z; // Keep Z for depth sorting
 
-        // For points, we'll use a fixed white color, or you could add point lighting
-        color_t point_color = {255, 255, 255}; // White color for points
+// Renders a 3D object as a series of points (particles) on the given canvas.
+// The vertices are gathered into a structure-of-arrays cloud and splatted with point_size footprints.
+void render_object_as_points(canvas_t *canvas, object3d_t *object, mat4 model_matrix, mat4 view_matrix, mat4 projection_matrix, float point_size) {
+    if (canvas == NULL || object == NULL || object->vertices == NULL || object->num_vertices <= 0) {
+        return;
+    }
 
-        // Draw a point (small filled circle) at the projected location
-        draw_line_f(canvas, p_screen.x, p_screen.y, p_screen.x, p_screen.y, point_size, point_color);
+    point_cloud_t cloud;
+    cloud.count = object->num_vertices;
+    cloud.x = malloc(3 * cloud.count * sizeof(float));
+    if (cloud.x == NULL) {
+        perror("Failed to allocate memory for point positions");
+        return;
+    }
+    cloud.y = cloud.x + cloud.count;
+    cloud.z = cloud.y + cloud.count;
+
+    for (int i = 0; i < cloud.count; ++i) {
+        vec4 v = vec4_from_vec3(object->vertices[i], 1.0f);
+        cloud.x[i] = v.x;
+        cloud.y[i] = v.y;
+        cloud.z[i] = v.z;
     }
-}
\ No newline at end of file
+
+    // For points, we'll use a fixed white color, or you could add point lighting
+    color_t point_color = {255, 255, 255}; // White color for points
+
+    render_context_t ctx;
+    render_context_init(&ctx);
+    ctx.stats = canvas->stats; // Default settings report to the canvas's stats, if any
+    render_point_cloud(&ctx, canvas, &cloud, model_matrix, view_matrix, projection_matrix, point_size, point_color);
+
+    free(cloud.x);
+}
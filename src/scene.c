@@ -0,0 +1,684 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tiny3d.h"
+#include "scene.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SCENE_BINARY_MAGIC "T3DS"
+#define SCENE_BINARY_VERSION 1
+
+// Header of a binary scene; every section offset is from the start of the file and 4-byte aligned
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    scene_settings_t settings;
+    uint32_t num_meshes, num_paths, num_points, num_instances, num_lights;
+    uint32_t meshes_offset, paths_offset, points_offset, instances_offset, lights_offset;
+    uint32_t strings_offset, strings_size;
+} scene_binary_header_t;
+
+// Record arrays of a text scene, allocated once
+typedef struct {
+    scene_mesh_t meshes[SCENE_MAX_MESHES];
+    scene_path_t paths[SCENE_MAX_PATHS];
+    float points[3 * SCENE_MAX_POINTS];
+    scene_instance_t instances[SCENE_MAX_INSTANCES];
+    scene_light_t lights[SCENE_MAX_LIGHTS];
+} scene_storage_t;
+
+// Default camera and projection of the demos
+static const scene_settings_t default_settings = {
+    800, 800, 1, {0.0f, 0.0f, 3.5f}, {-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 100.0f}
+};
+
+// =======================
+// Tokenizer
+// =======================
+
+// A slice of the input (never NUL-terminated)
+typedef struct {
+    const char *p;
+    int len;
+} token_t;
+
+typedef struct {
+    const char *p, *end;
+    const char *base;
+    int line;
+} cursor_t;
+
+static bool token_is(token_t t, const char *word) {
+    int n = (int)strlen(word);
+    return t.len == n && memcmp(t.p, word, n) == 0;
+}
+
+// Next whitespace-separated token on the current line; false at the end of the line or a comment
+static bool next_token(cursor_t *c, token_t *t) {
+    while (c->p < c->end && (*c->p == ' ' || *c->p == '\t' || *c->p == '\r')) c->p++;
+    if (c->p == c->end || *c->p == '\n' || *c->p == '#') return false;
+    t->p = c->p;
+    while (c->p < c->end && *c->p != ' ' && *c->p != '\t' && *c->p != '\r' && *c->p != '\n') c->p++;
+    t->len = (int)(c->p - t->p);
+    return true;
+}
+
+// Skip the rest of the line, including its newline
+static void next_line(cursor_t *c) {
+    const char *nl = memchr(c->p, '\n', c->end - c->p);
+    c->p = nl ? nl + 1 : c->end;
+    c->line++;
+}
+
+// Decimal number with optional sign, fraction and exponent, using the whole slice
+static bool parse_float(const char *p, const char *end, float *out) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+    double value = 0.0;
+    int digits = 0, exponent = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) value = value * 10.0 + (*p - '0');
+    if (p < end && *p == '.') {
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+            value = value * 10.0 + (*p - '0');
+            exponent--;
+        }
+    }
+    if (digits == 0) return false;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool exp_negative = false;
+        if (p < end && (*p == '-' || *p == '+')) exp_negative = *p++ == '-';
+        int e = 0, exp_digits = 0;
+        for (; p < end && *p >= '0' && *p <= '9' && e < 1000; ++p, ++exp_digits) e = e * 10 + (*p - '0');
+        if (exp_digits == 0) return false;
+        exponent += exp_negative ? -e : e;
+    }
+    if (p != end) return false;
+    // Dividing by an exact power of ten keeps short decimals correctly rounded
+    double scale = pow(10.0, exponent < 0 ? -exponent : exponent);
+    value = exponent < 0 ? value / scale : value * scale;
+    *out = (float)(negative ? -value : value);
+    return true;
+}
+
+static bool token_float(token_t t, float *out) {
+    return parse_float(t.p, t.p + t.len, out);
+}
+
+static bool token_int(token_t t, int *out) {
+    float v;
+    if (!token_float(t, &v) || v != floorf(v) || fabsf(v) > 2147483520.0f) return false;
+    *out = (int)v;
+    return true;
+}
+
+// Comma-separated list of exactly n numbers
+static bool parse_float_list(const char *p, const char *end, float *out, int n) {
+    for (int k = 0; k < n; ++k) {
+        const char *comma = k + 1 < n ? memchr(p, ',', end - p) : end;
+        if (!comma || !parse_float(p, comma, &out[k])) return false;
+        p = comma + 1;
+    }
+    return true;
+}
+
+// =======================
+// Text Parser
+// =======================
+
+static bool name_is(const cursor_t *c, uint32_t offset, uint32_t length, token_t name) {
+    return length == (uint32_t)name.len && memcmp(c->base + offset, name.p, name.len) == 0;
+}
+
+// Index of a named mesh or path, -1 if it is not defined (yet)
+static int find_mesh(const cursor_t *c, const scene_storage_t *s, int count, token_t name) {
+    for (int i = 0; i < count; ++i) {
+        if (name_is(c, s->meshes[i].name_offset, s->meshes[i].name_length, name)) return i;
+    }
+    return -1;
+}
+
+static int find_path(const cursor_t *c, const scene_storage_t *s, int count, token_t name) {
+    for (int i = 0; i < count; ++i) {
+        if (name_is(c, s->paths[i].name_offset, s->paths[i].name_length, name)) return i;
+    }
+    return -1;
+}
+
+// Read exactly n numbers from the rest of the line
+static bool read_floats(cursor_t *c, float *out, int n) {
+    token_t t;
+    for (int k = 0; k < n; ++k) {
+        if (!next_token(c, &t) || !token_float(t, &out[k])) return false;
+    }
+    return !next_token(c, &t);
+}
+
+static bool read_ints(cursor_t *c, int *out, int n) {
+    token_t t;
+    for (int k = 0; k < n; ++k) {
+        if (!next_token(c, &t) || !token_int(t, &out[k])) return false;
+    }
+    return true;
+}
+
+// Generator arguments of a mesh line
+static const char *parse_mesh(cursor_t *c, token_t generator, scene_mesh_t *m) {
+    int ints[3] = {0, 0, 0};
+    float floats[2] = {0.0f, 0.0f};
+    if (token_is(generator, "soccer")) {
+        m->type = SCENE_MESH_SOCCER;
+        if (!read_floats(c, floats, 0)) return "soccer takes no arguments";
+    } else if (token_is(generator, "icosphere")) {
+        m->type = SCENE_MESH_ICOSPHERE;
+        if (!read_ints(c, ints, 1) || !read_floats(c, floats, 0)) return "expected: icosphere <level>";
+    } else if (token_is(generator, "grid")) {
+        m->type = SCENE_MESH_GRID;
+        if (!read_ints(c, ints, 2) || !read_floats(c, floats, 2)) return "expected: grid <cols> <rows> <width> <depth>";
+    } else if (token_is(generator, "torus")) {
+        m->type = SCENE_MESH_TORUS;
+        if (!read_ints(c, ints, 2) || !read_floats(c, floats, 2)) return "expected: torus <major> <minor> <R> <r>";
+    } else if (token_is(generator, "cylinder")) {
+        m->type = SCENE_MESH_CYLINDER;
+        token_t t;
+        if (!read_ints(c, ints, 2) || !next_token(c, &t) || !token_float(t, &floats[0]) ||
+            !next_token(c, &t) || !token_float(t, &floats[1]) || !read_ints(c, ints + 2, 1) || next_token(c, &t)) {
+            return "expected: cylinder <segments> <stacks> <radius> <height> <capped>";
+        }
+    } else if (token_is(generator, "lines")) {
+        m->type = SCENE_MESH_LINES;
+        token_t t;
+        if (!read_ints(c, ints, 1) || !next_token(c, &t) || !token_float(t, &floats[0]) ||
+            !next_token(c, &t) || !token_float(t, &floats[1]) || !read_ints(c, ints + 1, 1) || next_token(c, &t)) {
+            return "expected: lines <count> <extent> <max_length> <seed>";
+        }
+    } else {
+        return "unknown mesh generator";
+    }
+    memcpy(m->i, ints, sizeof(ints));
+    memcpy(m->f, floats, sizeof(floats));
+    return NULL;
+}
+
+// One key=value pair of an instance line
+static const char *parse_instance_key(const cursor_t *c, const scene_storage_t *s, int num_paths,
+                                      token_t t, scene_instance_t *inst) {
+    const char *eq = memchr(t.p, '=', t.len);
+    if (!eq) return "instance options are key=value";
+    token_t key = {t.p, (int)(eq - t.p)};
+    token_t value = {eq + 1, t.len - key.len - 1};
+    const char *end = value.p + value.len;
+
+    if (token_is(key, "at")) {
+        if (!parse_float_list(value.p, end, inst->at, 3)) return "at= needs x,y,z";
+    } else if (token_is(key, "spin")) {
+        if (!parse_float_list(value.p, end, inst->spin, 3)) return "spin= needs x,y,z";
+    } else if (token_is(key, "scale")) {
+        if (!token_float(value, &inst->scale)) return "bad scale=";
+    } else if (token_is(key, "thickness")) {
+        if (!token_float(value, &inst->thickness)) return "bad thickness=";
+    } else if (token_is(key, "path")) {
+        inst->path = find_path(c, s, num_paths, value);
+        if (inst->path < 0) return "unknown path";
+    } else if (token_is(key, "mode")) {
+        if (token_is(value, "wire")) inst->mode = SCENE_DRAW_WIRE;
+        else if (token_is(value, "solid")) inst->mode = SCENE_DRAW_SOLID;
+        else return "mode= must be wire or solid";
+    } else if (token_is(key, "ease")) {
+        static const char *names[] = {"linear", "step", "in-quad", "out-quad", "sine", "in-out-cubic"};
+        inst->ease = -1;
+        for (int e = 0; e < (int)(sizeof(names) / sizeof(names[0])); ++e) {
+            if (token_is(value, names[e])) inst->ease = EASE_LINEAR + e;
+        }
+        if (inst->ease < 0) return "unknown ease=";
+    } else {
+        return "unknown instance option";
+    }
+    return NULL;
+}
+
+// Parse one directive; returns an error message or NULL
+static const char *parse_directive(cursor_t *c, token_t word, scene_t *scene, scene_storage_t *s) {
+    scene_settings_t *set = &scene->settings;
+    token_t t;
+    if (token_is(word, "canvas")) {
+        int size[2];
+        if (!read_ints(c, size, 2) || next_token(c, &t) || size[0] < 1 || size[1] < 1) return "expected: canvas <width> <height>";
+        set->width = size[0];
+        set->height = size[1];
+    } else if (token_is(word, "frames")) {
+        if (!read_ints(c, &set->frames, 1) || next_token(c, &t) || set->frames < 1) return "expected: frames <count>";
+    } else if (token_is(word, "camera")) {
+        if (!read_floats(c, set->camera, 3)) return "expected: camera <x> <y> <z>";
+    } else if (token_is(word, "perspective")) {
+        if (!read_floats(c, set->perspective, 6)) return "expected: perspective <left> <right> <bottom> <top> <near> <far>";
+    } else if (token_is(word, "light")) {
+        if (scene->num_lights == SCENE_MAX_LIGHTS) return "too many lights";
+        if (!read_floats(c, s->lights[scene->num_lights].direction, 3)) return "expected: light <x> <y> <z>";
+        scene->num_lights++;
+    } else if (token_is(word, "mesh")) {
+        token_t name, generator;
+        if (scene->num_meshes == SCENE_MAX_MESHES) return "too many meshes";
+        if (!next_token(c, &name) || !next_token(c, &generator)) return "expected: mesh <name> <generator> ...";
+        if (find_mesh(c, s, scene->num_meshes, name) >= 0) return "mesh name already used";
+        scene_mesh_t *m = &s->meshes[scene->num_meshes];
+        m->name_offset = (uint32_t)(name.p - c->base);
+        m->name_length = (uint32_t)name.len;
+        const char *error = parse_mesh(c, generator, m);
+        if (error) return error;
+        scene->num_meshes++;
+    } else if (token_is(word, "path")) {
+        token_t name, type;
+        if (scene->num_paths == SCENE_MAX_PATHS) return "too many paths";
+        if (!next_token(c, &name) || !next_token(c, &type)) return "expected: path <name> <type> <x y z>...";
+        if (find_path(c, s, scene->num_paths, name) >= 0) return "path name already used";
+        scene_path_t *p = &s->paths[scene->num_paths];
+        if (token_is(type, "bezier")) p->type = PATH_BEZIER;
+        else if (token_is(type, "catmull-rom")) p->type = PATH_CATMULL_ROM;
+        else if (token_is(type, "bspline")) p->type = PATH_BSPLINE;
+        else return "path type must be bezier, catmull-rom or bspline";
+        p->name_offset = (uint32_t)(name.p - c->base);
+        p->name_length = (uint32_t)name.len;
+        p->first_point = scene->num_points;
+        p->num_points = 0;
+        for (;;) {
+            float xyz[3];
+            int k = 0;
+            for (; k < 3 && next_token(c, &t); ++k) {
+                if (!token_float(t, &xyz[k])) return "bad path coordinate";
+            }
+            if (k == 0) break;
+            if (k < 3) return "path points need x, y and z";
+            if (scene->num_points == SCENE_MAX_POINTS) return "too many path points";
+            memcpy(s->points + 3 * scene->num_points++, xyz, sizeof(xyz));
+            p->num_points++;
+        }
+        bool valid = p->type == PATH_BEZIER ? p->num_points >= 4 && (p->num_points - 1) % 3 == 0
+                   : p->type == PATH_BSPLINE ? p->num_points >= 4 : p->num_points >= 2;
+        if (!valid) return "wrong number of path points (bezier 3n+1, bspline >= 4, catmull-rom >= 2)";
+        scene->num_paths++;
+    } else if (token_is(word, "instance")) {
+        token_t mesh;
+        if (scene->num_instances == SCENE_MAX_INSTANCES) return "too many instances";
+        if (!next_token(c, &mesh)) return "expected: instance <mesh> [key=value]...";
+        scene_instance_t *inst = &s->instances[scene->num_instances];
+        *inst = (scene_instance_t){0, -1, SCENE_DRAW_WIRE, EASE_LINEAR, {0, 0, 0}, 1.0f, {0, 0, 0}, 1.0f};
+        inst->mesh = find_mesh(c, s, scene->num_meshes, mesh);
+        if (inst->mesh < 0) return "unknown mesh";
+        while (next_token(c, &t)) {
+            const char *error = parse_instance_key(c, s, scene->num_paths, t, inst);
+            if (error) return error;
+        }
+        scene->num_instances++;
+    } else {
+        return "unknown directive";
+    }
+    return NULL;
+}
+
+// Build the runtime state shared by both formats
+static bool scene_finish(scene_t *scene) {
+    int lights = scene->num_lights > 0 ? scene->num_lights : 1;
+    scene->light_dirs = malloc(lights * sizeof(vec3));
+    scene->curves = calloc(scene->num_paths > 0 ? scene->num_paths : 1, sizeof(curve_path_t *));
+    scene->objects = calloc(scene->num_meshes > 0 ? scene->num_meshes : 1, sizeof(object3d_t *));
+    if (!scene->light_dirs || !scene->curves || !scene->objects) return false;
+
+    for (int i = 0; i < scene->num_lights; ++i) {
+        const float *d = scene->lights[i].direction;
+        scene->light_dirs[i] = vec3_normalize(vec3_from_cartesian(d[0], d[1], d[2]));
+    }
+    for (int i = 0; i < scene->num_paths; ++i) {
+        const scene_path_t *p = &scene->paths[i];
+        if (p->type == PATH_BEZIER) continue;
+        scene->curves[i] = curve_path_create(p->type, scene->points + 3 * p->first_point, p->num_points);
+        if (!scene->curves[i]) return false;
+    }
+    return true;
+}
+
+// Parse text with names relative to base (the mapping or the caller's buffer)
+static scene_t *parse_text(const char *text, size_t length, const char *filename) {
+    scene_t *scene = calloc(1, sizeof(scene_t));
+    scene_storage_t *s = malloc(sizeof(scene_storage_t));
+    if (!scene || !s) {
+        free(scene);
+        free(s);
+        return NULL;
+    }
+    scene->storage = s;
+    scene->settings = default_settings;
+    scene->meshes = s->meshes;
+    scene->paths = s->paths;
+    scene->points = s->points;
+    scene->instances = s->instances;
+    scene->lights = s->lights;
+    scene->strings = text;
+
+    cursor_t c = {text, text + length, text, 1};
+    while (c.p < c.end) {
+        token_t word;
+        if (next_token(&c, &word)) {
+            const char *error = parse_directive(&c, word, scene, s);
+            if (error) {
+                fprintf(stderr, "%s:%d: %s\n", filename, c.line, error);
+                scene_destroy(scene);
+                return NULL;
+            }
+        }
+        next_line(&c);
+    }
+    if (!scene_finish(scene)) {
+        fprintf(stderr, "%s: out of memory\n", filename);
+        scene_destroy(scene);
+        return NULL;
+    }
+    return scene;
+}
+
+scene_t *scene_parse(const char *text, size_t length) {
+    if (text == NULL) return NULL;
+    return parse_text(text, length, "<scene>");
+}
+
+// =======================
+// Binary Form
+// =======================
+
+// Check that count records of size bytes at offset lie inside the file
+static bool section_ok(size_t file_size, uint32_t offset, uint32_t count, size_t size) {
+    return offset % 4 == 0 && offset <= file_size && count <= (file_size - offset) / size;
+}
+
+// Use the records of a mapped binary scene in place after validating them
+static scene_t *parse_binary(const void *data, size_t size, const char *filename) {
+    const scene_binary_header_t *h = data;
+    const char *base = data;
+    const char *error = NULL;
+    if (size < sizeof(*h) || h->version != SCENE_BINARY_VERSION) {
+        error = "unsupported binary scene version";
+    } else if (h->num_meshes > SCENE_MAX_MESHES || h->num_paths > SCENE_MAX_PATHS || h->num_points > SCENE_MAX_POINTS ||
+               h->num_instances > SCENE_MAX_INSTANCES || h->num_lights > SCENE_MAX_LIGHTS) {
+        error = "too many records";
+    } else if (!section_ok(size, h->meshes_offset, h->num_meshes, sizeof(scene_mesh_t)) ||
+               !section_ok(size, h->paths_offset, h->num_paths, sizeof(scene_path_t)) ||
+               !section_ok(size, h->points_offset, h->num_points, 3 * sizeof(float)) ||
+               !section_ok(size, h->instances_offset, h->num_instances, sizeof(scene_instance_t)) ||
+               !section_ok(size, h->lights_offset, h->num_lights, sizeof(scene_light_t)) ||
+               h->strings_offset > size || h->strings_size > size - h->strings_offset) {
+        error = "truncated binary scene";
+    } else if (h->settings.width < 1 || h->settings.height < 1 || h->settings.frames < 1) {
+        error = "bad canvas size or frame count";
+    }
+    if (error) {
+        fprintf(stderr, "%s: %s\n", filename, error);
+        return NULL;
+    }
+
+    const scene_mesh_t *meshes = (const scene_mesh_t *)(base + h->meshes_offset);
+    const scene_path_t *paths = (const scene_path_t *)(base + h->paths_offset);
+    const scene_instance_t *instances = (const scene_instance_t *)(base + h->instances_offset);
+    for (uint32_t i = 0; !error && i < h->num_meshes; ++i) {
+        if (meshes[i].type < 0 || meshes[i].type >= SCENE_MESH_TYPE_COUNT ||
+            meshes[i].name_offset > h->strings_size || meshes[i].name_length > h->strings_size - meshes[i].name_offset) {
+            error = "bad mesh record";
+        }
+    }
+    for (uint32_t i = 0; !error && i < h->num_paths; ++i) {
+        const scene_path_t *p = &paths[i];
+        if (p->type < PATH_BEZIER || p->type > PATH_BSPLINE || p->first_point < 0 || p->num_points < 2 ||
+            p->num_points > (int32_t)h->num_points - p->first_point ||
+            (p->type == PATH_BEZIER && (p->num_points - 1) % 3 != 0) || (p->type == PATH_BSPLINE && p->num_points < 4) ||
+            p->name_offset > h->strings_size || p->name_length > h->strings_size - p->name_offset) {
+            error = "bad path record";
+        }
+    }
+    for (uint32_t i = 0; !error && i < h->num_instances; ++i) {
+        const scene_instance_t *inst = &instances[i];
+        if (inst->mesh < 0 || inst->mesh >= (int32_t)h->num_meshes || inst->path < -1 || inst->path >= (int32_t)h->num_paths ||
+            (inst->mode != SCENE_DRAW_WIRE && inst->mode != SCENE_DRAW_SOLID) ||
+            inst->ease < EASE_LINEAR || inst->ease > EASE_IN_OUT_CUBIC) {
+            error = "bad instance record";
+        }
+    }
+    if (error) {
+        fprintf(stderr, "%s: %s\n", filename, error);
+        return NULL;
+    }
+
+    scene_t *scene = calloc(1, sizeof(scene_t));
+    if (!scene) return NULL;
+    scene->settings = h->settings;
+    scene->meshes = meshes;
+    scene->num_meshes = (int)h->num_meshes;
+    scene->paths = paths;
+    scene->num_paths = (int)h->num_paths;
+    scene->points = (const float *)(base + h->points_offset);
+    scene->num_points = (int)h->num_points;
+    scene->instances = instances;
+    scene->num_instances = (int)h->num_instances;
+    scene->lights = (const scene_light_t *)(base + h->lights_offset);
+    scene->num_lights = (int)h->num_lights;
+    scene->strings = base + h->strings_offset;
+    if (!scene_finish(scene)) {
+        fprintf(stderr, "%s: out of memory\n", filename);
+        scene_destroy(scene);
+        return NULL;
+    }
+    return scene;
+}
+
+// Round a file offset up to the record alignment
+static uint32_t align4(size_t offset) {
+    return (uint32_t)((offset + 3) & ~(size_t)3);
+}
+
+bool scene_save_binary(const scene_t *scene, const char *filename) {
+    if (scene == NULL || filename == NULL) return false;
+
+    // The string table holds the mesh names followed by the path names
+    scene_mesh_t meshes[SCENE_MAX_MESHES];
+    scene_path_t paths[SCENE_MAX_PATHS];
+    uint32_t strings_size = 0;
+    for (int i = 0; i < scene->num_meshes; ++i) {
+        meshes[i] = scene->meshes[i];
+        meshes[i].name_offset = strings_size;
+        strings_size += meshes[i].name_length;
+    }
+    for (int i = 0; i < scene->num_paths; ++i) {
+        paths[i] = scene->paths[i];
+        paths[i].name_offset = strings_size;
+        strings_size += paths[i].name_length;
+    }
+
+    scene_binary_header_t h = {{'T', '3', 'D', 'S'}, SCENE_BINARY_VERSION, scene->settings,
+                               (uint32_t)scene->num_meshes, (uint32_t)scene->num_paths, (uint32_t)scene->num_points,
+                               (uint32_t)scene->num_instances, (uint32_t)scene->num_lights,
+                               0, 0, 0, 0, 0, 0, strings_size};
+    h.meshes_offset = align4(sizeof(h));
+    h.paths_offset = align4(h.meshes_offset + scene->num_meshes * sizeof(scene_mesh_t));
+    h.points_offset = align4(h.paths_offset + scene->num_paths * sizeof(scene_path_t));
+    h.instances_offset = align4(h.points_offset + scene->num_points * 3 * sizeof(float));
+    h.lights_offset = align4(h.instances_offset + scene->num_instances * sizeof(scene_instance_t));
+    h.strings_offset = align4(h.lights_offset + scene->num_lights * sizeof(scene_light_t));
+
+    FILE *f = fopen(filename, "wb");
+    if (!f) {
+        fprintf(stderr, "Error: Could not open file %s for writing.\n", filename);
+        return false;
+    }
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    ok = ok && fwrite(meshes, sizeof(scene_mesh_t), scene->num_meshes, f) == (size_t)scene->num_meshes;
+    ok = ok && fwrite(paths, sizeof(scene_path_t), scene->num_paths, f) == (size_t)scene->num_paths;
+    ok = ok && fwrite(scene->points, 3 * sizeof(float), scene->num_points, f) == (size_t)scene->num_points;
+    ok = ok && fwrite(scene->instances, sizeof(scene_instance_t), scene->num_instances, f) == (size_t)scene->num_instances;
+    ok = ok && fwrite(scene->lights, sizeof(scene_light_t), scene->num_lights, f) == (size_t)scene->num_lights;
+    for (int i = 0; ok && i < scene->num_meshes; ++i) {
+        ok = fwrite(scene->strings + scene->meshes[i].name_offset, 1, meshes[i].name_length, f) == meshes[i].name_length;
+    }
+    for (int i = 0; ok && i < scene->num_paths; ++i) {
+        ok = fwrite(scene->strings + scene->paths[i].name_offset, 1, paths[i].name_length, f) == paths[i].name_length;
+    }
+    return fclose(f) == 0 && ok;
+}
+
+// =======================
+// Loading
+// =======================
+
+scene_t *scene_load(const char *filename) {
+    if (filename == NULL) return NULL;
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Could not open scene %s\n", filename);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        fprintf(stderr, "%s: empty or unreadable scene\n", filename);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        return NULL;
+    }
+
+    scene_t *scene = size >= 4 && memcmp(map, SCENE_BINARY_MAGIC, 4) == 0 ? parse_binary(map, size, filename)
+                                                                          : parse_text(map, size, filename);
+    if (!scene) {
+        munmap(map, size);
+        return NULL;
+    }
+    scene->map = map;
+    scene->map_size = size;
+    return scene;
+}
+
+void scene_destroy(scene_t *scene) {
+    if (scene == NULL) return;
+    if (scene->objects) {
+        for (int i = 0; i < scene->num_meshes; ++i) object3d_destroy(scene->objects[i]);
+    }
+    if (scene->curves) {
+        for (int i = 0; i < scene->num_paths; ++i) curve_path_destroy(scene->curves[i]);
+    }
+    free(scene->objects);
+    free(scene->curves);
+    free(scene->light_dirs);
+    free(scene->storage);
+    if (scene->map) munmap(scene->map, scene->map_size);
+    free(scene);
+}
+
+// =======================
+// Playback
+// =======================
+
+bool scene_build_meshes(scene_t *scene) {
+    if (scene == NULL) return false;
+    for (int i = 0; i < scene->num_meshes; ++i) {
+        if (scene->objects[i]) continue;
+        const scene_mesh_t *m = &scene->meshes[i];
+        object3d_t *object = NULL;
+        switch (m->type) {
+            case SCENE_MESH_SOCCER:    object = mesh_create_truncated_icosahedron(); break;
+            case SCENE_MESH_ICOSPHERE: object = mesh_create_icosphere(m->i[0]); break;
+            case SCENE_MESH_GRID:      object = mesh_create_grid(m->i[0], m->i[1], m->f[0], m->f[1]); break;
+            case SCENE_MESH_TORUS:     object = mesh_create_torus(m->i[0], m->i[1], m->f[0], m->f[1]); break;
+            case SCENE_MESH_CYLINDER:  object = mesh_create_cylinder(m->i[0], m->i[1], m->f[0], m->f[1], m->i[2] != 0); break;
+            case SCENE_MESH_LINES:     object = mesh_create_random_lines(m->i[0], m->f[0], m->f[1], (uint32_t)m->i[1]); break;
+        }
+        if (!object || object3d_build_edge_dirs(object) != 0 || (object->faces && object3d_build_edge_faces(object) != 0)) {
+            fprintf(stderr, "Failed to generate mesh %.*s\n", (int)m->name_length, scene->strings + m->name_offset);
+            object3d_destroy(object);
+            return false;
+        }
+        scene->objects[i] = object;
+    }
+    return true;
+}
+
+float scene_frame_time(const scene_t *scene, int frame) {
+    if (scene == NULL || scene->settings.frames < 2) return 0.0f;
+    return (float)frame / (scene->settings.frames - 1);
+}
+
+mat4 scene_view_matrix(const scene_t *scene) {
+    const float *eye = scene->settings.camera;
+    return mat4_translate(-eye[0], -eye[1], -eye[2]);
+}
+
+mat4 scene_projection_matrix(const scene_t *scene) {
+    const float *p = scene->settings.perspective;
+    return mat4_perspective(p[0], p[1], p[2], p[3], p[4], p[5]);
+}
+
+void scene_path_eval(const scene_t *scene, int path, float t, float out[3]) {
+    const scene_path_t *p = &scene->paths[path];
+    if (p->type != PATH_BEZIER) {
+        curve_path_eval(scene->curves[path], t, out);
+        return;
+    }
+
+    // Bernstein form per segment, the same blend as bezier_cubic
+    int segments = (p->num_points - 1) / 3;
+    float u = fmaxf(0.0f, fminf(1.0f, t)) * segments;
+    int s = (int)u < segments ? (int)u : segments - 1;
+    const float *q = scene->points + 3 * (p->first_point + 3 * s);
+    vec3 v = bezier_cubic((vec3){q[0], q[1], q[2], 0, 0, 0, true, false}, (vec3){q[3], q[4], q[5], 0, 0, 0, true, false},
+                          (vec3){q[6], q[7], q[8], 0, 0, 0, true, false}, (vec3){q[9], q[10], q[11], 0, 0, 0, true, false},
+                          segments == 1 ? t : u - s);
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+mat4 scene_instance_matrix(const scene_t *scene, int instance, float t) {
+    const scene_instance_t *inst = &scene->instances[instance];
+    float position[3] = {inst->at[0], inst->at[1], inst->at[2]};
+    if (inst->path >= 0) {
+        float p[3];
+        scene_path_eval(scene, inst->path, t, p);
+        position[0] += p[0];
+        position[1] += p[1];
+        position[2] += p[2];
+    }
+    float turn = (float)(2.0 * M_PI * ease_apply((ease_t)inst->ease, t));
+    mat4 model = mat4_translate(position[0], position[1], position[2]);
+    model = mat4_mul(model, mat4_scale(inst->scale, inst->scale, inst->scale));
+    return mat4_mul(model, mat4_rotate_xyz(turn * inst->spin[0], turn * inst->spin[1], turn * inst->spin[2]));
+}
+
+void scene_render_frame(scene_t *scene, canvas_t *canvas, int frame) {
+    if (scene == NULL || canvas == NULL) return;
+    mat4 view = scene_view_matrix(scene);
+    mat4 proj = scene_projection_matrix(scene);
+    float t = scene_frame_time(scene, frame);
+    render_context_t ctx;
+    render_context_init(&ctx);
+    ctx.stats = canvas->stats;
+
+    for (int i = 0; i < scene->num_instances; ++i) {
+        const scene_instance_t *inst = &scene->instances[i];
+        object3d_t *object = scene->objects[inst->mesh];
+        if (object == NULL) continue; // scene_build_meshes not called or failed
+        mat4 model = scene_instance_matrix(scene, i, t);
+        if (inst->mode == SCENE_DRAW_SOLID && object->faces && canvas_enable_depth(canvas)) {
+            render_solid(&ctx, canvas, object, model, view, proj, scene->light_dirs, scene->num_lights);
+        } else {
+            render_wireframe(canvas, object, model, view, proj, inst->thickness, scene->light_dirs, scene->num_lights);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <stdlib.h>
+#include <string.h>
+#include "tiny3d.h"
+#include "scenegraph.h"
+
+// Create an empty graph
+scene_graph_t *scene_graph_create(void) {
+    return calloc(1, sizeof(scene_graph_t));
+}
+
+// Free a graph
+void scene_graph_destroy(scene_graph_t *graph) {
+    if (!graph) return;
+    free(graph->parent);
+    free(graph->depth);
+    free(graph->local);
+    free(graph->world);
+    free(graph->dirty);
+    free(graph->draw);
+    free(graph);
+}
+
+// Grow every per-node array to a new capacity
+static bool scene_graph_reserve(scene_graph_t *graph, int capacity) {
+    int *parent = realloc(graph->parent, capacity * sizeof(int));
+    if (parent) graph->parent = parent;
+    int *depth = realloc(graph->depth, capacity * sizeof(int));
+    if (depth) graph->depth = depth;
+    mat4 *local = realloc(graph->local, capacity * sizeof(mat4));
+    if (local) graph->local = local;
+    mat4 *world = realloc(graph->world, capacity * sizeof(mat4));
+    if (world) graph->world = world;
+    unsigned char *dirty = realloc(graph->dirty, capacity);
+    if (dirty) graph->dirty = dirty;
+    draw_handle_t *draw = realloc(graph->draw, capacity * sizeof(draw_handle_t));
+    if (draw) graph->draw = draw;
+
+    // Arrays that did grow stay valid at their old contents, so a failure leaves the graph usable
+    if (!parent || !depth || !local || !world || !dirty || !draw) return false;
+    graph->capacity = capacity;
+    return true;
+}
+
+// Add a node
+scene_node_t scene_graph_add(scene_graph_t *graph, scene_node_t parent, mat4 local) {
+    if (graph == NULL || parent < -1 || parent >= graph->count) return -1;
+    if (graph->count == graph->capacity && !scene_graph_reserve(graph, graph->capacity ? 2 * graph->capacity : 16)) {
+        return -1;
+    }
+
+    int node = graph->count++;
+    graph->parent[node] = parent;
+    graph->depth[node] = parent >= 0 ? graph->depth[parent] + 1 : 0;
+    graph->local[node] = local;
+    graph->world[node] = local;
+    graph->dirty[node] = 1;
+    graph->draw[node] = -1;
+    return node;
+}
+
+// Replace a node's local transform
+void scene_graph_set_local(scene_graph_t *graph, scene_node_t node, mat4 local) {
+    if (graph == NULL || node < 0 || node >= graph->count) return;
+    graph->local[node] = local;
+    graph->dirty[node] = 1;
+}
+
+// Set a node's local transform from its components
+void scene_graph_set_trs(scene_graph_t *graph, scene_node_t node, const float translation[3], quat rotation, const float scale[3]) {
+    scene_graph_set_local(graph, node, mat4_from_trs(translation, rotation, scale));
+}
+
+// Drive a display list command
+void scene_graph_bind(scene_graph_t *graph, scene_node_t node, draw_handle_t handle) {
+    if (graph == NULL || node < 0 || node >= graph->count) return;
+    graph->draw[node] = handle;
+    graph->dirty[node] = 1; // Push the transform on the next update
+}
+
+// Recompute dirty subtrees
+int scene_graph_update(scene_graph_t *graph, display_list_t *list) {
+    if (graph == NULL) return 0;
+    int updated = 0;
+
+    // Parents precede children, so a dirty parent has already been recomputed (and kept its dirty flag
+    // until the end of the pass) when its children are visited
+    for (int i = 0; i < graph->count; ++i) {
+        int p = graph->parent[i];
+        if (!graph->dirty[i] && (p < 0 || !graph->dirty[p])) continue;
+
+        graph->world[i] = p >= 0 ? mat4_mul(graph->world[p], graph->local[i]) : graph->local[i];
+        graph->dirty[i] = 1; // Propagate to the children later in the array
+        if (list != NULL && graph->draw[i] >= 0) {
+            display_list_set_transform(list, graph->draw[i], graph->world[i]);
+        }
+        updated++;
+    }
+
+    memset(graph->dirty, 0, graph->count);
+    return updated;
+}
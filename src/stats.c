@@ -0,0 +1,145 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tiny3d.h"
+#include "stats.h"
+
+// Stage names in render_stage_t order
+static const char *STAGE_NAMES[STAGE_COUNT] = {
+    "clear", "transform", "cull", "project", "lighting", "sort", "raster", "composite", "save"
+};
+
+// Zero all counters
+void render_stats_init(render_stats_t *stats) {
+    if (stats == NULL) return;
+    memset(stats, 0, sizeof(*stats));
+}
+
+// Release the trace buffers
+void render_stats_free(render_stats_t *stats) {
+    if (stats == NULL) return;
+    free(stats->events);
+    free(stats->frame_marks);
+    render_stats_init(stats);
+}
+
+// Zero counters, keep buffers and the trace setting
+void render_stats_reset(render_stats_t *stats) {
+    if (stats == NULL) return;
+    render_stats_t keep = *stats;
+    render_stats_init(stats);
+    stats->trace = keep.trace;
+    stats->events = keep.events;
+    stats->event_capacity = keep.event_capacity;
+    stats->frame_marks = keep.frame_marks;
+    stats->frame_capacity = keep.frame_capacity;
+}
+
+// Monotonic clock
+double render_stats_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Start of a frame
+void render_stats_frame(render_stats_t *stats) {
+    if (stats == NULL) return;
+    stats->frames++;
+    if (!stats->trace) return;
+
+    if (stats->num_frames == stats->frame_capacity) {
+        int capacity = stats->frame_capacity ? 2 * stats->frame_capacity : 64;
+        double *marks = realloc(stats->frame_marks, capacity * sizeof(double));
+        if (!marks) return; // Out of memory: the trace just loses this mark
+        stats->frame_marks = marks;
+        stats->frame_capacity = capacity;
+    }
+    stats->frame_marks[stats->num_frames++] = render_stats_now();
+}
+
+// Add an interval to a stage
+void render_stats_record(render_stats_t *stats, render_stage_t stage, double start_ns) {
+    if (stats == NULL || stage < 0 || stage >= STAGE_COUNT) return;
+    double duration = render_stats_now() - start_ns;
+    stats->stage_ns[stage] += duration;
+    stats->stage_calls[stage]++;
+    if (!stats->trace) return;
+
+    if (stats->num_events == stats->event_capacity) {
+        int capacity = stats->event_capacity ? 2 * stats->event_capacity : 256;
+        render_trace_event_t *events = realloc(stats->events, capacity * sizeof(render_trace_event_t));
+        if (!events) return;
+        stats->events = events;
+        stats->event_capacity = capacity;
+    }
+    stats->events[stats->num_events++] = (render_trace_event_t){stage, start_ns, duration};
+}
+
+// Name of a stage
+const char *render_stage_name(render_stage_t stage) {
+    return stage >= 0 && stage < STAGE_COUNT ? STAGE_NAMES[stage] : "unknown";
+}
+
+// Print a summary
+void render_stats_print(const render_stats_t *stats) {
+    if (stats == NULL) return;
+    double total = 0.0;
+    for (int s = 0; s < STAGE_COUNT; ++s) total += stats->stage_ns[s];
+
+    printf("%-10s %12s %8s %10s\n", "stage", "ms", "share", "calls");
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        if (stats->stage_calls[s] == 0) continue;
+        printf("%-10s %12.3f %7.1f%% %10llu\n", STAGE_NAMES[s], stats->stage_ns[s] * 1e-6,
+               total > 0.0 ? 100.0 * stats->stage_ns[s] / total : 0.0, (unsigned long long)stats->stage_calls[s]);
+    }
+    printf("frames %llu, vertices %llu, edges %llu (culled %llu), lines %llu, triangles %llu, points %llu\n",
+           (unsigned long long)stats->frames, (unsigned long long)stats->vertices_transformed,
+           (unsigned long long)stats->edges_submitted, (unsigned long long)stats->edges_culled,
+           (unsigned long long)stats->lines_drawn, (unsigned long long)stats->triangles_drawn,
+           (unsigned long long)stats->points_drawn);
+    printf("pixels written %llu, bytes written %llu\n",
+           (unsigned long long)stats->pixels_written, (unsigned long long)stats->bytes_written);
+}
+
+// Export the intervals as complete ("X") events, frames as instant ("i") events, in microseconds
+bool render_stats_write_trace(const render_stats_t *stats, const char *filename) {
+    if (stats == NULL || filename == NULL) return false;
+    FILE *f = fopen(filename, "w");
+    if (!f) {
+        fprintf(stderr, "Error: Could not open file %s for writing.\n", filename);
+        return false;
+    }
+
+    // Timestamps relative to the first recorded event
+    double origin = 0.0;
+    bool have_origin = false;
+    if (stats->num_events > 0) {
+        origin = stats->events[0].start_ns;
+        have_origin = true;
+    }
+    if (stats->num_frames > 0 && (!have_origin || stats->frame_marks[0] < origin)) {
+        origin = stats->frame_marks[0];
+    }
+
+    fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    bool first = true;
+    for (int i = 0; i < stats->num_frames; ++i) {
+        fprintf(f, "%s  {\"name\": \"frame %d\", \"cat\": \"frame\", \"ph\": \"i\", \"s\": \"g\", \"ts\": %.3f, \"pid\": 1, \"tid\": 1}",
+                first ? "" : ",\n", i, (stats->frame_marks[i] - origin) * 1e-3);
+        first = false;
+    }
+    for (int i = 0; i < stats->num_events; ++i) {
+        const render_trace_event_t *e = &stats->events[i];
+        fprintf(f, "%s  {\"name\": \"%s\", \"cat\": \"render\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": 1}",
+                first ? "" : ",\n", render_stage_name(e->stage), (e->start_ns - origin) * 1e-3, e->duration_ns * 1e-3);
+        first = false;
+    }
+    fprintf(f, "\n]}\n");
+
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
@@ -0,0 +1,232 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tiny3d.h"
+#include "timeline.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Floats per transform in timeline_t.trs
+#define TRS_FLOATS 10
+
+// Floats per key of each track type
+static int track_width(track_type_t type) {
+    switch (type) {
+        case TRACK_ROTATION: return 4;
+        case TRACK_FLOAT:    return 1;
+        default:             return 3;
+    }
+}
+
+// Eased parameter
+float ease_apply(ease_t ease, float t) {
+    t = fmaxf(0.0f, fminf(1.0f, t));
+    switch (ease) {
+        case EASE_STEP:         return 0.0f;
+        case EASE_IN_QUAD:      return t * t;
+        case EASE_OUT_QUAD:     return t * (2.0f - t);
+        case EASE_IN_OUT_SINE:  return (1.0f - cosf(t * (float)M_PI)) * 0.5f;
+        case EASE_IN_OUT_CUBIC: return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * (1.0f - t) * (1.0f - t) * (1.0f - t);
+        default:                return t;
+    }
+}
+
+// Create a timeline
+timeline_t *timeline_create(int num_transforms, int num_floats) {
+    if (num_transforms < 0 || num_floats < 0) return NULL;
+
+    timeline_t *timeline = calloc(1, sizeof(timeline_t));
+    if (!timeline) return NULL;
+    timeline->num_transforms = num_transforms;
+    timeline->num_floats = num_floats;
+    timeline->trs = malloc((num_transforms > 0 ? num_transforms : 1) * TRS_FLOATS * sizeof(float));
+    timeline->matrices = malloc((num_transforms > 0 ? num_transforms : 1) * sizeof(mat4));
+    timeline->dirty = calloc(num_transforms > 0 ? num_transforms : 1, 1);
+    timeline->floats = calloc(num_floats > 0 ? num_floats : 1, sizeof(float));
+    if (!timeline->trs || !timeline->matrices || !timeline->dirty || !timeline->floats) {
+        timeline_destroy(timeline);
+        return NULL;
+    }
+
+    // Identity transforms until tracks say otherwise
+    for (int i = 0; i < num_transforms; ++i) {
+        float *trs = timeline->trs + TRS_FLOATS * i;
+        const float identity[TRS_FLOATS] = {0, 0, 0,  0, 0, 0, 1,  1, 1, 1};
+        memcpy(trs, identity, sizeof(identity));
+        timeline->matrices[i] = mat4_identity();
+    }
+    return timeline;
+}
+
+// Free a timeline
+void timeline_destroy(timeline_t *timeline) {
+    if (!timeline) return;
+    for (int i = 0; i < timeline->num_tracks; ++i) {
+        free(timeline->tracks[i].times);
+    }
+    free(timeline->tracks);
+    free(timeline->trs);
+    free(timeline->matrices);
+    free(timeline->dirty);
+    free(timeline->floats);
+    free(timeline);
+}
+
+// Add a track
+int timeline_add_track(timeline_t *timeline, track_type_t type, int target,
+                       const float *times, const float *values, const ease_t *easing, int num_keys) {
+    if (timeline == NULL || times == NULL || values == NULL || num_keys < 1) return -1;
+
+    int width = track_width(type);
+    bool transform_track = type == TRACK_POSITION || type == TRACK_ROTATION || type == TRACK_SCALE;
+    if (transform_track ? (target < 0 || target >= timeline->num_transforms)
+                        : (target < 0 || target + width > timeline->num_floats)) {
+        return -1;
+    }
+
+    // Grow the track array
+    if (timeline->num_tracks == timeline->track_capacity) {
+        int capacity = timeline->track_capacity ? 2 * timeline->track_capacity : 8;
+        anim_track_t *tracks = realloc(timeline->tracks, capacity * sizeof(anim_track_t));
+        if (!tracks) return -1;
+        timeline->tracks = tracks;
+        timeline->track_capacity = capacity;
+    }
+
+    // Times, values and easings share one block
+    float *block = malloc(num_keys * (1 + width) * sizeof(float) + num_keys);
+    if (!block) return -1;
+
+    anim_track_t *track = &timeline->tracks[timeline->num_tracks];
+    track->type = type;
+    track->target = target;
+    track->num_keys = num_keys;
+    track->times = block;
+    track->values = block + num_keys;
+    track->easing = (unsigned char *)(track->values + num_keys * width);
+    track->cursor = 0;
+    memcpy(track->times, times, num_keys * sizeof(float));
+    memcpy(track->values, values, num_keys * width * sizeof(float));
+    for (int k = 0; k < num_keys; ++k) {
+        track->easing[k] = (unsigned char)(easing ? easing[k] : EASE_LINEAR);
+    }
+
+    // Rotation keys: unit length, each on the same side as its predecessor so slerp takes the short way
+    if (type == TRACK_ROTATION) {
+        for (int k = 0; k < num_keys; ++k) {
+            float *q = track->values + 4 * k;
+            quat n = quat_normalize((quat){q[0], q[1], q[2], q[3]});
+            if (k > 0 && n.x * q[-4] + n.y * q[-3] + n.z * q[-2] + n.w * q[-1] < 0.0f) {
+                n = (quat){-n.x, -n.y, -n.z, -n.w};
+            }
+            q[0] = n.x;
+            q[1] = n.y;
+            q[2] = n.z;
+            q[3] = n.w;
+        }
+    }
+
+    if (times[num_keys - 1] > timeline->duration) {
+        timeline->duration = times[num_keys - 1];
+    }
+    return timeline->num_tracks++;
+}
+
+// Segment k with times[k] <= time < times[k + 1], starting from the cursor.
+// Playback moves at most a key or two per frame, so the walk is O(1); long jumps fall back to binary search.
+static int track_seek(anim_track_t *track, float time) {
+    const float *times = track->times;
+    int last = track->num_keys - 2; // Last segment
+    int k = track->cursor;
+    if (k > last) k = last;
+
+    if (time >= times[k]) {
+        for (int step = 0; step < 2 && k < last && time >= times[k + 1]; ++step) k++;
+        if (k < last && time >= times[k + 1]) {
+            int lo = k + 1, hi = last;
+            while (lo < hi) {
+                int mid = (lo + hi + 1) / 2;
+                if (times[mid] <= time) lo = mid; else hi = mid - 1;
+            }
+            k = lo;
+        }
+    } else if (k > 0 && time >= times[k - 1]) {
+        k--;
+    } else {
+        int lo = 0, hi = k;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (times[mid] <= time) lo = mid; else hi = mid - 1;
+        }
+        k = lo;
+    }
+
+    track->cursor = k;
+    return k;
+}
+
+// Evaluate all tracks
+void timeline_evaluate(timeline_t *timeline, float time) {
+    if (timeline == NULL) return;
+    if (timeline->loop && timeline->duration > 0.0f) {
+        time = fmodf(time, timeline->duration);
+        if (time < 0.0f) time += timeline->duration;
+    }
+
+    for (int i = 0; i < timeline->num_tracks; ++i) {
+        anim_track_t *track = &timeline->tracks[i];
+        int width = track_width(track->type);
+
+        // Destination of this track's value
+        float *out;
+        if (track->type == TRACK_FLOAT || track->type == TRACK_VEC3) {
+            out = timeline->floats + track->target;
+        } else {
+            float *trs = timeline->trs + TRS_FLOATS * track->target;
+            out = track->type == TRACK_POSITION ? trs : track->type == TRACK_ROTATION ? trs + 3 : trs + 7;
+            timeline->dirty[track->target] = 1;
+        }
+
+        // Before the first key, after the last, or a single key: hold
+        const float *a;
+        if (track->num_keys == 1 || time <= track->times[0]) {
+            a = track->values;
+            memcpy(out, a, width * sizeof(float));
+            continue;
+        }
+        if (time >= track->times[track->num_keys - 1]) {
+            a = track->values + (track->num_keys - 1) * width;
+            memcpy(out, a, width * sizeof(float));
+            continue;
+        }
+
+        int k = track_seek(track, time);
+        float span = track->times[k + 1] - track->times[k];
+        float t = span > 0.0f ? (time - track->times[k]) / span : 1.0f;
+        t = ease_apply((ease_t)track->easing[k], t);
+        a = track->values + k * width;
+        const float *b = a + width;
+
+        if (track->type == TRACK_ROTATION) {
+            quat q = quat_slerp((quat){a[0], a[1], a[2], a[3]}, (quat){b[0], b[1], b[2], b[3]}, t);
+            out[0] = q.x;
+            out[1] = q.y;
+            out[2] = q.z;
+            out[3] = q.w;
+        } else {
+            for (int c = 0; c < width; ++c) {
+                out[c] = a[c] + (b[c] - a[c]) * t;
+            }
+        }
+    }
+
+    // Rebuild the matrices of animated transforms in one pass
+    for (int i = 0; i < timeline->num_transforms; ++i) {
+        if (!timeline->dirty[i]) continue;
+        const float *trs = timeline->trs + TRS_FLOATS * i;
+        timeline->matrices[i] = mat4_from_trs(trs, (quat){trs[3], trs[4], trs[5], trs[6]}, trs + 7);
+        timeline->dirty[i] = 0;
+    }
+}
@@ -50,7 +50,7 @@ int main() {
     }
 
     // Set the background color to white
-    object3d_t cube;
+    object3d_t cube = {0};
     generate_cube(&cube);
 
     // Camera: move back along z-axis
@@ -63,6 +63,12 @@ int main() {
     vec3 light_dirs[1] = { vec3_from_cartesian(0.0f, 0.0f, -1.0f) };
     int num_lights = 1;
 
+    // Animated GIF of the same frames (4/100 s per frame, looping)
+    gif_writer_t *gif = gif_writer_create("cube_visualize.gif", WIDTH, HEIGHT, 4, 0, 8);
+    if (!gif) {
+        fprintf(stderr, "Failed to create cube_visualize.gif.\n");
+    }
+
     // Render frames of the rotating cube
     for (int frame = 0; frame < NUM_FRAMES; ++frame) {
         canvas_clear(canvas);
@@ -79,7 +85,9 @@ int main() {
         snprintf(filename, sizeof(filename), "cube_frame_%03d.pgm", frame);
         canvas_save_pgm(canvas, filename);
         printf("Saved %s\n", filename);
+        if (gif) gif_writer_add_frame(gif, canvas);
     }
+    if (gif && gif_writer_close(gif)) printf("Saved cube_visualize.gif\n");
 
     free(cube.vertices);
     free(cube.indices);
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "tiny3d.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define NUM_SAMPLES 1000
+
+// Largest distance between matching points of two sample arrays
+static float max_point_error(const float *a, const float *b, int count) {
+    float err = 0.0f;
+    for (int i = 0; i < 3 * count; ++i)
+        err = fmaxf(err, fabsf(a[i] - b[i]));
+    return err;
+}
+
+int main() {
+    printf("=== Testing curves and paths ===\n");
+
+    // ===========================================
+    // Test 1: Power-form segment matches bezier_cubic
+    // ===========================================
+    float p[4][3] = { {-1.5f, -0.5f, 0.0f}, {-0.5f, 1.0f, -1.0f}, {-0.5f, 1.0f, 1.0f}, {-1.5f, -0.5f, 0.0f} };
+    curve_segment_t seg = curve_segment_bezier(p[0], p[1], p[2], p[3]);
+    float max_err = 0.0f;
+    for (int i = 0; i <= 10; ++i) {
+        float t = i / 10.0f;
+        vec3 ref = bezier_cubic(vec3_from_cartesian(p[0][0], p[0][1], p[0][2]), vec3_from_cartesian(p[1][0], p[1][1], p[1][2]),
+                                vec3_from_cartesian(p[2][0], p[2][1], p[2][2]), vec3_from_cartesian(p[3][0], p[3][1], p[3][2]), t);
+        float out[3];
+        curve_segment_eval(&seg, t, out);
+        max_err = fmaxf(max_err, fmaxf(fabsf(out[0] - ref.x), fmaxf(fabsf(out[1] - ref.y), fabsf(out[2] - ref.z))));
+    }
+    printf("segment vs bezier_cubic max error: %g\n", max_err);
+
+    // ===========================================
+    // Test 2: Forward differencing matches direct evaluation
+    // ===========================================
+    float *fd = malloc(NUM_SAMPLES * 3 * sizeof(float));
+    float *direct = malloc(NUM_SAMPLES * 3 * sizeof(float));
+    curve_segment_sample(&seg, NUM_SAMPLES, fd);
+    for (int i = 0; i < NUM_SAMPLES; ++i)
+        curve_segment_eval(&seg, (float)i / (NUM_SAMPLES - 1), direct + 3 * i);
+    printf("segment forward differencing max error: %g\n", max_point_error(fd, direct, NUM_SAMPLES));
+
+    // ===========================================
+    // Test 3: Multi-segment paths
+    // ===========================================
+    float keys[6][3] = { {0, 0, 0}, {1, 2, 0}, {3, 2, 1}, {4, 0, 1}, {6, -1, 0}, {8, 0, 0} };
+    curve_path_t *catmull = curve_path_create(PATH_CATMULL_ROM, &keys[0][0], 6);
+    curve_path_t *bspline = curve_path_create(PATH_BSPLINE, &keys[0][0], 6);
+    if (!catmull || !bspline) {
+        fprintf(stderr, "Failed to create paths\n");
+        return 1;
+    }
+    printf("catmull-rom segments: %d, b-spline segments: %d\n", catmull->num_segments, bspline->num_segments);
+
+    float through = 0.0f;
+    for (int k = 0; k < 6; ++k) {
+        float out[3];
+        curve_path_eval(catmull, (float)k / 5, out);
+        through = fmaxf(through, fmaxf(fabsf(out[0] - keys[k][0]), fmaxf(fabsf(out[1] - keys[k][1]), fabsf(out[2] - keys[k][2]))));
+    }
+    printf("catmull-rom distance from keys: %g\n", through);
+
+    curve_path_sample(catmull, NUM_SAMPLES, fd);
+    for (int i = 0; i < NUM_SAMPLES; ++i)
+        curve_path_eval(catmull, (float)i / (NUM_SAMPLES - 1), direct + 3 * i);
+    printf("path forward differencing max error: %g\n", max_point_error(fd, direct, NUM_SAMPLES));
+
+    // Without a table the distance maps linearly onto u instead of sticking at the start
+    float halfway[3], linear[3];
+    curve_path_eval_distance(catmull, 0.5f * catmull->length, halfway);
+    curve_path_eval(catmull, 0.5f, linear);
+    printf("untabled length %.4f, half length at u = 0.5: %s\n", catmull->length,
+           max_point_error(halfway, linear, 1) < 1e-5f ? "yes" : "no");
+
+    // ===========================================
+    // Test 4: Constant speed through the arc-length table
+    // ===========================================
+    if (!curve_path_build_arc_table(catmull, 64)) {
+        fprintf(stderr, "Failed to build arc-length table\n");
+        return 1;
+    }
+    const int steps = 100;
+    float step_min = 1e30f, step_max = 0.0f, raw_min = 1e30f, raw_max = 0.0f;
+    float prev[3], prev_raw[3];
+    curve_path_eval_distance(catmull, 0.0f, prev);
+    curve_path_eval(catmull, 0.0f, prev_raw);
+    for (int i = 1; i <= steps; ++i) {
+        float cur[3], cur_raw[3];
+        curve_path_eval_distance(catmull, catmull->length * i / steps, cur);
+        curve_path_eval(catmull, (float)i / steps, cur_raw);
+        float d = sqrtf((cur[0] - prev[0]) * (cur[0] - prev[0]) + (cur[1] - prev[1]) * (cur[1] - prev[1]) + (cur[2] - prev[2]) * (cur[2] - prev[2]));
+        float r = sqrtf((cur_raw[0] - prev_raw[0]) * (cur_raw[0] - prev_raw[0]) + (cur_raw[1] - prev_raw[1]) * (cur_raw[1] - prev_raw[1]) +
+                        (cur_raw[2] - prev_raw[2]) * (cur_raw[2] - prev_raw[2]));
+        step_min = fminf(step_min, d);
+        step_max = fmaxf(step_max, d);
+        raw_min = fminf(raw_min, r);
+        raw_max = fmaxf(raw_max, r);
+        for (int k = 0; k < 3; ++k) {
+            prev[k] = cur[k];
+            prev_raw[k] = cur_raw[k];
+        }
+    }
+    printf("path length: %.4f\n", catmull->length);
+    printf("step length by parameter:   %.4f .. %.4f\n", raw_min, raw_max);
+    printf("step length by arc length:  %.4f .. %.4f\n", step_min, step_max);
+
+    // ===========================================
+    // Test 5: Quaternions match the Euler matrices
+    // ===========================================
+    mat4 euler = mat4_rotate_xyz(0.7f, -1.2f, 0.4f);
+    mat4 from_quat = mat4_from_quat(quat_from_euler_xyz(0.7f, -1.2f, 0.4f));
+    float quat_err = 0.0f;
+    for (int i = 0; i < 16; ++i)
+        quat_err = fmaxf(quat_err, fabsf(euler.m[i] - from_quat.m[i]));
+    printf("quat vs euler matrix max error: %g\n", quat_err);
+
+    // ===========================================
+    // Test 6: Timeline tracks
+    // ===========================================
+    timeline_t *timeline = timeline_create(2, 1);
+    if (!timeline) {
+        fprintf(stderr, "Failed to create timeline\n");
+        return 1;
+    }
+    float pos_times[3] = {0.0f, 1.0f, 2.0f};
+    float pos_keys[9] = {0, 0, 0,  2, 0, 0,  2, 2, 0};
+    ease_t pos_ease[3] = {EASE_LINEAR, EASE_IN_OUT_SINE, EASE_LINEAR};
+    quat q0 = quat_identity(), q1 = quat_from_axis_angle(0, 1, 0, 0.5f * (float)M_PI);
+    float rot_times[2] = {0.0f, 2.0f};
+    float rot_keys[8] = {q0.x, q0.y, q0.z, q0.w, q1.x, q1.y, q1.z, q1.w};
+    float light_times[2] = {0.0f, 2.0f};
+    float light_keys[2] = {1.0f, 0.0f};
+    timeline_add_track(timeline, TRACK_POSITION, 0, pos_times, pos_keys, pos_ease, 3);
+    timeline_add_track(timeline, TRACK_ROTATION, 1, rot_times, rot_keys, NULL, 2);
+    timeline_add_track(timeline, TRACK_FLOAT, 0, light_times, light_keys, NULL, 2);
+    printf("bad target rejected: %d\n", timeline_add_track(timeline, TRACK_SCALE, 5, pos_times, pos_keys, NULL, 3));
+
+    float sample_times[5] = {0.5f, 1.5f, 1.0f, 3.0f, 0.25f};
+    for (int i = 0; i < 5; ++i) {
+        timeline_evaluate(timeline, sample_times[i]);
+        mat4 *m0 = &timeline->matrices[0];
+        mat4 *m1 = &timeline->matrices[1];
+        printf("t=%.2f position (%.3f, %.3f, %.3f) rotation x axis (%.3f, %.3f) light %.3f cursor %d\n",
+               sample_times[i], m0->m[12], m0->m[13], m0->m[14], m1->m[0], m1->m[2], timeline->floats[0],
+               timeline->tracks[0].cursor);
+    }
+
+    timeline->loop = true;
+    timeline_evaluate(timeline, 2.5f);
+    printf("looped t=2.50 position (%.3f, %.3f, %.3f)\n", timeline->matrices[0].m[12], timeline->matrices[0].m[13], timeline->matrices[0].m[14]);
+    timeline_destroy(timeline);
+
+    // ===========================================
+    // Test 7: Transform hierarchy with dirty propagation
+    // ===========================================
+    scene_graph_t *graph = scene_graph_create();
+    display_list_t *list = display_list_create();
+    if (!graph || !list) {
+        fprintf(stderr, "Failed to create scene graph\n");
+        return 1;
+    }
+    scene_node_t root = scene_graph_add(graph, -1, mat4_translate(1, 0, 0));
+    scene_node_t arm = scene_graph_add(graph, root, mat4_rotate_z(0.5f * (float)M_PI));
+    scene_node_t hand = scene_graph_add(graph, arm, mat4_translate(2, 0, 0));
+    scene_node_t other = scene_graph_add(graph, -1, mat4_identity());
+    object3d_t empty = {0};
+    scene_graph_bind(graph, hand, display_list_add_wireframe(list, &empty, mat4_identity(), 1.0f));
+    printf("first update recomputed: %d\n", scene_graph_update(graph, list));
+    printf("idle update recomputed:  %d\n", scene_graph_update(graph, list));
+
+    scene_graph_set_local(graph, other, mat4_translate(0, 0, 1));
+    printf("leaf change recomputed:  %d\n", scene_graph_update(graph, list));
+
+    float offset[3] = {0, 1, 0}, unit[3] = {1, 1, 1};
+    scene_graph_set_trs(graph, root, offset, quat_identity(), unit);
+    printf("root change recomputed:  %d\n", scene_graph_update(graph, list));
+    printf("hand world position (%.3f, %.3f, %.3f), depth %d\n",
+           graph->world[hand].m[12], graph->world[hand].m[13], graph->world[hand].m[14], graph->depth[hand]);
+    printf("display list transform y: %.3f\n", list->cmds[0].model.m[13]);
+
+    display_list_destroy(list);
+    scene_graph_destroy(graph);
+
+    free(fd);
+    free(direct);
+    curve_path_destroy(catmull);
+    curve_path_destroy(bspline);
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <cmath>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+#include "tiny3d.hpp"
+
+using namespace tiny3d;
+
+static_assert(!std::is_copy_constructible_v<Canvas> && std::is_nothrow_move_constructible_v<Canvas>);
+static_assert(!std::is_copy_assignable_v<Mesh> && std::is_nothrow_move_assignable_v<Mesh>);
+
+int main() {
+    printf("=== Testing C++ wrapper ===\n");
+
+    // ===========================================
+    // Test 1: Moving owners keeps the buffers
+    // ===========================================
+    Canvas a(64, 48);
+    color_t *first_row = a ? a.row(0).data() : nullptr;
+    Canvas b = std::move(a);
+    Canvas c;
+    c = std::move(b);
+    printf("moved canvas: source empty %s, same pixels %s, %dx%d\n", !a && !b ? "yes" : "no",
+           c && c.row(0).data() == first_row ? "yes" : "no", c.width(), c.height());
+
+    Mesh ball = Mesh::truncated_icosahedron();
+    vec3 *vertices = ball ? ball.vertices().data() : nullptr;
+    Mesh moved(std::move(ball));
+    printf("moved mesh: %d vertices, %d edges, same vertices %s\n", (int)moved.vertices().size(), moved.num_edges(),
+           moved.vertices().data() == vertices && !ball ? "yes" : "no");
+    printf("failed factory is empty: %s\n", !Mesh::icosphere(-1) && !Canvas::load_qoi("no_such_file.qoi") ? "yes" : "no");
+
+    // ===========================================
+    // Test 2: Wrapper draws match the C calls
+    // ===========================================
+    Lights<2> lights = {vec3_normalize(vec3_from_cartesian(1, 1, 1)), vec3_normalize(vec3_from_cartesian(-1, 0.5f, 0.2f))};
+    mat4 model = mat4_rotate_xyz(0.4f, 0.7f, 0.1f);
+    mat4 view = mat4_translate(0, 0, -3.5f), proj = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    Canvas wrapped(200, 200);
+    canvas_t *reference = canvas_create(200, 200);
+    render_wireframe(wrapped, moved, model, view, proj, 1.5f, lights);
+    render_wireframe(reference, moved.get(), model, view, proj, 1.5f, lights.data(), 2);
+    canvas_diff_t diff;
+    canvas_compare(wrapped.get(), reference, &diff);
+    printf("wireframe: %ld pixels differ from render_wireframe\n", diff.num_different);
+
+    Mesh sphere = Mesh::icosphere(2);
+    sphere.build_edge_faces();
+    render_context_t ctx;
+    render_context_init(&ctx);
+    wrapped.clear();
+    canvas_clear(reference);
+    render_solid(ctx, wrapped, sphere, model, view, proj, lights);
+    ::render_solid(&ctx, reference, sphere.get(), model, view, proj, lights.data(), 2);
+    canvas_compare(wrapped.get(), reference, &diff);
+    printf("solid: %ld pixels differ from render_solid\n", diff.num_different);
+
+    // ===========================================
+    // Test 3: Batch lighting and projection
+    // ===========================================
+    size_t edges = (size_t)sphere.num_edges();
+    std::vector<float> dx(edges), dy(edges), dz(edges);
+    std::span<const vec3> v = sphere.vertices();
+    std::span<const int> idx = sphere.indices();
+    for (size_t e = 0; e < edges; ++e) {
+        vec3 d = vec3_normalize(vec3_sub(v[idx[2 * e + 1]], v[idx[2 * e]]));
+        dx[e] = d.x;
+        dy[e] = d.y;
+        dz[e] = d.z;
+    }
+    std::vector<unsigned char> templated(edges), batch(edges);
+    light_edges<2>(dx, dy, dz, lights, 0.1f, templated);
+    compute_edge_lighting_batch_unit(dx.data(), dy.data(), dz.data(), (int)edges, lights.data(), 2, 0.1f, batch.data());
+    int mismatches = 0;
+    for (size_t e = 0; e < edges; ++e) mismatches += templated[e] != batch[e];
+    printf("light_edges<2>: %d of %d edges differ from compute_edge_lighting_batch_unit\n", mismatches, (int)edges);
+
+    // A camera inside the sphere: some vertices are behind it, more are off screen
+    mat4 mvp = mat4_mul(proj, mat4_mul(mat4_translate(0, 0, -0.5f), model));
+    std::vector<ScreenPoint> points(v.size());
+    std::vector<vec4> clip(v.size());
+    transform_points(mvp, v, clip);
+    size_t all = project_points<Clip::None>(mvp, v, 200, 200, points);
+    size_t in_front = project_points<Clip::Near>(mvp, v, 200, 200, points);
+    size_t expected_front = 0;
+    float max_error = 0.0f;
+    for (size_t i = 0; i < v.size(); ++i) {
+        vec4 ref = mat4_mul_vec4(mvp, vec4_from_vec3(v[i], 1.0f));
+        max_error = fmaxf(max_error, fabsf(ref.w - clip[i].w));
+        expected_front += ref.w > kWClipEpsilon;
+    }
+    for (size_t i = 0; i < in_front; ++i) {
+        vec4 ref = clip[points[i].index];
+        max_error = fmaxf(max_error, fabsf((ref.x / ref.w + 1.0f) * 100.0f - points[i].x));
+    }
+    size_t inside = project_points<Clip::Frustum>(mvp, v, 200, 200, points);
+    printf("project_points: %d of %d without clipping, near plane %s, %d inside the frustum, max error %g\n",
+           (int)all, (int)v.size(), in_front == expected_front && in_front < all ? "ok" : "wrong", (int)inside,
+           max_error);
+
+    // ===========================================
+    // Test 4: Pixel formats
+    // ===========================================
+    std::vector<unsigned char> gray(pixel_bytes<Gray8>(wrapped)), rgba(pixel_bytes<Rgba8>(wrapped));
+    bool read = read_pixels<Gray8>(wrapped, gray) && read_pixels<Rgba8>(wrapped, rgba);
+    int format_errors = 0;
+    for (int y = 0; y < wrapped.height(); ++y) {
+        for (int x = 0; x < wrapped.width(); ++x) {
+            color_t p = wrapped.row(y)[x];
+            size_t i = (size_t)y * wrapped.width() + x;
+            format_errors += gray[i] != (unsigned char)((p.r + p.g + p.b) / 3.0f);
+            format_errors += rgba[4 * i] != p.r || rgba[4 * i + 2] != p.b || rgba[4 * i + 3] != 255;
+        }
+    }
+    std::vector<unsigned char> too_small(10);
+    printf("read_pixels: %s, %d format errors, short buffer rejected %s\n", read ? "ok" : "failed", format_errors,
+           read_pixels<Rgb8>(wrapped, too_small) ? "no" : "yes");
+
+    canvas_destroy(reference);
+    printf("=== C++ wrapper tests complete ===\n");
+    return 0;
+}
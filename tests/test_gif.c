@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "tiny3d.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MAX_FRAMES 64
+
+// A decoded GIF: every frame composited onto the previous one, as a viewer shows it
+typedef struct {
+    int width, height;
+    int num_frames;
+    int loop_count;
+    unsigned char *frames[MAX_FRAMES];   // Gray values
+    int rect_pixels[MAX_FRAMES];         // Size of each frame's sub-rectangle
+} decoded_gif_t;
+
+static int get_u16(const unsigned char *p) {
+    return p[0] | (p[1] << 8);
+}
+
+// Decode one image's LZW data into count palette indices. Returns the end of its sub-blocks or NULL.
+static const unsigned char *lzw_decode(const unsigned char *p, const unsigned char *end, unsigned char *out, int count) {
+    static unsigned short prefix[4096];
+    static unsigned char suffix[4096], stack[4096];
+    int min_code_size = *p++;
+    int clear = 1 << min_code_size, code_size = min_code_size + 1, avail = clear + 2, old = -1, first = 0, n = 0;
+    unsigned int bits = 0;
+    int nbits = 0, block = 0;
+    for (int i = 0; i < clear; ++i) suffix[i] = (unsigned char)i;
+    for (;;) {
+        while (nbits < code_size) {
+            if (block == 0) {
+                if (p >= end || *p == 0) return NULL;
+                block = *p++;
+            }
+            bits |= (unsigned int)*p++ << nbits;
+            nbits += 8;
+            block--;
+        }
+        int code = bits & ((1 << code_size) - 1);
+        bits >>= code_size;
+        nbits -= code_size;
+        if (code == clear) {
+            code_size = min_code_size + 1;
+            avail = clear + 2;
+            old = -1;
+            continue;
+        }
+        if (code == clear + 1) break;
+        if (code > avail || (code == avail && old < 0)) return NULL;
+        int in = code, top = 0;
+        if (code == avail) {
+            stack[top++] = (unsigned char)first;
+            code = old;
+        }
+        while (code >= clear) {
+            stack[top++] = suffix[code];
+            code = prefix[code];
+        }
+        first = suffix[code];
+        stack[top++] = (unsigned char)first;
+        if (old >= 0 && avail < 4096) {
+            prefix[avail] = (unsigned short)old;
+            suffix[avail] = (unsigned char)first;
+            avail++;
+            if (avail >= (1 << code_size) && code_size < 12) code_size++;
+        }
+        old = in;
+        while (top > 0 && n < count) out[n++] = stack[--top];
+    }
+    // Skip the rest of the sub-blocks
+    while (block > 0 && p < end) { p++; block--; }
+    while (p < end && *p != 0) p += *p + 1;
+    return n == count && p < end ? p + 1 : NULL;
+}
+
+static bool decode_gif(const char *filename, decoded_gif_t *gif) {
+    memset(gif, 0, sizeof(*gif));
+    gif->loop_count = -1;
+    FILE *f = fopen(filename, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char *data = malloc(size);
+    bool read_ok = data && fread(data, 1, size, f) == (size_t)size;
+    fclose(f);
+    if (!read_ok || size < 13 || memcmp(data, "GIF89a", 6) != 0) {
+        free(data);
+        return false;
+    }
+
+    const unsigned char *p = data + 6, *end = data + size;
+    gif->width = get_u16(p);
+    gif->height = get_u16(p + 2);
+    int table_size = 2 << (p[4] & 7);
+    const unsigned char *palette = p + 7;
+    p = palette + 3 * table_size;
+    int transparent = -1;
+    unsigned char *shown = calloc((size_t)gif->width * gif->height, 1);
+    unsigned char *indices = malloc((size_t)gif->width * gif->height);
+    bool ok = shown && indices;
+    while (ok && p < end && *p != 0x3B) {
+        if (p[0] == 0x21 && p[1] == 0xF9) {
+            transparent = (p[3] & 1) ? p[6] : -1;
+            p += 8;
+        } else if (p[0] == 0x21) {
+            if (p[1] == 0xFF && memcmp(p + 3, "NETSCAPE2.0", 11) == 0) gif->loop_count = get_u16(p + 16);
+            for (p += 2; p < end && *p != 0; p += *p + 1) {}
+            p++;
+        } else if (p[0] == 0x2C && gif->num_frames < MAX_FRAMES) {
+            int x0 = get_u16(p + 1), y0 = get_u16(p + 3), w = get_u16(p + 5), h = get_u16(p + 7);
+            p += 10;
+            ok = x0 + w <= gif->width && y0 + h <= gif->height && (p = lzw_decode(p, end, indices, w * h)) != NULL;
+            for (int y = 0; ok && y < h; ++y) {
+                for (int x = 0; x < w; ++x) {
+                    int index = indices[y * w + x];
+                    if (index != transparent) shown[(y0 + y) * gif->width + x0 + x] = palette[3 * index];
+                }
+            }
+            if (ok) {
+                gif->rect_pixels[gif->num_frames] = w * h;
+                gif->frames[gif->num_frames] = malloc((size_t)gif->width * gif->height);
+                memcpy(gif->frames[gif->num_frames++], shown, (size_t)gif->width * gif->height);
+            }
+        } else {
+            ok = false;
+        }
+    }
+    free(shown);
+    free(indices);
+    free(data);
+    return ok;
+}
+
+static void free_gif(decoded_gif_t *gif) {
+    for (int i = 0; i < gif->num_frames; ++i) free(gif->frames[i]);
+}
+
+// Largest difference between a decoded frame and the gray of canvas_save_pgm
+static int frame_error(const decoded_gif_t *gif, int frame, const canvas_t *canvas) {
+    int err = 0;
+    for (int y = 0; y < canvas->height; ++y) {
+        for (int x = 0; x < canvas->width; ++x) {
+            color_t p = canvas->pixels[y][x];
+            int d = abs((int)((p.r + p.g + p.b) / 3.0f) - gif->frames[frame][y * canvas->width + x]);
+            if (d > err) err = d;
+        }
+    }
+    return err;
+}
+
+int main() {
+    printf("=== Testing GIF and QOI output ===\n");
+
+    // ===========================================
+    // Test 1: Animated wireframe round trip
+    // ===========================================
+    const int SIZE = 200, FRAMES = 24;
+    canvas_t *canvas = canvas_create(SIZE, SIZE);
+    object3d_t *ball = mesh_create_truncated_icosahedron();
+    canvas_t *copies[FRAMES];
+    gif_writer_t *gif = gif_writer_create("test_gif.gif", SIZE, SIZE, 4, 0, 8);
+    if (!canvas || !ball || !gif) {
+        printf("Failed to set up the animation\n");
+        return 1;
+    }
+    render_stats_t stats;
+    render_stats_init(&stats);
+    canvas->stats = &stats;
+    mat4 view = mat4_translate(0, 0, -3.5f);
+    mat4 proj = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    vec3 light = vec3_normalize(vec3_from_cartesian(1, 1, 1));
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        canvas_clear(canvas);
+        float angle = 2.0f * (float)M_PI * frame / FRAMES;
+        // The last frames repeat the first pose, so nothing changes between them
+        if (frame >= FRAMES - 2) angle = 0.0f;
+        render_wireframe(canvas, ball, mat4_rotate_xyz(0.5f * angle, angle, 0), view, proj, 1.5f, &light, 1);
+        gif_writer_add_frame(gif, canvas);
+        copies[frame] = canvas_create(SIZE, SIZE);
+        for (int y = 0; y < SIZE; ++y) memcpy(copies[frame]->pixels[y], canvas->pixels[y], SIZE * sizeof(color_t));
+    }
+    bool closed = gif_writer_close(gif);
+
+    decoded_gif_t decoded;
+    if (closed && decode_gif("test_gif.gif", &decoded)) {
+        int max_err = 0;
+        long rect_total = 0;
+        for (int frame = 0; frame < decoded.num_frames; ++frame) {
+            max_err = fmax(max_err, frame_error(&decoded, frame, copies[frame]));
+            rect_total += decoded.rect_pixels[frame];
+        }
+        printf("%d frames of %dx%d, loop count %d, max gray error %d (expected <= 1)\n",
+               decoded.num_frames, decoded.width, decoded.height, decoded.loop_count, max_err);
+        printf("frame pixels written: %ld of %d full-frame, last frame rectangle %d pixel(s)\n",
+               rect_total, FRAMES * SIZE * SIZE, decoded.rect_pixels[FRAMES - 1]);
+        printf("file size %llu bytes (%.1f%% of raw), save time %.2f ms\n", (unsigned long long)stats.bytes_written,
+               100.0 * stats.bytes_written / (FRAMES * SIZE * SIZE), stats.stage_ns[STAGE_SAVE] * 1e-6);
+        free_gif(&decoded);
+    } else {
+        printf("Failed to write or decode test_gif.gif\n");
+    }
+    for (int frame = 0; frame < FRAMES; ++frame) canvas_destroy(copies[frame]);
+    object3d_destroy(ball);
+
+    // ===========================================
+    // Test 2: Noise fills the LZW table many times
+    // ===========================================
+    canvas_t *noise = canvas_create(256, 256);
+    uint32_t state = 12345;
+    for (int y = 0; y < 256; ++y) {
+        for (int x = 0; x < 256; ++x) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            unsigned char g = (unsigned char)(state >> 24);
+            noise->pixels[y][x] = (color_t){g, g, g};
+        }
+    }
+    int bits[] = {8, 4, 2};
+    for (int i = 0; i < 3; ++i) {
+        gif = gif_writer_create("test_gif_noise.gif", 256, 256, 10, -1, bits[i]);
+        bool written = gif && gif_writer_add_frame(gif, noise) && gif_writer_close(gif);
+        if (written && decode_gif("test_gif_noise.gif", &decoded)) {
+            int levels = (1 << bits[i]) - 1;
+            printf("noise with %d gray levels: max error %d (expected <= %d), loop count %d\n",
+                   levels, frame_error(&decoded, 0, noise), (255 / (levels - 1) + 1) / 2, decoded.loop_count);
+            free_gif(&decoded);
+        } else {
+            printf("noise with %d palette bits failed\n", bits[i]);
+        }
+    }
+    remove("test_gif_noise.gif");
+
+    // ===========================================
+    // Test 3: Invalid arguments
+    // ===========================================
+    printf("bad palette bits rejected: %s\n", gif_writer_create("test_gif_bad.gif", 10, 10, 5, 0, 9) == NULL ? "yes" : "no");
+    gif = gif_writer_create("test_gif_bad.gif", 10, 10, 5, 0, 8);
+    printf("size mismatch rejected: %s\n", gif && !gif_writer_add_frame(gif, noise) ? "yes" : "no");
+    gif_writer_close(gif);
+    remove("test_gif_bad.gif");
+
+    // ===========================================
+    // Test 4: QOI round trips are exact
+    // ===========================================
+    canvas_t *colors = canvas_create(300, 100);
+    for (int y = 0; y < 100; ++y)
+        for (int x = 0; x < 300; ++x)
+            colors->pixels[y][x] = (color_t){(unsigned char)x, (unsigned char)(y * 2), (unsigned char)((x * y) >> 4)};
+    canvas_t *images[3] = {canvas, noise, colors};
+    const char *names[3] = {"wireframe", "noise", "colors"};
+    for (int i = 0; i < 3; ++i) {
+        render_stats_reset(&stats);
+        images[i]->stats = &stats;
+        bool saved = canvas_save_qoi(images[i], "test_qoi.qoi");
+        images[i]->stats = NULL;
+        canvas_t *loaded = saved ? canvas_load_qoi("test_qoi.qoi") : NULL;
+        bool exact = loaded && loaded->width == images[i]->width && loaded->height == images[i]->height;
+        for (int y = 0; exact && y < loaded->height; ++y)
+            exact = memcmp(loaded->pixels[y], images[i]->pixels[y], loaded->width * sizeof(color_t)) == 0;
+        printf("QOI %-9s %dx%d: %llu bytes (%.1f%% of binary PGM), exact: %s\n", names[i], images[i]->width,
+               images[i]->height, (unsigned long long)stats.bytes_written,
+               100.0 * stats.bytes_written / (images[i]->width * images[i]->height), exact ? "yes" : "no");
+        canvas_destroy(loaded);
+    }
+
+    // Truncated and corrupt data are rejected
+    size_t qoi_size;
+    unsigned char *qoi = canvas_encode_qoi(colors, &qoi_size);
+    canvas_t *truncated = canvas_decode_qoi(qoi, qoi_size / 2);
+    memcpy(qoi, "qoix", 4);
+    canvas_t *corrupt = canvas_decode_qoi(qoi, qoi_size);
+    printf("truncated QOI rejected: %s, bad magic rejected: %s\n", truncated ? "no" : "yes", corrupt ? "no" : "yes");
+    canvas_destroy(truncated);
+    canvas_destroy(corrupt);
+    free(qoi);
+    remove("test_qoi.qoi");
+
+    canvas_destroy(colors);
+    canvas_destroy(noise);
+    canvas_destroy(canvas);
+    render_stats_free(&stats);
+    printf("=== GIF and QOI tests complete ===\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,322 @@
+// Golden-image regression runner.
+//
+// Usage: test_golden [--filter SUBSTRING] [--reps N] [--time-scale F] [--save DIR] [--update]
+//
+// Renders canonical scenes and compares them against committed QOI or PGM images with a per-scene tolerance
+// (maximum pixel error and minimum PSNR), so optimizations that change bits but not appearance still pass.
+// Each scene also has a wall-time budget (median of --reps renders, scaled by --time-scale for slow
+// machines) and an allocation budget per render. Allocations are only counted when built by `make golden`,
+// which wraps malloc/calloc/realloc at link time. Run from the repository root; exits 1 on any failure.
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "tiny3d.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MAX_REPS 64
+
+// =======================
+// Allocation counting
+// =======================
+
+static long alloc_count;
+
+#ifdef GOLDEN_COUNT_ALLOCS
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    alloc_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    alloc_count++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    alloc_count++;
+    return __real_realloc(ptr, size);
+}
+#endif
+
+// =======================
+// Scenes
+// =======================
+
+// A scene: optional fixture, render into a cleared canvas, optional teardown, and its budgets
+typedef struct {
+    const char *name;
+    const char *golden;        // Path relative to the repository root
+    int width, height;
+    void *(*setup)(void);
+    void (*render)(canvas_t *canvas, void *data);
+    void (*teardown)(void *data);
+    int max_error;             // Largest allowed pixel difference
+    double min_psnr;           // Smallest allowed PSNR in dB
+    double time_budget_ms;     // Median render time allowed at --time-scale 1
+    long alloc_budget;         // Allocations allowed per render
+} scene_def_t;
+
+static const float cube_positions[8][3] = {
+    {-1, -1, -1}, { 1, -1, -1}, { 1,  1, -1}, {-1,  1, -1},
+    {-1, -1,  1}, { 1, -1,  1}, { 1,  1,  1}, {-1,  1,  1}
+};
+
+static int cube_edges[24] = {
+    0,1, 1,2, 2,3, 3,0,
+    4,5, 5,6, 6,7, 7,4,
+    0,4, 1,5, 2,6, 3,7
+};
+
+static int cube_faces[36] = {
+    0,3,2, 0,2,1,   4,5,6, 4,6,7,
+    0,1,5, 0,5,4,   3,7,6, 3,6,2,
+    0,4,7, 0,7,3,   1,2,6, 1,6,5
+};
+
+static void *setup_cube(void) {
+    object3d_t *cube = calloc(1, sizeof(object3d_t));
+    cube->vertices = malloc(8 * sizeof(vec3));
+    for (int i = 0; i < 8; ++i)
+        cube->vertices[i] = vec3_from_cartesian(cube_positions[i][0], cube_positions[i][1], cube_positions[i][2]);
+    cube->num_vertices = 8;
+    cube->indices = malloc(sizeof(cube_edges));
+    memcpy(cube->indices, cube_edges, sizeof(cube_edges));
+    cube->num_indices = 24;
+    cube->faces = malloc(sizeof(cube_faces));
+    memcpy(cube->faces, cube_faces, sizeof(cube_faces));
+    cube->num_faces = 12;
+    object3d_build_edge_faces(cube);
+    return cube;
+}
+
+static void render_cube_wireframe(canvas_t *canvas, void *data) {
+    vec3 lights[1] = { vec3_normalize(vec3_from_cartesian(0.3f, 0.5f, 1.0f)) };
+    render_wireframe(canvas, data, mat4_rotate_xyz(0.5f, 0.3f, 0), mat4_translate(0, 0, -5.0f),
+                     mat4_perspective(-1, 1, -1, 1, 1, 100), 1.5f, lights, 1);
+}
+
+static void render_cube_solid(canvas_t *canvas, void *data) {
+    vec3 lights[1] = { vec3_normalize(vec3_from_cartesian(0.3f, 0.5f, 1.0f)) };
+    render_context_t ctx;
+    render_context_init(&ctx);
+    ctx.shade_mode = SHADE_GOURAUD;
+    ctx.edge_overlay = true;
+    canvas_enable_depth(canvas);
+    render_solid(&ctx, canvas, data, mat4_rotate_xyz(0.5f, 0.3f, 0), mat4_translate(0, 0, -5.0f),
+                 mat4_perspective(-1, 1, -1, 1, 1, 100), lights, 1);
+}
+
+// The two balls of demo/main1.c at one frame of its 240-frame loop
+static void render_soccer_frame(canvas_t *canvas, object3d_t *ball, int frame) {
+    vec3 lights[2] = { vec3_normalize((vec3){1.0f, 1.0f, 1.0f}), vec3_normalize((vec3){-1.0f, -0.5f, 0.5f}) };
+    mat4 view = mat4_translate(0, 0, -3.5f);
+    mat4 proj = mat4_perspective(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 100.0f);
+    float t = (float)frame / 239;
+    float t_smooth = (1.0f - cosf(t * (float)M_PI)) / 2.0f;
+
+    vec3 p1 = bezier_cubic((vec3){-1.5f, -0.5f, 0.0f}, (vec3){-0.5f, 1.0f, -1.0f}, (vec3){-0.5f, 1.0f, 1.0f}, (vec3){-1.5f, -0.5f, 0.0f}, t);
+    float a1 = 2.0f * (float)M_PI * t_smooth;
+    mat4 m1 = mat4_mul(mat4_translate(p1.x, p1.y, p1.z), mat4_rotate_xyz(a1 * 0.5f, a1, 0.0f));
+    render_wireframe(canvas, ball, m1, view, proj, 1.5f, lights, 2);
+
+    vec3 p2 = bezier_cubic((vec3){1.5f, 0.5f, 0.0f}, (vec3){0.5f, -1.0f, 1.0f}, (vec3){0.5f, -1.0f, -1.0f}, (vec3){1.5f, 0.5f, 0.0f}, t);
+    float a2 = -2.0f * (float)M_PI * t_smooth;
+    mat4 m2 = mat4_mul(mat4_translate(p2.x, p2.y, p2.z), mat4_scale(0.6f, 0.6f, 0.6f));
+    m2 = mat4_mul(m2, mat4_rotate_xyz(a2 * 0.7f, a2, 0.0f));
+    render_wireframe(canvas, ball, m2, view, proj, 1.5f, lights, 2);
+}
+
+static void *setup_soccer(void) {
+    object3d_t *ball = mesh_create_truncated_icosahedron();
+    if (ball) object3d_build_edge_dirs(ball);
+    return ball;
+}
+
+static void render_soccer_000(canvas_t *canvas, void *data) { render_soccer_frame(canvas, data, 0); }
+static void render_soccer_100(canvas_t *canvas, void *data) { render_soccer_frame(canvas, data, 100); }
+static void render_soccer_239(canvas_t *canvas, void *data) { render_soccer_frame(canvas, data, 239); }
+
+static void *setup_icosphere(void) { return mesh_create_icosphere(4); }
+static void *setup_torus(void) { return mesh_create_torus(64, 24, 0.7f, 0.3f); }
+static void *setup_lines(void) { return mesh_create_random_lines(100000, 1.0f, 0.05f, 1); }
+
+static void render_mesh_wireframe(canvas_t *canvas, void *data) {
+    vec3 lights[2] = { vec3_normalize(vec3_from_cartesian(1, 1, 1)), vec3_normalize(vec3_from_cartesian(-1, -0.5f, 0.5f)) };
+    render_wireframe(canvas, data, mat4_rotate_xyz(0.4f, 0.7f, 0.0f), mat4_translate(0, 0, -3.0f),
+                     mat4_perspective(-1, 1, -1, 1, 1, 100), 1.0f, lights, 2);
+}
+
+static void render_mesh_solid(canvas_t *canvas, void *data) {
+    vec3 lights[1] = { vec3_normalize(vec3_from_cartesian(0.3f, 0.5f, 1.0f)) };
+    render_context_t ctx;
+    render_context_init(&ctx);
+    canvas_enable_depth(canvas);
+    render_solid(&ctx, canvas, data, mat4_rotate_xyz(0.9f, 0.3f, 0.0f), mat4_translate(0, 0, -3.0f),
+                 mat4_perspective(-1, 1, -1, 1, 1, 100), lights, 1);
+}
+
+static void teardown_object(void *data) { object3d_destroy(data); }
+
+// Time budgets leave several times the -O0 timings of a desktop machine; allocation budgets are exact
+static const scene_def_t SCENES[] = {
+    {"cube_wireframe", "tests/golden/cube_wireframe.qoi",  200, 200, setup_cube,      render_cube_wireframe, teardown_object,  8, 40.0,    1.0, 3},
+    {"cube_solid",     "tests/golden/cube_solid.qoi",      200, 200, setup_cube,      render_cube_solid,     teardown_object,  8, 40.0,    2.0, 6},
+    {"soccer_000",     "tests/visual_tests/frame_000.pgm", 800, 800, setup_soccer,    render_soccer_000,     teardown_object,  8, 40.0,    5.0, 6},
+    {"soccer_100",     "tests/visual_tests/frame_100.pgm", 800, 800, setup_soccer,    render_soccer_100,     teardown_object,  8, 40.0,    5.0, 6},
+    {"soccer_239",     "tests/visual_tests/frame_239.pgm", 800, 800, setup_soccer,    render_soccer_239,     teardown_object,  8, 40.0,    5.0, 6},
+    {"icosphere_4",    "tests/golden/icosphere_4.qoi",     256, 256, setup_icosphere, render_mesh_wireframe, teardown_object,  8, 40.0,   30.0, 3},
+    {"torus_solid",    "tests/golden/torus_solid.qoi",     256, 256, setup_torus,     render_mesh_solid,     teardown_object,  8, 40.0,   10.0, 1},
+    {"lines_100k",     "tests/golden/lines_100k.qoi",      256, 256, setup_lines,     render_mesh_wireframe, teardown_object,  8, 40.0,  400.0, 3},
+};
+
+#define NUM_SCENES ((int)(sizeof(SCENES) / sizeof(SCENES[0])))
+
+// =======================
+// Runner
+// =======================
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Goldens are QOI or PGM, chosen by extension
+static bool is_qoi(const char *path) {
+    size_t n = strlen(path);
+    return n > 4 && strcmp(path + n - 4, ".qoi") == 0;
+}
+
+static canvas_t *load_image(const char *path) {
+    return is_qoi(path) ? canvas_load_qoi(path) : canvas_load_pgm(path);
+}
+
+static void save_image(canvas_t *canvas, const char *path) {
+    if (is_qoi(path)) canvas_save_qoi(canvas, path);
+    else canvas_save_pgm(canvas, path);
+}
+
+// Render one scene reps times; returns false if it fails any check
+static bool run_scene(const scene_def_t *def, int reps, double time_scale, const char *save_dir, bool update) {
+    canvas_t *canvas = canvas_create(def->width, def->height);
+    void *data = def->setup ? def->setup() : NULL;
+    if (!canvas || (def->setup && !data)) {
+        printf("%-16s FAIL  setup failed\n", def->name);
+        canvas_destroy(canvas);
+        return false;
+    }
+
+    double times[MAX_REPS];
+    long allocs = 0;
+    for (int r = 0; r < reps; ++r) {
+        canvas_clear(canvas);
+        long before = alloc_count;
+        double start = now_ms();
+        def->render(canvas, data);
+        times[r] = now_ms() - start;
+        if (r == reps - 1) allocs = alloc_count - before; // Later reps reuse the depth buffer
+    }
+    qsort(times, reps, sizeof(double), compare_doubles);
+    double median = times[reps / 2];
+    if (def->teardown) def->teardown(data);
+
+    if (save_dir) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.pgm", save_dir, def->name);
+        canvas_save_pgm(canvas, path);
+    }
+    if (update) {
+        save_image(canvas, def->golden);
+        printf("%-16s wrote %s\n", def->name, def->golden);
+        canvas_destroy(canvas);
+        return true;
+    }
+
+    bool ok = true;
+    char problems[256] = "";
+    canvas_diff_t diff = {0};
+    canvas_t *golden = load_image(def->golden);
+    if (!golden || !canvas_compare(canvas, golden, &diff)) {
+        ok = false;
+        snprintf(problems, sizeof(problems), " missing or mismatched golden %s", def->golden);
+    } else {
+        if (diff.max_error > def->max_error || diff.psnr < def->min_psnr) {
+            ok = false;
+            strcat(problems, " image");
+        }
+    }
+    double budget = def->time_budget_ms * time_scale;
+    if (median > budget) {
+        ok = false;
+        strcat(problems, " time");
+    }
+#ifdef GOLDEN_COUNT_ALLOCS
+    if (allocs > def->alloc_budget) {
+        ok = false;
+        strcat(problems, " allocs");
+    }
+    char alloc_text[32];
+    snprintf(alloc_text, sizeof(alloc_text), "%ld/%ld", allocs, def->alloc_budget);
+#else
+    const char *alloc_text = "n/a";
+    (void)allocs;
+#endif
+
+    printf("%-16s %-4s  max err %3d  psnr %6.1f dB  diff px %7ld  %9.3f/%.0f ms  allocs %-7s%s\n",
+           def->name, ok ? "ok" : "FAIL", diff.max_error, diff.psnr, diff.num_different, median, budget,
+           alloc_text, problems);
+    canvas_destroy(golden);
+    canvas_destroy(canvas);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    const char *filter = NULL;
+    const char *save_dir = NULL;
+    int reps = 5;
+    double time_scale = 1.0;
+    bool update = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--time-scale") == 0 && i + 1 < argc) {
+            time_scale = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            save_dir = argv[++i];
+        } else if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--filter SUBSTRING] [--reps N] [--time-scale F] [--save DIR] [--update]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (reps < 1) reps = 1;
+    if (reps > MAX_REPS) reps = MAX_REPS;
+
+    int failures = 0, run = 0;
+    for (int i = 0; i < NUM_SCENES; ++i) {
+        if (filter && !strstr(SCENES[i].name, filter)) continue;
+        if (!run_scene(&SCENES[i], reps, time_scale, save_dir, update)) failures++;
+        run++;
+    }
+    printf("%d/%d scenes passed\n", run - failures, run);
+    return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
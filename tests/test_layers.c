@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "tiny3d.h"
+
+#define SIZE 200
+#define FRAMES 12
+
+static void draw_ball(canvas_t *canvas, object3d_t *ball, int frame, vec3 *light) {
+    mat4 model = mat4_mul(mat4_translate(-1.2f + 0.2f * frame, 0.3f, 0), mat4_mul(mat4_scale(0.3f, 0.3f, 0.3f),
+                          mat4_rotate_xyz(0.2f * frame, 0.3f * frame, 0)));
+    render_wireframe(canvas, ball, model, mat4_translate(0, 0, -3.5f), mat4_perspective(-1, 1, -1, 1, 1, 100), 1.5f, light, 1);
+}
+
+static void draw_field(canvas_t *canvas, object3d_t *field, vec3 *light) {
+    render_wireframe(canvas, field, mat4_rotate_xyz(0.3f, 0.2f, 0), mat4_translate(0, 0, -3.5f),
+                     mat4_perspective(-1, 1, -1, 1, 1, 100), 1.0f, light, 1);
+}
+
+// Pixel-at-a-time reference of the blend modes
+static color_t blend_reference(color_t below, color_t above, layer_blend_t blend) {
+    if (blend == LAYER_BLEND_OVER) return (above.r | above.g | above.b) ? above : below;
+    int r = below.r + above.r, g = below.g + above.g, b = below.b + above.b;
+    return (color_t){r > 255 ? 255 : r, g > 255 ? 255 : g, b > 255 ? 255 : b};
+}
+
+int main() {
+    printf("=== Testing canvas layers ===\n");
+
+    // ===========================================
+    // Test 1: Static field + moving ball vs redrawing everything
+    // ===========================================
+    layer_stack_t *stack = layer_stack_create(SIZE, SIZE);
+    int field_layer = layer_stack_add(stack, LAYER_STATIC, LAYER_BLEND_ADD);
+    int ball_layer = layer_stack_add(stack, LAYER_DYNAMIC, LAYER_BLEND_ADD);
+    canvas_t *out = canvas_create(SIZE, SIZE);
+    canvas_t *reference = canvas_create(SIZE, SIZE);
+    object3d_t *field = mesh_create_random_lines(3000, 1.0f, 0.1f, 7);
+    object3d_t *ball = mesh_create_truncated_icosahedron();
+    vec3 light = vec3_normalize(vec3_from_cartesian(1, 1, 1));
+
+    int field_draws = 0, max_error = 0;
+    long differing = 0, composed = 0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        canvas_t *c;
+        if ((c = layer_begin(stack, field_layer))) {
+            draw_field(c, field, &light);
+            layer_end(stack, field_layer);
+            field_draws++;
+        }
+        c = layer_begin(stack, ball_layer);
+        draw_ball(c, ball, frame, &light);
+        layer_end(stack, ball_layer);
+        long pixels = layer_stack_compose(stack, out);
+        if (frame > 0) composed += pixels;
+
+        canvas_clear(reference);
+        draw_field(reference, field, &light);
+        draw_ball(reference, ball, frame, &light);
+        canvas_diff_t diff;
+        canvas_compare(out, reference, &diff);
+        differing += diff.num_different;
+        if (diff.max_error > max_error) max_error = diff.max_error;
+    }
+    canvas_rect_t b = layer_bounds(stack, ball_layer);
+    printf("static layer drawn %d times in %d frames\n", field_draws, FRAMES);
+    printf("composed vs full redraw: %ld differing pixels over %d frames, max error %d\n", differing, FRAMES, max_error);
+    printf("after the first frame: %.1f%% of the pixels recomposed, ball bounds %dx%d\n",
+           100.0 * composed / ((double)(FRAMES - 1) * SIZE * SIZE), b.x1 - b.x0, b.y1 - b.y0);
+    printf("nothing redrawn: %ld pixels composed\n", layer_stack_compose(stack, out));
+
+    // Invalidating the static layer brings it back; a different output canvas is composed in full
+    layer_invalidate(stack, field_layer);
+    canvas_t *c = layer_begin(stack, field_layer);
+    printf("invalidated static layer handed out: %s\n", c ? "yes" : "no");
+    if (c) layer_end(stack, field_layer);
+    canvas_t *small = canvas_create(10, 10);
+    printf("new output canvas: %ld pixels composed, wrong size rejected: %s\n", layer_stack_compose(stack, reference),
+           layer_stack_compose(stack, small) < 0 ? "yes" : "no");
+    canvas_destroy(small);
+    layer_stack_destroy(stack);
+
+    // ===========================================
+    // Test 2: Blend modes against a per-pixel reference
+    // ===========================================
+    // Odd width so rows end in the scalar tail; sparse pixels so OVER sees black and non-black neighbours
+    int w = 123, h = 37;
+    stack = layer_stack_create(w, h);
+    int base = layer_stack_add(stack, LAYER_DYNAMIC, LAYER_BLEND_ADD);
+    int add = layer_stack_add(stack, LAYER_DYNAMIC, LAYER_BLEND_ADD);
+    int over = layer_stack_add(stack, LAYER_DYNAMIC, LAYER_BLEND_OVER);
+    canvas_t *layers[3] = {layer_begin(stack, base), layer_begin(stack, add), layer_begin(stack, over)};
+    srand(5);
+    for (int i = 0; i < 3; ++i) {
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                int kind = rand() % 4;
+                color_t p = {0, 0, 0};
+                if (kind == 1) p = (color_t){rand() % 256, rand() % 256, rand() % 256};
+                if (kind == 2) p.g = rand() % 256; // One channel set, the others zero
+                if (kind == 3 && i == 2) p = (color_t){0, 0, 1};
+                layers[i]->pixels[y][x] = p;
+            }
+        }
+        layer_end(stack, i);
+    }
+    canvas_t *blended = canvas_create(w, h);
+    layer_stack_compose(stack, blended);
+    long blend_errors = 0;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            color_t p = layers[0]->pixels[y][x];
+            p = blend_reference(p, layers[1]->pixels[y][x], LAYER_BLEND_ADD);
+            p = blend_reference(p, layers[2]->pixels[y][x], LAYER_BLEND_OVER);
+            color_t q = blended->pixels[y][x];
+            blend_errors += p.r != q.r || p.g != q.g || p.b != q.b;
+        }
+    }
+    printf("add and over blending: %ld of %d pixels wrong\n", blend_errors, w * h);
+
+    canvas_destroy(blended);
+    layer_stack_destroy(stack);
+    object3d_destroy(field);
+    object3d_destroy(ball);
+    canvas_destroy(out);
+    canvas_destroy(reference);
+    printf("=== Canvas layer tests complete ===\n");
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "tiny3d.h"
+
+#define NUM_VERTICES 8
+#define NUM_EDGES 12
+
+// Define the cube vertices and edges
+float positions[NUM_VERTICES][3] = {
+    {-1, -1, -1}, { 1, -1, -1}, { 1,  1, -1}, {-1,  1, -1},
+    {-1, -1,  1}, { 1, -1,  1}, { 1,  1,  1}, {-1,  1,  1}
+};
+
+int edges[NUM_EDGES * 2] = {
+    0,1, 1,2, 2,3, 3,0,
+    4,5, 5,6, 6,7, 7,4,
+    0,4, 1,5, 2,6, 3,7
+};
+
+// Count pixels that differ between two canvases
+static int count_diff_pixels(canvas_t *a, canvas_t *b) {
+    int diff = 0;
+    for (int y = 0; y < a->height; ++y)
+        for (int x = 0; x < a->width; ++x)
+            if (abs(a->pixels[y][x].r - b->pixels[y][x].r) > 1) diff++;
+    return diff;
+}
+
+// Count pixels with any intensity
+static int count_lit_pixels(canvas_t *c) {
+    int lit = 0;
+    for (int y = 0; y < c->height; ++y)
+        for (int x = 0; x < c->width; ++x)
+            if (c->pixels[y][x].r > 0) lit++;
+    return lit;
+}
+
+int main() {
+    printf("=== Testing light objects ===\n");
+
+    object3d_t cube = {0};
+    vec3 vertices[NUM_VERTICES];
+    for (int i = 0; i < NUM_VERTICES; ++i)
+        vertices[i] = vec3_from_cartesian(positions[i][0], positions[i][1], positions[i][2]);
+    cube.vertices = vertices;
+    cube.num_vertices = NUM_VERTICES;
+    cube.indices = edges;
+    cube.num_indices = NUM_EDGES * 2;
+
+    canvas_t *ref = canvas_create(200, 200);
+    canvas_t *out = canvas_create(200, 200);
+    mat4 model = mat4_rotate_xyz(0.5f, 0.3f, 0);
+    mat4 view = mat4_translate(0, 0, -5.0f);
+    mat4 proj = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    render_context_t ctx;
+    render_context_init(&ctx);
+
+    // ===========================================
+    // Test 1: A directional light object matches a direction vector
+    // ===========================================
+    vec3 light_dirs[1] = { vec3_from_cartesian(0.6f, 0.0f, -0.8f) };
+    light_t sun = light_directional(0.6f, 0.0f, -0.8f, 1.0f);
+    render_wireframe_ctx(&ctx, ref, &cube, model, view, proj, 1.0f, light_dirs, 1);
+    render_wireframe_lit(&ctx, out, &cube, model, view, proj, 1.0f, &sun, 1);
+    printf("directional pixels differing: %d\n", count_diff_pixels(ref, out));
+
+    // ===========================================
+    // Test 2: Culling against object bounds and screen tiles
+    // ===========================================
+    light_t lights[3] = {
+        light_point(1.5f, 1.5f, 0.0f, 2.0f, 1.0f),    // Touches the top right of the cube
+        light_point(40.0f, 0.0f, 0.0f, 5.0f, 1.0f),   // Far away: culled by the bounds test
+        light_point(0.0f, 0.0f, 5.0f, 4.0f, 1.0f)     // Around the camera: reaches every tile
+    };
+    float center[3] = {0, 0, 0};
+    light_grid_t grid;
+    if (!light_grid_build(&grid, lights, 3, view, proj, 200, 200, center, sqrtf(3.0f))) {
+        fprintf(stderr, "Failed to build light grid\n");
+        return 1;
+    }
+    int tiles_with_lights = 0;
+    for (int t = 0; t < grid.tiles_x * grid.tiles_y; ++t)
+        if (grid.tile_offsets[t + 1] > grid.tile_offsets[t]) tiles_with_lights++;
+    printf("grid %dx%d tiles, global lights: %d, tiles with local lights: %d\n",
+           grid.tiles_x, grid.tiles_y, grid.num_global, tiles_with_lights);
+    light_grid_free(&grid);
+
+    // ===========================================
+    // Test 3: Attenuation and spot cones
+    // ===========================================
+    canvas_clear(out);
+    render_wireframe_lit(&ctx, out, &cube, model, view, proj, 1.0f, &lights[1], 1);
+    printf("out-of-range point lit pixels: %d\n", count_lit_pixels(out));
+
+    canvas_clear(out);
+    render_wireframe_lit(&ctx, out, &cube, model, view, proj, 1.0f, &lights[0], 1);
+    printf("nearby point lit pixels: %d\n", count_lit_pixels(out));
+
+    light_t away = light_spot(0.0f, 0.0f, 3.0f, 0.0f, 0.0f, 1.0f, 10.0f, 0.3f, 0.5f, 1.0f);
+    light_t towards = light_spot(0.0f, 0.0f, 3.0f, 0.0f, 0.0f, -1.0f, 10.0f, 0.3f, 0.5f, 1.0f);
+    canvas_clear(out);
+    render_wireframe_lit(&ctx, out, &cube, model, view, proj, 1.0f, &away, 1);
+    printf("spot facing away lit pixels: %d\n", count_lit_pixels(out));
+    canvas_clear(out);
+    render_wireframe_lit(&ctx, out, &cube, model, view, proj, 1.0f, &towards, 1);
+    printf("spot facing cube lit pixels: %d\n", count_lit_pixels(out));
+
+    // A long edge with its midpoint beside the screen keeps a point light that reaches that midpoint
+    vec3 long_vertices[2] = { vec3_from_cartesian(-20.0f, 0.0f, 0.0f), vec3_from_cartesian(0.0f, 0.0f, 0.0f) };
+    int long_indices[2] = {0, 1};
+    object3d_t long_edge = {0};
+    long_edge.vertices = long_vertices;
+    long_edge.num_vertices = 2;
+    long_edge.indices = long_indices;
+    long_edge.num_indices = 2;
+    light_t beside = light_point(-7.0f, 0.5f, 0.0f, 4.0f, 1.0f);
+    canvas_clear(out);
+    render_wireframe_lit(&ctx, out, &long_edge, mat4_identity(), view, proj, 1.0f, &beside, 1);
+    printf("edge with off-screen midpoint lit pixels: %d\n", count_lit_pixels(out));
+
+    // ===========================================
+    // Test 4: Object-space lighting with cached edge directions
+    // ===========================================
+    if (object3d_build_edge_dirs(&cube) != 0) {
+        fprintf(stderr, "Failed to cache edge directions\n");
+        return 1;
+    }
+    printf("rigid model detected: %d, scaled model: %d, squashed model: %d\n",
+           mat4_rigid_rotation(model, NULL),
+           mat4_rigid_rotation(mat4_mul(model, mat4_scale(2, 2, 2)), NULL),
+           mat4_rigid_rotation(mat4_mul(model, mat4_scale(1, 0.5f, 1)), NULL));
+
+    mat4 models[3] = { model, mat4_mul(model, mat4_scale(2, 2, 2)), mat4_mul(model, mat4_scale(1, 0.5f, 1)) };
+    const char *model_names[3] = {"rotated", "scaled", "squashed"};
+    for (int m = 0; m < 3; ++m) {
+        float *cached = cube.edge_dirs;
+        cube.edge_dirs = NULL;
+        canvas_clear(ref);
+        render_wireframe_ctx(&ctx, ref, &cube, models[m], view, proj, 1.0f, light_dirs, 1);
+        cube.edge_dirs = cached;
+        canvas_clear(out);
+        render_wireframe_ctx(&ctx, out, &cube, models[m], view, proj, 1.0f, light_dirs, 1);
+        printf("%s object-space pixels differing: %d\n", model_names[m], count_diff_pixels(ref, out));
+    }
+    free(cube.edge_dirs);
+
+    // ===========================================
+    // Test 5: Depth cueing and fog culling
+    // ===========================================
+    const char *fog_names[] = {"none", "linear", "exp", "exp2"};
+    render_context_t fog_ctx;
+    render_context_init(&fog_ctx);
+    fog_ctx.fog_start = 4.0f;
+    fog_ctx.fog_end = 6.0f;
+    fog_ctx.fog_density = 0.25f;
+    for (int mode = FOG_NONE; mode <= FOG_EXP2; ++mode) {
+        fog_ctx.fog_mode = mode;
+        render_line_t *lines;
+        int count = render_wireframe_lines(&fog_ctx, out, &cube, model, view, proj, light_dirs, 1, &lines);
+        int total = 0;
+        for (int i = 0; i < count; ++i) total += lines[i].color.r;
+        printf("fog %-6s lines: %d, summed gray: %d\n", fog_names[mode], count, total);
+        free(lines);
+    }
+
+    // Everything beyond the fog is culled before rasterization
+    fog_ctx.fog_mode = FOG_LINEAR;
+    fog_ctx.fog_start = 1.0f;
+    fog_ctx.fog_end = 2.0f;
+    render_line_t *fogged;
+    printf("fully fogged lines: %d\n", render_wireframe_lines(&fog_ctx, out, &cube, model, view, proj, light_dirs, 1, &fogged));
+    free(fogged);
+
+    canvas_destroy(ref);
+    canvas_destroy(out);
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "tiny3d.h"
+
+#define NUM_VERTICES 8
+#define NUM_EDGES 12
+
+// Define the cube vertices and edges
+float positions[NUM_VERTICES][3] = {
+    {-1, -1, -1}, { 1, -1, -1}, { 1,  1, -1}, {-1,  1, -1},
+    {-1, -1,  1}, { 1, -1,  1}, { 1,  1,  1}, {-1,  1,  1}
+};
+
+int edges[NUM_EDGES * 2] = {
+    0,1, 1,2, 2,3, 3,0,
+    4,5, 5,6, 6,7, 7,4,
+    0,4, 1,5, 2,6, 3,7
+};
+
+// Two counter-clockwise triangles per cube side
+int faces[12 * 3] = {
+    0,3,2, 0,2,1,   4,5,6, 4,6,7,
+    0,1,5, 0,5,4,   3,7,6, 3,6,2,
+    0,4,7, 0,7,3,   1,2,6, 1,6,5
+};
+
+// Count pixels that differ between two canvases
+static int count_diff_pixels(canvas_t *a, canvas_t *b) {
+    int diff = 0;
+    for (int y = 0; y < a->height; ++y)
+        for (int x = 0; x < a->width; ++x)
+            if (abs(a->pixels[y][x].r - b->pixels[y][x].r) > 1) diff++;
+    return diff;
+}
+
+// Count pixels with any intensity
+static int count_lit_pixels(canvas_t *c) {
+    int lit = 0;
+    for (int y = 0; y < c->height; ++y)
+        for (int x = 0; x < c->width; ++x)
+            if (c->pixels[y][x].r > 0) lit++;
+    return lit;
+}
+
+int main() {
+    printf("=== Testing meshes ===\n");
+
+    // Build the reference cube
+    object3d_t cube = {0};
+    vec3 vertices[NUM_VERTICES];
+    for (int i = 0; i < NUM_VERTICES; ++i)
+        vertices[i] = vec3_from_cartesian(positions[i][0], positions[i][1], positions[i][2]);
+    cube.vertices = vertices;
+    cube.num_vertices = NUM_VERTICES;
+    cube.indices = edges;
+    cube.num_indices = NUM_EDGES * 2;
+
+    compact_mesh_t *packed = compact_mesh_create(&cube, MESH_POSITIONS_FLOAT3);
+    compact_mesh_t *quant = compact_mesh_create(&cube, MESH_POSITIONS_QUANT16);
+    if (!packed || !quant) {
+        fprintf(stderr, "Failed to create compact meshes\n");
+        return 1;
+    }
+
+    // ===========================================
+    // Test 1: Storage sizes
+    // ===========================================
+    printf("object3d_t: %zu bytes/vertex, %zu bytes/index\n", sizeof(vec3), sizeof(int));
+    printf("float3:     %zu bytes/vertex, %d bytes/index\n", 3 * sizeof(float), packed->index_size);
+    printf("quant16:    %zu bytes/vertex, %d bytes/index\n", 3 * sizeof(int16_t), quant->index_size);
+
+    // ===========================================
+    // Test 2: Dequantization round trip
+    // ===========================================
+    mat4 dq = compact_mesh_dequant_matrix(quant);
+    const int16_t *q = quant->positions;
+    float max_err = 0.0f;
+    for (int i = 0; i < NUM_VERTICES; ++i) {
+        vec4 p = mat4_mul_vec4(dq, (vec4){q[3 * i], q[3 * i + 1], q[3 * i + 2], 1.0f});
+        max_err = fmaxf(max_err, fabsf(p.x - positions[i][0]));
+        max_err = fmaxf(max_err, fabsf(p.y - positions[i][1]));
+        max_err = fmaxf(max_err, fabsf(p.z - positions[i][2]));
+    }
+    printf("quant16 max position error: %g\n", max_err);
+
+    // ===========================================
+    // Test 3: Rendering matches object3d_t
+    // ===========================================
+    canvas_t *ref = canvas_create(200, 200);
+    canvas_t *out = canvas_create(200, 200);
+    mat4 model = mat4_rotate_xyz(0.5f, 0.3f, 0);
+    mat4 view = mat4_translate(0, 0, -5.0f);
+    mat4 proj = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    vec3 light_dirs[1] = { vec3_from_cartesian(0.0f, 0.0f, -1.0f) };
+
+    render_wireframe(ref, &cube, model, view, proj, 1.0f, light_dirs, 1);
+    render_wireframe_compact(out, packed, model, view, proj, 1.0f, light_dirs, 1);
+    printf("float3 pixels differing:  %d\n", count_diff_pixels(ref, out));
+
+    canvas_clear(out);
+    render_wireframe_compact(out, quant, model, view, proj, 1.0f, light_dirs, 1);
+    printf("quant16 pixels differing: %d\n", count_diff_pixels(ref, out));
+
+    // ===========================================
+    // Test 4: Back-face and silhouette edge culling
+    // ===========================================
+    cube.faces = faces;
+    cube.num_faces = 12;
+    if (object3d_build_edge_faces(&cube) != 0) {
+        fprintf(stderr, "Failed to build edge adjacency\n");
+        return 1;
+    }
+    printf("edge 0 faces: %d %d\n", cube.edge_faces[0], cube.edge_faces[1]);
+
+    render_context_t ctx;
+    render_context_init(&ctx);
+    const char *mode_names[] = {"none", "backface", "silhouette"};
+    for (int mode = EDGE_CULL_NONE; mode <= EDGE_CULL_SILHOUETTE; ++mode) {
+        ctx.cull_mode = mode;
+        canvas_clear(out);
+        render_wireframe_ctx(&ctx, out, &cube, model, view, proj, 1.0f, light_dirs, 1);
+        printf("cull %-10s lit pixels: %d\n", mode_names[mode], count_lit_pixels(out));
+    }
+    free(cube.edge_faces);
+
+    // ===========================================
+    // Test 5: Procedural meshes (closed surfaces have no boundary edges)
+    // ===========================================
+    const char *gen_names[] = {"icosphere 0", "icosphere 5", "grid 64x32", "torus 48x16", "cylinder 24x4", "capped cyl", "lines 1000"};
+    object3d_t *gens[] = {
+        mesh_create_icosphere(0), mesh_create_icosphere(5), mesh_create_grid(64, 32, 2.0f, 1.0f),
+        mesh_create_torus(48, 16, 1.0f, 0.3f), mesh_create_cylinder(24, 4, 0.5f, 1.5f, false),
+        mesh_create_cylinder(24, 4, 0.5f, 1.5f, true), mesh_create_random_lines(1000, 1.0f, 0.2f, 42)
+    };
+    for (int g = 0; g < 7; ++g) {
+        object3d_t *m = gens[g];
+        if (!m) {
+            fprintf(stderr, "Failed to generate %s\n", gen_names[g]);
+            return 1;
+        }
+        int num_edges = m->num_indices / 2;
+        int open = 0;
+        if (m->faces && object3d_build_edge_faces(m) == 0) {
+            for (int e = 0; e < num_edges; ++e) {
+                if (m->edge_faces[2 * e + 1] < 0) open++;
+            }
+        }
+        printf("%-13s V=%-6d E=%-6d F=%-6d boundary edges=%d\n", gen_names[g], m->num_vertices, num_edges, m->num_faces, open);
+    }
+
+    // Back faces of a closed mesh hide about half its edges
+    render_line_t *lines = NULL;
+    ctx.cull_mode = EDGE_CULL_NONE;
+    int all_lines = render_wireframe_lines(&ctx, out, gens[1], model, view, proj, light_dirs, 1, &lines);
+    free(lines);
+    ctx.cull_mode = EDGE_CULL_BACKFACE;
+    int front_lines = render_wireframe_lines(&ctx, out, gens[1], model, view, proj, light_dirs, 1, &lines);
+    free(lines);
+    printf("icosphere 5 lines: %d, front-facing: %d\n", all_lines, front_lines);
+    for (int g = 0; g < 7; ++g) object3d_destroy(gens[g]);
+    printf("mesh_create_icosphere(11): %s (expected NULL)\n", mesh_create_icosphere(11) ? "object" : "NULL");
+
+    canvas_destroy(ref);
+    canvas_destroy(out);
+    compact_mesh_destroy(packed);
+    compact_mesh_destroy(quant);
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include "tiny3d.h"
+
+#define CELL 200
+#define GUTTER 10
+#define ATLAS (2 * CELL + GUTTER)
+#define VIEWS 4
+
+// A perspective camera, top and side orthographic cameras and a close perspective camera
+static void make_views(render_view_t *views, canvas_t **canvases) {
+    mat4 persp = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    mat4 ortho = mat4_orthographic(-1.5f, 1.5f, -1.5f, 1.5f, 0.1f, 10.0f);
+    views[0] = (render_view_t){canvases[0], mat4_translate(0, 0, -3.5f), persp};
+    views[1] = (render_view_t){canvases[1], mat4_mul(mat4_translate(0, 0, -5.0f), mat4_rotate_x(1.5707963f)), ortho};
+    views[2] = (render_view_t){canvases[2], mat4_mul(mat4_translate(0, 0, -5.0f), mat4_rotate_y(-1.5707963f)), ortho};
+    views[3] = (render_view_t){canvases[3], mat4_mul(mat4_translate(0.3f, 0, -1.8f), mat4_rotate_y(0.4f)), persp};
+}
+
+// Draw each view into a cell of the atlas and compare it with a separate render_wireframe_ctx per view
+static void check(const char *name, render_context_t *ctx, object3d_t *object, mat4 model, vec3 *lights, int num_lights) {
+    canvas_t *atlas = canvas_create(ATLAS, ATLAS);
+    canvas_t *threaded = canvas_create(ATLAS, ATLAS);
+    canvas_t *cells[VIEWS], *threaded_cells[VIEWS], *separate[VIEWS];
+    for (int v = 0; v < VIEWS; ++v) {
+        int x = (v % 2) * (CELL + GUTTER), y = (v / 2) * (CELL + GUTTER);
+        cells[v] = canvas_region(atlas, x, y, CELL, CELL);
+        threaded_cells[v] = canvas_region(threaded, x, y, CELL, CELL);
+        separate[v] = canvas_create(CELL, CELL);
+    }
+    render_view_t views[VIEWS], threaded_views[VIEWS];
+    make_views(views, cells);
+    make_views(threaded_views, threaded_cells);
+
+    // Threads first, so lazily built lighting tables are first touched by the workers
+    render_wireframe_views(ctx, object, model, threaded_views, VIEWS, 1.5f, lights, num_lights, VIEWS);
+    render_wireframe_views(ctx, object, model, views, VIEWS, 1.5f, lights, num_lights, 1);
+    long differing = 0, lit = 0;
+    for (int v = 0; v < VIEWS; ++v) {
+        render_wireframe_ctx(ctx, separate[v], object, model, views[v].view_matrix, views[v].projection_matrix, 1.5f, lights, num_lights);
+        canvas_diff_t diff;
+        canvas_compare(cells[v], separate[v], &diff);
+        differing += diff.num_different;
+        for (int y = 0; y < CELL; ++y)
+            for (int x = 0; x < CELL; ++x) lit += cells[v]->pixels[y][x].g > 0;
+    }
+    canvas_diff_t threads_diff;
+    canvas_compare(atlas, threaded, &threads_diff);
+
+    // Nothing may leak into the gutters between the cells
+    long gutter = 0;
+    for (int y = 0; y < ATLAS; ++y)
+        for (int x = CELL; x < CELL + GUTTER; ++x)
+            gutter += atlas->pixels[y][x].g > 0 || atlas->pixels[x][y].g > 0;
+
+    printf("%s: %ld lit pixels in %d views, %ld differ from separate draws, %ld differ with %d threads, %ld in the gutters\n",
+           name, lit, VIEWS, differing, threads_diff.num_different, VIEWS, gutter);
+
+    for (int v = 0; v < VIEWS; ++v) {
+        canvas_destroy(cells[v]);
+        canvas_destroy(threaded_cells[v]);
+        canvas_destroy(separate[v]);
+    }
+    canvas_destroy(atlas);
+    canvas_destroy(threaded);
+}
+
+int main() {
+    printf("=== Testing multi-view rendering ===\n");
+    vec3 lights[2] = {vec3_normalize(vec3_from_cartesian(1, 1, 1)), vec3_normalize(vec3_from_cartesian(-1, 0.3f, 0.5f))};
+    render_context_t ctx;
+    render_context_init(&ctx);
+
+    // ===========================================
+    // Test 1: World-space lighting (non-rigid model)
+    // ===========================================
+    object3d_t *torus = mesh_create_torus(24, 12, 1.0f, 0.35f);
+    check("torus, stretched", &ctx, torus, mat4_mul(mat4_scale(1.2f, 0.8f, 1.0f), mat4_rotate_xyz(0.5f, 0.3f, 0)), lights, 2);
+
+    // ===========================================
+    // Test 2: Object-space lighting (rigid model with cached edge directions)
+    // ===========================================
+    object3d_t *ball = mesh_create_truncated_icosahedron();
+    object3d_build_edge_dirs(ball);
+    check("soccer ball, rigid", &ctx, ball, mat4_mul(mat4_translate(0.1f, 0, 0), mat4_rotate_xyz(0.7f, 0.2f, 0.1f)), lights, 2);
+
+    // ===========================================
+    // Test 3: Per-view culling and fog
+    // ===========================================
+    object3d_t *sphere = mesh_create_icosphere(2);
+    object3d_build_edge_faces(sphere);
+    ctx.cull_mode = EDGE_CULL_BACKFACE;
+    ctx.fog_mode = FOG_LINEAR;
+    ctx.fog_start = 2.0f;
+    ctx.fog_end = 6.0f;
+    ctx.ambient = 0.1f;
+    check("icosphere, culled and fogged", &ctx, sphere, mat4_rotate_xyz(0.2f, 0.4f, 0), lights, 2);
+
+    // The exponential fog table is built on first use, here by the worker threads
+    ctx.fog_mode = FOG_EXP;
+    ctx.fog_density = 0.3f;
+    check("icosphere, exponential fog", &ctx, sphere, mat4_rotate_xyz(0.2f, 0.4f, 0), lights, 2);
+
+    object3d_destroy(torus);
+    object3d_destroy(ball);
+    object3d_destroy(sphere);
+    printf("=== Multi-view tests complete ===\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "tiny3d.h"
+
+#define NUM_VERTICES 8
+#define NUM_EDGES 12
+#define NUM_FACES 12
+
+// Define the cube vertices, edges and counter-clockwise faces
+float positions[NUM_VERTICES][3] = {
+    {-1, -1, -1}, { 1, -1, -1}, { 1,  1, -1}, {-1,  1, -1},
+    {-1, -1,  1}, { 1, -1,  1}, { 1,  1,  1}, {-1,  1,  1}
+};
+
+int edges[NUM_EDGES * 2] = {
+    0,1, 1,2, 2,3, 3,0,
+    4,5, 5,6, 6,7, 7,4,
+    0,4, 1,5, 2,6, 3,7
+};
+
+int faces[NUM_FACES * 3] = {
+    0,3,2, 0,2,1,   4,5,6, 4,6,7,
+    0,1,5, 0,5,4,   3,7,6, 3,6,2,
+    0,4,7, 0,7,3,   1,2,6, 1,6,5
+};
+
+// Count pixels with any intensity
+static int count_lit_pixels(canvas_t *c) {
+    int lit = 0;
+    for (int y = 0; y < c->height; ++y)
+        for (int x = 0; x < c->width; ++x)
+            if (c->pixels[y][x].r > 0) lit++;
+    return lit;
+}
+
+int main() {
+    printf("=== Testing triangle rasterizer ===\n");
+
+    canvas_t *canvas = canvas_create(200, 200);
+    if (!canvas) {
+        fprintf(stderr, "Failed to create canvas\n");
+        return 1;
+    }
+
+    // ===========================================
+    // Test 1: Two triangles sharing a diagonal cover a square exactly once
+    // ===========================================
+    color_t white = {255, 255, 255};
+    raster_vertex_t a = {60.0f, 60.0f, 0.0f, 1.0f};
+    raster_vertex_t b = {140.0f, 60.0f, 0.0f, 1.0f};
+    raster_vertex_t c = {140.0f, 140.0f, 0.0f, 1.0f};
+    raster_vertex_t d = {60.0f, 140.0f, 0.0f, 1.0f};
+    draw_triangle_f(canvas, &a, &b, &c, white);
+    draw_triangle_f(canvas, &a, &c, &d, white);
+    printf("80x80 square pixels: %d (expected 6400)\n", count_lit_pixels(canvas));
+
+    // ===========================================
+    // Test 2: Depth test keeps the nearer triangle
+    // ===========================================
+    canvas_clear(canvas);
+    canvas_enable_depth(canvas);
+    raster_vertex_t n0 = {50.0f, 50.0f, 0.2f, 0.5f}, n1 = {150.0f, 50.0f, 0.2f, 0.5f}, n2 = {100.0f, 150.0f, 0.2f, 0.5f};
+    raster_vertex_t f0 = {50.0f, 50.0f, 0.8f, 1.0f}, f1 = {150.0f, 50.0f, 0.8f, 1.0f}, f2 = {100.0f, 150.0f, 0.8f, 1.0f};
+    draw_triangle_f(canvas, &n0, &n1, &n2, white);
+    draw_triangle_f(canvas, &f0, &f1, &f2, white);
+    printf("center pixel after near-then-far: %d (expected 127)\n", canvas->pixels[80][100].r);
+
+    // ===========================================
+    // Test 3: Shaded cube
+    // ===========================================
+    object3d_t cube = {0};
+    vec3 vertices[NUM_VERTICES];
+    for (int i = 0; i < NUM_VERTICES; ++i)
+        vertices[i] = vec3_from_cartesian(positions[i][0], positions[i][1], positions[i][2]);
+    cube.vertices = vertices;
+    cube.num_vertices = NUM_VERTICES;
+    cube.indices = edges;
+    cube.num_indices = NUM_EDGES * 2;
+    cube.faces = faces;
+    cube.num_faces = NUM_FACES;
+    object3d_build_edge_faces(&cube);
+
+    mat4 model = mat4_rotate_xyz(0.5f, 0.3f, 0);
+    mat4 view = mat4_translate(0, 0, -5.0f);
+    mat4 proj = mat4_perspective(-1, 1, -1, 1, 1, 100);
+    vec3 light_dirs[1] = { vec3_normalize(vec3_from_cartesian(0.3f, 0.5f, 1.0f)) };
+
+    render_context_t ctx;
+    render_context_init(&ctx);
+    const char *mode_names[] = {"flat", "gouraud"};
+    for (int mode = SHADE_FLAT; mode <= SHADE_GOURAUD; ++mode) {
+        ctx.shade_mode = mode;
+        ctx.edge_overlay = (mode == SHADE_GOURAUD);
+        canvas_clear(canvas);
+        render_solid(&ctx, canvas, &cube, model, view, proj, light_dirs, 1);
+        printf("%-8s cube lit pixels: %d\n", mode_names[mode], count_lit_pixels(canvas));
+    }
+    canvas_save_pgm(canvas, "solid_cube.pgm");
+
+    // ===========================================
+    // Test 4: Camera inside the near plane clips instead of discarding
+    // ===========================================
+    canvas_clear(canvas);
+    ctx.double_sided = true; // Only the inside faces remain visible
+    render_solid(&ctx, canvas, &cube, mat4_identity(), mat4_translate(0, 0, -1.5f), proj, light_dirs, 1);
+    printf("near-clipped cube lit pixels: %d\n", count_lit_pixels(canvas));
+
+    // ===========================================
+    // Test 5: Stage timers and counters for a solid and a wireframe frame
+    // ===========================================
+    render_stats_t stats;
+    render_stats_init(&stats);
+    stats.trace = true;
+    {
+        canvas->stats = &stats;
+        ctx.stats = &stats;
+        ctx.double_sided = false;
+        ctx.edge_overlay = false;
+        render_stats_frame(&stats);
+        canvas_clear(canvas);
+        render_solid(&ctx, canvas, &cube, model, view, proj, light_dirs, 1);
+        render_stats_frame(&stats);
+        canvas_clear(canvas);
+        render_wireframe_ctx(&ctx, canvas, &cube, model, view, proj, 1.0f, light_dirs, 1);
+        printf("triangles drawn: %llu (expected 6, back faces culled)\n", (unsigned long long)stats.triangles_drawn);
+        printf("edges submitted/culled/drawn: %llu/%llu/%llu\n", (unsigned long long)stats.edges_submitted,
+               (unsigned long long)stats.edges_culled, (unsigned long long)stats.lines_drawn);
+        printf("pixels written: %llu, frames: %llu\n", (unsigned long long)stats.pixels_written, (unsigned long long)stats.frames);
+
+        // Point splats count every pixel they touch, like lines and triangles
+        float px[3] = {-0.3f, 0.0f, 0.3f}, py[3] = {0.0f, 0.2f, -0.2f}, pz[3] = {0.0f, 0.0f, 0.0f};
+        point_cloud_t cloud = {px, py, pz, 3};
+        uint64_t before = stats.pixels_written;
+        canvas_clear(canvas);
+        render_point_cloud(&ctx, canvas, &cloud, mat4_identity(), view, proj, 3.0f, (color_t){255, 255, 255});
+        printf("points drawn: %llu, pixels written by splats: %llu for %d lit pixels\n", (unsigned long long)stats.points_drawn,
+               (unsigned long long)(stats.pixels_written - before), count_lit_pixels(canvas));
+        render_stats_print(&stats);
+        printf("trace written: %s\n", render_stats_write_trace(&stats, "render_trace.json") ? "yes" : "no");
+        canvas->stats = NULL;
+        render_stats_free(&stats);
+    }
+
+    free(cube.edge_faces);
+    canvas_destroy(canvas);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "tiny3d.h"
+
+// Largest element difference between two matrices
+static float max_matrix_error(mat4 a, mat4 b) {
+    float err = 0.0f;
+    for (int i = 0; i < 16; ++i)
+        err = fmaxf(err, fabsf(a.m[i] - b.m[i]));
+    return err;
+}
+
+static const char TEXT_SCENE[] =
+    "# test scene\n"
+    "canvas 160 120\n"
+    "frames 12\n"
+    "camera 0 0.5 4\n"
+    "perspective -1 1 -0.75 0.75 1 50\n"
+    "light 1 1 1\n"
+    "light -1 -0.5 0.5   # second light\n"
+    "mesh ball soccer\n"
+    "mesh sphere icosphere 2\n"
+    "mesh donut torus 24 12 0.8 0.25\n"
+    "mesh stick cylinder 16 2 0.2 1.5 1\n"
+    "path loop bezier -1 0 0  -0.5 1 0  0.5 1 0  1 0 0  1.5 -1 0  -1.5 -1 0  -1 0 0\n"
+    "path wave catmull-rom -1 0 0  0 1e-1 0  1 0 0\n"
+    "instance ball path=loop spin=0.5,1,0 ease=sine thickness=1.5\n"
+    "instance sphere at=0.5,0,-1 path=wave scale=0.4 mode=solid\n"
+    "instance donut spin=0,0,1 ease=in-out-cubic mode=solid\n"
+    "instance stick at=-1,0.25,0 scale=0.5\n";
+
+int main() {
+    printf("=== Testing scene files ===\n");
+
+    // ===========================================
+    // Test 1: Parse a text scene
+    // ===========================================
+    scene_t *scene = scene_parse(TEXT_SCENE, strlen(TEXT_SCENE));
+    if (!scene) {
+        printf("Failed to parse the text scene\n");
+        return 1;
+    }
+    printf("canvas %dx%d, %d frames, %d meshes, %d paths (%d points), %d instances, %d lights\n",
+           scene->settings.width, scene->settings.height, scene->settings.frames, scene->num_meshes,
+           scene->num_paths, scene->num_points, scene->num_instances, scene->num_lights);
+    printf("path 1 point 1 y: %g (expected 0.1)\n", scene->points[3 * (scene->paths[1].first_point + 1) + 1]);
+
+    // A two-segment Bézier path joins its segments and ends where it starts
+    float start[3], middle[3], end[3];
+    scene_path_eval(scene, 0, 0.0f, start);
+    scene_path_eval(scene, 0, 0.5f, middle);
+    scene_path_eval(scene, 0, 1.0f, end);
+    printf("loop path: start (%g, %g), middle (%g, %g), end (%g, %g)\n",
+           start[0], start[1], middle[0], middle[1], end[0], end[1]);
+
+    // ===========================================
+    // Test 2: Binary round trip
+    // ===========================================
+    const char *binary_file = "test_scene.t3ds";
+    if (!scene_save_binary(scene, binary_file)) {
+        printf("Failed to save the binary scene\n");
+        scene_destroy(scene);
+        return 1;
+    }
+    scene_t *binary = scene_load(binary_file);
+    if (!binary) {
+        printf("Failed to load the binary scene\n");
+        scene_destroy(scene);
+        return 1;
+    }
+    float max_err = max_matrix_error(scene_view_matrix(scene), scene_view_matrix(binary));
+    max_err = fmaxf(max_err, max_matrix_error(scene_projection_matrix(scene), scene_projection_matrix(binary)));
+    for (int frame = 0; frame < scene->settings.frames; ++frame) {
+        float t = scene_frame_time(scene, frame);
+        for (int i = 0; i < scene->num_instances; ++i)
+            max_err = fmaxf(max_err, max_matrix_error(scene_instance_matrix(scene, i, t), scene_instance_matrix(binary, i, t)));
+    }
+    printf("binary scene: %d instances, mesh 2 named '%.*s', max matrix difference %g\n",
+           binary->num_instances, (int)binary->meshes[2].name_length, binary->strings + binary->meshes[2].name_offset, max_err);
+
+    // ===========================================
+    // Test 3: Both forms render the same frame
+    // ===========================================
+    canvas_t *a = canvas_create(scene->settings.width, scene->settings.height);
+    canvas_t *b = canvas_create(binary->settings.width, binary->settings.height);
+    if (a && b && scene_build_meshes(scene) && scene_build_meshes(binary)) {
+        scene_render_frame(scene, a, 5);
+        scene_render_frame(binary, b, 5);
+        canvas_diff_t diff;
+        canvas_compare(a, b, &diff);
+        int lit = 0;
+        for (int y = 0; y < a->height; ++y)
+            for (int x = 0; x < a->width; ++x)
+                if (a->pixels[y][x].r > 0) lit++;
+        printf("frame 5: %d lit pixels, %ld pixels differ between text and binary\n", lit, diff.num_different);
+        canvas_save_pgm(a, "test_scene.pgm");
+    } else {
+        printf("Failed to set up rendering\n");
+    }
+    canvas_destroy(a);
+    canvas_destroy(b);
+    scene_destroy(binary);
+    scene_destroy(scene);
+    remove(binary_file);
+
+    // ===========================================
+    // Test 4: Errors are reported with their line
+    // ===========================================
+    const char *bad_scenes[] = {
+        "mesh ball soccer\ninstance cube\n",               // undefined mesh
+        "path p bezier 0 0 0 1 1 1\n",                     // too few Bézier points
+        "mesh ball soccer\ninstance ball spin=1,2\n",      // short vector
+        "canvas 100\n",                                    // missing height
+        "frames 10\nfog 0.5\n",                            // unknown directive
+    };
+    int rejected = 0;
+    for (int i = 0; i < (int)(sizeof(bad_scenes) / sizeof(bad_scenes[0])); ++i) {
+        scene_t *bad = scene_parse(bad_scenes[i], strlen(bad_scenes[i]));
+        if (!bad) rejected++;
+        scene_destroy(bad);
+    }
+    printf("rejected %d of %d malformed scenes\n", rejected, (int)(sizeof(bad_scenes) / sizeof(bad_scenes[0])));
+
+    printf("=== Scene tests complete ===\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+// Stand-in client for render_daemon.
+//
+// Usage: render_client [--socket PATH] [--scene FILE] [--out DIR] [--clients N] [--repeat K]
+//
+// Sends a scene (from FILE, or the built-in two-ball soccer scene) K times over each of N concurrent
+// connections, checks every streamed frame, optionally writes the frames of the first connection to DIR,
+// and reports the latency of each request and the daemon's cache statistics. Exits 1 if anything fails.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "render_protocol.h"
+
+#define MAX_CLIENTS 64
+
+// The two balls of the soccer demo, one full turn over 24 frames
+static const char *DEFAULT_SCENE =
+    "SCENE 400 400 24\n"
+    "CAMERA 3.5\n"
+    "OBJECT soccer wire 1.5 1.0 0.5 1.0 -1.0 0.0 0.0\n"
+    "OBJECT soccer wire 1.5 0.6 0.7 -1.0 1.0 0.0 0.0\n"
+    "END\n";
+
+typedef struct {
+    const char *socket_path;
+    const char *scene;
+    const char *out_dir;       // Only used by the first client
+    int repeat;
+    int id;
+    bool ok;
+} client_t;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+static int connect_daemon(const char *path) {
+    struct sockaddr_un addr = {0};
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+static bool write_all(int fd, const void *data, size_t size) {
+    const char *p = data;
+    while (size > 0) {
+        ssize_t sent = send(fd, p, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+static bool read_all(int fd, void *data, size_t size) {
+    char *p = data;
+    while (size > 0) {
+        ssize_t got = recv(fd, p, size, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        size -= got;
+    }
+    return true;
+}
+
+// Read a header line byte by byte (frames follow it directly, so nothing may be read ahead)
+static bool read_header(int fd, char *line, int cap) {
+    int n = 0;
+    char c;
+    while (read_all(fd, &c, 1)) {
+        if (c == '\n') {
+            line[n] = '\0';
+            return true;
+        }
+        if (n < cap - 1) line[n++] = c;
+    }
+    return false;
+}
+
+// Send the scene once and consume its frames. Returns false on any protocol or image error.
+static bool run_request(client_t *c, int fd, int request) {
+    double start = now_ms();
+    if (!write_all(fd, c->scene, strlen(c->scene))) return false;
+
+    char line[RENDER_MAX_LINE];
+    unsigned char *image = NULL;
+    size_t capacity = 0;
+    int frames = 0;
+    double first_frame_ms = 0.0;
+    for (;;) {
+        if (!read_header(fd, line, sizeof(line))) {
+            fprintf(stderr, "client %d: connection closed\n", c->id);
+            free(image);
+            return false;
+        }
+        int index, width, height;
+        size_t size;
+        double render_ms;
+        if (sscanf(line, "FRAME %d %d %d %zu", &index, &width, &height, &size) == 4) {
+            if (size > capacity) {
+                free(image);
+                image = malloc(size);
+                capacity = image ? size : 0;
+            }
+            if (!image || !read_all(fd, image, size)) {
+                free(image);
+                return false;
+            }
+            char header[64];
+            int header_size = snprintf(header, sizeof(header), "P5\n%d %d\n255\n", width, height);
+            if (index != frames || size != (size_t)header_size + (size_t)width * height ||
+                memcmp(image, header, header_size) != 0) {
+                fprintf(stderr, "client %d: bad frame %d\n", c->id, index);
+                free(image);
+                return false;
+            }
+            if (frames == 0) first_frame_ms = now_ms() - start;
+            if (c->out_dir && request == 0) {
+                char path[512];
+                snprintf(path, sizeof(path), "%s/frame_%03d.pgm", c->out_dir, index);
+                FILE *f = fopen(path, "wb");
+                if (f) {
+                    fwrite(image, 1, size, f);
+                    fclose(f);
+                }
+            }
+            frames++;
+        } else if (sscanf(line, "DONE %d %lf", &index, &render_ms) == 2) {
+            printf("client %d request %d: %d frames, first after %.2f ms, all after %.2f ms (render %.2f ms)\n",
+                   c->id, request, frames, first_frame_ms, now_ms() - start, render_ms);
+            free(image);
+            return index == frames;
+        } else {
+            fprintf(stderr, "client %d: %s\n", c->id, line);
+            free(image);
+            return false;
+        }
+    }
+}
+
+static void *client_main(void *arg) {
+    client_t *c = arg;
+    int fd = connect_daemon(c->socket_path);
+    if (fd < 0) {
+        fprintf(stderr, "client %d: cannot connect to %s\n", c->id, c->socket_path);
+        return NULL;
+    }
+    c->ok = true;
+    for (int r = 0; r < c->repeat && c->ok; ++r) c->ok = run_request(c, fd, r);
+    close(fd);
+    return NULL;
+}
+
+// Read a whole file into a NUL-terminated string
+static char *read_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *text = size >= 0 ? malloc(size + 1) : NULL;
+    if (text && fread(text, 1, size, f) != (size_t)size) {
+        free(text);
+        text = NULL;
+    }
+    if (text) text[size] = '\0';
+    fclose(f);
+    return text;
+}
+
+int main(int argc, char **argv) {
+    const char *socket_path = RENDER_SOCKET_PATH;
+    const char *scene_file = NULL;
+    const char *out_dir = NULL;
+    int num_clients = 1, repeat = 2;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            scene_file = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc) {
+            num_clients = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--socket PATH] [--scene FILE] [--out DIR] [--clients N] [--repeat K]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_clients < 1) num_clients = 1;
+    if (num_clients > MAX_CLIENTS) num_clients = MAX_CLIENTS;
+    if (repeat < 1) repeat = 1;
+
+    char *scene = scene_file ? read_file(scene_file) : NULL;
+    if (scene_file && !scene) {
+        fprintf(stderr, "Cannot read scene %s\n", scene_file);
+        return 1;
+    }
+
+    pthread_t threads[MAX_CLIENTS];
+    client_t clients[MAX_CLIENTS];
+    for (int i = 0; i < num_clients; ++i) {
+        clients[i] = (client_t){socket_path, scene ? scene : DEFAULT_SCENE, i == 0 ? out_dir : NULL, repeat, i, false};
+        pthread_create(&threads[i], NULL, client_main, &clients[i]);
+    }
+    int failures = 0;
+    for (int i = 0; i < num_clients; ++i) {
+        pthread_join(threads[i], NULL);
+        if (!clients[i].ok) failures++;
+    }
+
+    // Cache statistics: repeated requests should be hits
+    int fd = connect_daemon(socket_path);
+    char line[RENDER_MAX_LINE];
+    if (fd >= 0 && write_all(fd, "STATS\n", 6) && read_header(fd, line, sizeof(line))) {
+        printf("%s\n", line);
+    }
+    if (fd >= 0) close(fd);
+
+    free(scene);
+    printf("%d/%d clients succeeded\n", num_clients - failures, num_clients);
+    return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
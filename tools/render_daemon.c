@@ -0,0 +1,564 @@
+// Headless render service: a long-running process that renders scenes for local clients.
+//
+// Usage: render_daemon [--socket PATH] [--workers N] [--cache N]
+//
+// Listens on a Unix domain socket (see render_protocol.h for the requests). The main thread accepts
+// connections and hands them to a fixed pool of worker threads, so concurrent clients render in parallel.
+// Generated meshes stay resident in a reference-counted LRU cache between requests, which removes process
+// startup and mesh generation from the per-request latency. SIGINT/SIGTERM stop the daemon.
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include "tiny3d.h"
+#include "render_protocol.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Pending connections waiting for a worker
+#define CONNECTION_QUEUE_SIZE 64
+
+#define MAX_WORKERS 64
+#define MESH_KEY_SIZE 64
+
+// Idle connections wake up this often to notice a shutdown
+#define RECV_TIMEOUT_SEC 1
+
+static volatile sig_atomic_t stopping = 0;
+
+// =======================
+// Mesh Cache
+// =======================
+
+typedef struct {
+    char key[MESH_KEY_SIZE];    // Mesh name from the request, "" for a free slot
+    object3d_t *mesh;
+    int refs;                   // Scenes currently rendering it; only unreferenced entries are evicted
+    uint64_t last_used;
+    bool building;              // Being generated outside the lock; mesh is NULL until then
+} cache_entry_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t built;       // Signalled whenever an entry finishes building
+    cache_entry_t *entries;
+    int capacity;
+    uint64_t clock;
+    uint64_t hits, misses, scenes, frames;
+} mesh_cache_t;
+
+static mesh_cache_t cache;
+
+// Build a mesh from its name (see render_protocol.h)
+static object3d_t *generate_mesh(const char *key) {
+    int a, b, c;
+    float x, y;
+    unsigned int seed;
+    object3d_t *mesh = NULL;
+    if (strcmp(key, "soccer") == 0) {
+        mesh = mesh_create_truncated_icosahedron();
+    } else if (sscanf(key, "icosphere:%d", &a) == 1) {
+        mesh = mesh_create_icosphere(a);
+    } else if (sscanf(key, "grid:%d:%d:%f:%f", &a, &b, &x, &y) == 4) {
+        mesh = mesh_create_grid(a, b, x, y);
+    } else if (sscanf(key, "torus:%d:%d:%f:%f", &a, &b, &x, &y) == 4) {
+        mesh = mesh_create_torus(a, b, x, y);
+    } else if (sscanf(key, "cylinder:%d:%d:%f:%f:%d", &a, &b, &x, &y, &c) == 5) {
+        mesh = mesh_create_cylinder(a, b, x, y, c != 0);
+    } else if (sscanf(key, "lines:%d:%f:%f:%u", &a, &x, &y, &seed) == 4) {
+        mesh = mesh_create_random_lines(a, x, y, seed);
+    }
+    if (mesh) {
+        object3d_build_edge_dirs(mesh);
+        if (mesh->faces) object3d_build_edge_faces(mesh);
+    }
+    return mesh;
+}
+
+static bool cache_init(int capacity) {
+    cache.entries = calloc(capacity, sizeof(cache_entry_t));
+    if (!cache.entries) return false;
+    cache.capacity = capacity;
+    pthread_mutex_init(&cache.lock, NULL);
+    pthread_cond_init(&cache.built, NULL);
+    return true;
+}
+
+static void cache_free(void) {
+    for (int i = 0; i < cache.capacity; ++i) object3d_destroy(cache.entries[i].mesh);
+    free(cache.entries);
+    pthread_mutex_destroy(&cache.lock);
+    pthread_cond_destroy(&cache.built);
+}
+
+// Get a mesh by name, generating it on a miss. Returns the entry index (release it with cache_release),
+// CACHE_UNCACHED if the mesh could not be cached (the caller owns *mesh), or -1 if the name is invalid.
+// A miss reserves its slot as "building" and generates outside the lock, so other workers keep serving cache
+// hits meanwhile; requests for the same name wait for that build instead of starting their own.
+#define CACHE_UNCACHED -2
+static int cache_acquire(const char *key, object3d_t **mesh) {
+    if (strlen(key) >= MESH_KEY_SIZE) return -1;
+
+    pthread_mutex_lock(&cache.lock);
+    cache.clock++;
+    int free_slot, lru;
+    bool waiting;
+    do {
+        free_slot = -1;
+        lru = -1;
+        waiting = false;
+        for (int i = 0; i < cache.capacity; ++i) {
+            cache_entry_t *e = &cache.entries[i];
+            if (e->key[0] == '\0') {
+                if (free_slot < 0) free_slot = i;
+            } else if (strcmp(e->key, key) == 0) {
+                if (e->building) {
+                    waiting = true;
+                    break;
+                }
+                e->refs++;
+                e->last_used = cache.clock;
+                cache.hits++;
+                *mesh = e->mesh;
+                pthread_mutex_unlock(&cache.lock);
+                return i;
+            } else if (e->refs == 0 && (lru < 0 || e->last_used < cache.entries[lru].last_used)) {
+                lru = i;
+            }
+        }
+        // The builder may fail and free the slot, so scan again after every wake-up
+        if (waiting) pthread_cond_wait(&cache.built, &cache.lock);
+    } while (waiting);
+    cache.misses++;
+
+    int slot = free_slot >= 0 ? free_slot : lru;
+    if (slot < 0) { // Every entry is in use
+        pthread_mutex_unlock(&cache.lock);
+        *mesh = generate_mesh(key);
+        return *mesh ? CACHE_UNCACHED : -1;
+    }
+    cache_entry_t *e = &cache.entries[slot];
+    object3d_t *evicted = e->mesh;
+    snprintf(e->key, sizeof(e->key), "%s", key);
+    e->mesh = NULL;
+    e->refs = 1;
+    e->last_used = cache.clock;
+    e->building = true;
+    pthread_mutex_unlock(&cache.lock);
+
+    object3d_destroy(evicted);
+    object3d_t *created = generate_mesh(key);
+
+    pthread_mutex_lock(&cache.lock);
+    e->building = false;
+    if (created) {
+        e->mesh = created;
+    } else {
+        e->key[0] = '\0';
+        e->refs = 0;
+    }
+    pthread_cond_broadcast(&cache.built);
+    pthread_mutex_unlock(&cache.lock);
+    *mesh = created;
+    return created ? slot : -1;
+}
+
+static void cache_release(int slot, object3d_t *mesh) {
+    if (slot == CACHE_UNCACHED) {
+        object3d_destroy(mesh);
+        return;
+    }
+    pthread_mutex_lock(&cache.lock);
+    cache.entries[slot].refs--;
+    pthread_mutex_unlock(&cache.lock);
+}
+
+// =======================
+// Connection I/O
+// =======================
+
+// Buffered line reader over a socket
+typedef struct {
+    int fd;
+    char buf[4096];
+    int len, pos;
+} line_reader_t;
+
+// Read one line without its newline. Returns its length, or -1 on EOF or error.
+static int read_line(line_reader_t *r, char *line, int cap) {
+    int n = 0;
+    for (;;) {
+        if (r->pos == r->len) {
+            ssize_t got = recv(r->fd, r->buf, sizeof(r->buf), 0);
+            if (got < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) && !stopping) continue;
+            if (got <= 0) return n > 0 ? n : -1;
+            r->len = (int)got;
+            r->pos = 0;
+        }
+        char c = r->buf[r->pos++];
+        if (c == '\n') break;
+        if (c != '\r' && n < cap - 1) line[n++] = c;
+    }
+    line[n] = '\0';
+    return n;
+}
+
+static bool write_all(int fd, const void *data, size_t size) {
+    const char *p = data;
+    while (size > 0) {
+        ssize_t sent = send(fd, p, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+static bool send_text(int fd, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static bool send_text(int fd, const char *fmt, ...) {
+    char text[RENDER_MAX_LINE];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    return n > 0 && write_all(fd, text, n < (int)sizeof(text) ? (size_t)n : sizeof(text) - 1);
+}
+
+// =======================
+// Scenes
+// =======================
+
+typedef struct {
+    char mesh[MESH_KEY_SIZE];
+    bool solid;
+    float thickness, scale, spin_x, spin_y;
+    float position[3];
+} request_object_t;
+
+typedef struct {
+    int width, height, frames;
+    float camera_distance;
+    vec3 lights[RENDER_MAX_LIGHTS];
+    int num_lights;
+    request_object_t objects[RENDER_MAX_OBJECTS];
+    int num_objects;
+} request_t;
+
+// Read the lines after SCENE up to END. Returns NULL on success or an error message.
+static const char *read_scene(line_reader_t *r, request_t *scene) {
+    char line[RENDER_MAX_LINE];
+    for (;;) {
+        if (read_line(r, line, sizeof(line)) < 0) return "connection closed inside SCENE";
+        float x, y, z;
+        if (strcmp(line, "END") == 0) {
+            return scene->num_objects > 0 ? NULL : "scene has no objects";
+        } else if (sscanf(line, "CAMERA %f", &x) == 1) {
+            scene->camera_distance = x;
+        } else if (sscanf(line, "LIGHT %f %f %f", &x, &y, &z) == 3) {
+            if (scene->num_lights == RENDER_MAX_LIGHTS) return "too many lights";
+            scene->lights[scene->num_lights++] = vec3_normalize(vec3_from_cartesian(x, y, z));
+        } else if (strncmp(line, "OBJECT ", 7) == 0) {
+            if (scene->num_objects == RENDER_MAX_OBJECTS) return "too many objects";
+            request_object_t *o = &scene->objects[scene->num_objects];
+            char mode[16];
+            if (sscanf(line, "OBJECT %63s %15s %f %f %f %f %f %f %f", o->mesh, mode, &o->thickness, &o->scale,
+                       &o->spin_x, &o->spin_y, &o->position[0], &o->position[1], &o->position[2]) != 9) {
+                return "malformed OBJECT";
+            }
+            if (strcmp(mode, "wire") != 0 && strcmp(mode, "solid") != 0) return "OBJECT mode must be wire or solid";
+            o->solid = strcmp(mode, "solid") == 0;
+            scene->num_objects++;
+        } else {
+            return "unknown scene line";
+        }
+    }
+}
+
+// Append a binary PGM of the canvas (same grayscale as canvas_save_pgm) to out. Returns its size.
+static size_t encode_pgm(const canvas_t *canvas, unsigned char *out) {
+    int header = sprintf((char *)out, "P5\n%d %d\n255\n", canvas->width, canvas->height);
+    unsigned char *p = out + header;
+    for (int y = 0; y < canvas->height; ++y) {
+        const color_t *row = canvas->pixels[y];
+        for (int x = 0; x < canvas->width; ++x) {
+            *p++ = (unsigned char)((row[x].r + row[x].g + row[x].b) / 3.0f);
+        }
+    }
+    return (size_t)(p - out);
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+// Render every frame of a scene and stream it. Returns false if the client went away.
+static bool render_scene(int fd, const request_t *scene) {
+    object3d_t *meshes[RENDER_MAX_OBJECTS];
+    int slots[RENDER_MAX_OBJECTS];
+    int acquired = 0;
+    const char *error = NULL;
+    for (; acquired < scene->num_objects; ++acquired) {
+        slots[acquired] = cache_acquire(scene->objects[acquired].mesh, &meshes[acquired]);
+        if (slots[acquired] == -1) {
+            error = "unknown or invalid mesh";
+            break;
+        }
+        if (scene->objects[acquired].solid && meshes[acquired]->faces == NULL) {
+            cache_release(slots[acquired], meshes[acquired]);
+            error = "solid rendering needs a mesh with faces";
+            break;
+        }
+    }
+
+    canvas_t *canvas = NULL;
+    unsigned char *frame = NULL;
+    bool solid = false;
+    for (int i = 0; i < scene->num_objects; ++i) solid = solid || scene->objects[i].solid;
+    if (!error) {
+        canvas = canvas_create(scene->width, scene->height);
+        frame = malloc((size_t)scene->width * scene->height + 32);
+        if (!canvas || !frame || (solid && !canvas_enable_depth(canvas))) error = "out of memory";
+    }
+
+    bool ok = true;
+    if (error) {
+        ok = send_text(fd, "ERROR %s\n", error);
+    } else {
+        mat4 view = mat4_translate(0, 0, -scene->camera_distance);
+        mat4 proj = mat4_perspective(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 100.0f);
+        render_context_t ctx;
+        render_context_init(&ctx);
+        double render_ms = 0.0;
+        for (int f = 0; f < scene->frames && ok; ++f) {
+            double start = now_ms();
+            float turn = 2.0f * (float)M_PI * f / scene->frames;
+            canvas_clear(canvas);
+            for (int i = 0; i < scene->num_objects; ++i) {
+                const request_object_t *o = &scene->objects[i];
+                mat4 model = mat4_translate(o->position[0], o->position[1], o->position[2]);
+                model = mat4_mul(model, mat4_scale(o->scale, o->scale, o->scale));
+                model = mat4_mul(model, mat4_rotate_xyz(o->spin_x * turn, o->spin_y * turn, 0.0f));
+                vec3 *lights = (vec3 *)scene->lights;
+                if (o->solid) {
+                    render_solid(&ctx, canvas, meshes[i], model, view, proj, lights, scene->num_lights);
+                } else {
+                    render_wireframe(canvas, meshes[i], model, view, proj, o->thickness, lights, scene->num_lights);
+                }
+            }
+            size_t size = encode_pgm(canvas, frame);
+            render_ms += now_ms() - start;
+            ok = send_text(fd, "FRAME %d %d %d %zu\n", f, scene->width, scene->height, size) && write_all(fd, frame, size);
+        }
+        pthread_mutex_lock(&cache.lock);
+        cache.scenes++;
+        cache.frames += scene->frames;
+        pthread_mutex_unlock(&cache.lock);
+        if (ok) ok = send_text(fd, "DONE %d %.3f\n", scene->frames, render_ms);
+    }
+
+    for (int i = 0; i < acquired; ++i) cache_release(slots[i], meshes[i]);
+    canvas_destroy(canvas);
+    free(frame);
+    return ok;
+}
+
+// Serve requests on one connection until the client disconnects
+static void serve_connection(int fd) {
+    struct timeval timeout = {RECV_TIMEOUT_SEC, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    line_reader_t reader = {fd, {0}, 0, 0};
+    char line[RENDER_MAX_LINE];
+    bool ok = true;
+    while (ok && !stopping && read_line(&reader, line, sizeof(line)) >= 0) {
+        request_t scene;
+        if (line[0] == '\0') continue;
+        if (strcmp(line, "PING") == 0) {
+            ok = send_text(fd, "PONG\n");
+        } else if (strcmp(line, "STATS") == 0) {
+            int meshes = 0;
+            pthread_mutex_lock(&cache.lock);
+            for (int i = 0; i < cache.capacity; ++i) meshes += cache.entries[i].key[0] != '\0' && !cache.entries[i].building;
+            uint64_t hits = cache.hits, misses = cache.misses, scenes = cache.scenes, frames = cache.frames;
+            pthread_mutex_unlock(&cache.lock);
+            ok = send_text(fd, "STATS meshes=%d hits=%llu misses=%llu scenes=%llu frames=%llu\n", meshes,
+                           (unsigned long long)hits, (unsigned long long)misses,
+                           (unsigned long long)scenes, (unsigned long long)frames);
+        } else if (sscanf(line, "SCENE %d %d %d", &scene.width, &scene.height, &scene.frames) == 3) {
+            scene.camera_distance = 3.5f;
+            scene.num_lights = 0;
+            scene.num_objects = 0;
+            const char *error = read_scene(&reader, &scene);
+            if (!error && (scene.width < 1 || scene.height < 1 || scene.width > RENDER_MAX_SIZE ||
+                           scene.height > RENDER_MAX_SIZE || scene.frames < 1 || scene.frames > RENDER_MAX_FRAMES)) {
+                error = "scene size or frame count out of range";
+            }
+            if (error) {
+                ok = send_text(fd, "ERROR %s\n", error);
+                continue;
+            }
+            if (scene.num_lights == 0) {
+                scene.lights[0] = vec3_normalize(vec3_from_cartesian(1.0f, 1.0f, 1.0f));
+                scene.lights[1] = vec3_normalize(vec3_from_cartesian(-1.0f, -0.5f, 0.5f));
+                scene.num_lights = 2;
+            }
+            ok = render_scene(fd, &scene);
+        } else {
+            ok = send_text(fd, "ERROR unknown request\n");
+        }
+    }
+    close(fd);
+}
+
+// =======================
+// Worker Pool
+// =======================
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    int fds[CONNECTION_QUEUE_SIZE];
+    int head, count;
+} connection_queue_t;
+
+static connection_queue_t queue = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, {0}, 0, 0};
+
+// Queue a connection; returns false if the queue is full
+static bool queue_push(int fd) {
+    pthread_mutex_lock(&queue.lock);
+    bool ok = queue.count < CONNECTION_QUEUE_SIZE;
+    if (ok) {
+        queue.fds[(queue.head + queue.count) % CONNECTION_QUEUE_SIZE] = fd;
+        queue.count++;
+        pthread_cond_signal(&queue.ready);
+    }
+    pthread_mutex_unlock(&queue.lock);
+    return ok;
+}
+
+// Next connection, or -1 once the daemon is stopping
+static int queue_pop(void) {
+    pthread_mutex_lock(&queue.lock);
+    while (queue.count == 0 && !stopping) pthread_cond_wait(&queue.ready, &queue.lock);
+    int fd = -1;
+    if (queue.count > 0) {
+        fd = queue.fds[queue.head];
+        queue.head = (queue.head + 1) % CONNECTION_QUEUE_SIZE;
+        queue.count--;
+    }
+    pthread_mutex_unlock(&queue.lock);
+    return fd;
+}
+
+static void *worker_main(void *arg) {
+    (void)arg;
+    int fd;
+    while ((fd = queue_pop()) >= 0) serve_connection(fd);
+    return NULL;
+}
+
+static void handle_stop(int sig) {
+    (void)sig;
+    stopping = 1;
+}
+
+int main(int argc, char **argv) {
+    const char *socket_path = RENDER_SOCKET_PATH;
+    int num_workers = 4;
+    int cache_size = 32;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            num_workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cache_size = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--socket PATH] [--workers N] [--cache N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_workers < 1) num_workers = 1;
+    if (num_workers > MAX_WORKERS) num_workers = MAX_WORKERS;
+    if (cache_size < 1) cache_size = 1;
+
+    struct sockaddr_un addr = {0};
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Socket path too long: %s\n", socket_path);
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        perror("socket");
+        return 1;
+    }
+    unlink(socket_path); // Stale socket from a previous run
+    if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listener, CONNECTION_QUEUE_SIZE) < 0) {
+        perror("bind/listen");
+        close(listener);
+        return 1;
+    }
+    if (!cache_init(cache_size)) {
+        perror("Failed to allocate the mesh cache");
+        close(listener);
+        return 1;
+    }
+
+    // No SA_RESTART, so a signal interrupts accept()
+    struct sigaction sa = {0};
+    sa.sa_handler = handle_stop;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    pthread_t workers[MAX_WORKERS];
+    for (int i = 0; i < num_workers; ++i) pthread_create(&workers[i], NULL, worker_main, NULL);
+    printf("render_daemon: listening on %s with %d workers, %d cached meshes\n", socket_path, num_workers, cache_size);
+    fflush(stdout);
+
+    while (!stopping) {
+        int fd = accept(listener, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            perror("accept");
+            break;
+        }
+        if (!queue_push(fd)) {
+            send_text(fd, "ERROR server busy\n");
+            close(fd);
+        }
+    }
+
+    // Wake idle workers; busy ones finish their current request and notice the flag within RECV_TIMEOUT_SEC
+    stopping = 1;
+    pthread_mutex_lock(&queue.lock);
+    pthread_cond_broadcast(&queue.ready);
+    pthread_mutex_unlock(&queue.lock);
+    for (int i = 0; i < num_workers; ++i) pthread_join(workers[i], NULL);
+    while (queue.count > 0) close(queue_pop());
+
+    close(listener);
+    unlink(socket_path);
+    cache_free();
+    printf("render_daemon: stopped\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef RENDER_PROTOCOL_H
+#define RENDER_PROTOCOL_H
+
+// Wire protocol shared by render_daemon and render_client.
+//
+// Requests are text lines over a Unix stream socket; a connection may send any number of them.
+//
+//   PING                                   -> PONG
+//   STATS                                  -> STATS meshes=<n> hits=<n> misses=<n> scenes=<n> frames=<n>
+//   SCENE <width> <height> <frames>        starts a scene, followed by any of
+//   CAMERA <distance>                        camera distance along +z (default 3.5)
+//   LIGHT <x> <y> <z>                        directional light (default: the two soccer demo lights)
+//   OBJECT <mesh> <wire|solid> <thickness> <scale> <spin_x> <spin_y> <x> <y> <z>
+//   END                                    renders and streams the frames
+//
+// <mesh> names a cached generator: soccer, icosphere:<level>, grid:<cols>:<rows>:<width>:<depth>,
+// torus:<major>:<minor>:<R>:<r>, cylinder:<segments>:<stacks>:<radius>:<height>:<capped 0|1>,
+// lines:<count>:<extent>:<max_length>:<seed>. Objects spin by spin_x/spin_y full turns over the animation.
+//
+// Each frame is sent as a header line followed by a binary (P5) PGM image:
+//
+//   FRAME <index> <width> <height> <bytes>\n<bytes of PGM>
+//
+// and the scene ends with "DONE <frames> <render_ms>". Malformed requests get "ERROR <message>".
+
+#define RENDER_SOCKET_PATH "/tmp/tiny3d.sock"
+
+#define RENDER_MAX_LINE 512
+#define RENDER_MAX_SIZE 4096
+#define RENDER_MAX_FRAMES 10000
+#define RENDER_MAX_OBJECTS 16
+#define RENDER_MAX_LIGHTS 8
+
+#endif
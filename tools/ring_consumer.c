@@ -0,0 +1,112 @@
+// Follows a shared frame ring (see include/frame_ring.h), for example one fed by `soccer_ball --ring NAME`.
+//
+// Usage: ring_consumer NAME [--save DIR] [--every K]
+//
+// Waits for the ring to appear, then reads every frame in place as it is published until the producer
+// finishes. With --save, every K-th frame (default 1) is copied out of its slot and written to DIR as QOI.
+// Reports frames read, frames lost because the reader fell a whole ring behind, and the mean brightness.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include "tiny3d.h"
+
+int main(int argc, char **argv) {
+    const char *name = NULL, *save_dir = NULL;
+    int every = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            save_dir = argv[++i];
+        } else if (strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+            every = atoi(argv[++i]);
+        } else if (!name && argv[i][0] != '-') {
+            name = argv[i];
+        } else {
+            name = NULL;
+            break;
+        }
+    }
+    if (!name) {
+        fprintf(stderr, "Usage: %s NAME [--save DIR] [--every K]\n", argv[0]);
+        return 2;
+    }
+    if (every < 1) every = 1;
+
+    // The producer may not have started yet
+    frame_ring_t *ring = NULL;
+    for (int tries = 0; !ring && tries < 100; ++tries) {
+        ring = frame_ring_open(name);
+        if (!ring) nanosleep(&(struct timespec){0, 100 * 1000000L}, NULL);
+    }
+    if (!ring) {
+        fprintf(stderr, "No frame ring %s\n", name);
+        return 1;
+    }
+    int slots = frame_ring_slots(ring);
+    printf("Following %s: %dx%d, %d slots\n", name, frame_ring_width(ring), frame_ring_height(ring), slots);
+
+    // Start with the oldest frame still held
+    uint64_t published = frame_ring_published(ring);
+    uint64_t next = published > (uint64_t)slots ? published - slots : 0;
+    long read = 0, lost = 0, saved = 0;
+    color_t *copy = save_dir ? malloc((size_t)frame_ring_width(ring) * frame_ring_height(ring) * sizeof(color_t)) : NULL;
+    double brightness = 0.0;
+    for (;;) {
+        published = frame_ring_published(ring);
+        if (next >= published) {
+            if (frame_ring_finished(ring) && next >= frame_ring_published(ring)) break;
+            sched_yield(); // Only when idle; published frames are read without system calls
+            continue;
+        }
+        if (published - next > (uint64_t)slots) {
+            lost += (long)(published - slots - next);
+            next = published - slots;
+        }
+
+        frame_view_t view;
+        if (!frame_ring_read_begin(ring, next, &view)) {
+            if (published - next >= (uint64_t)slots) {
+                lost++;
+                next++;
+            }
+            continue;
+        }
+        uint64_t sum = 0;
+        size_t count = (size_t)view.width * view.height;
+        for (size_t i = 0; i < count; ++i) sum += view.pixels[i].r + view.pixels[i].g + view.pixels[i].b;
+        // Encoding is slower than rendering a frame, so frames to save are copied out of the slot first
+        bool save = save_dir && next % every == 0 && copy;
+        if (save) memcpy(copy, view.pixels, count * sizeof(color_t));
+        if (!frame_ring_read_end(ring, &view)) {
+            // Overwritten while we read it
+            lost++;
+            next++;
+            continue;
+        }
+        brightness += (double)sum / (3.0 * count);
+        if (save) {
+            canvas_t *frame = canvas_wrap(view.width, view.height, copy, view.width);
+            size_t qoi_size = 0;
+            unsigned char *qoi = canvas_encode_qoi(frame, &qoi_size);
+            canvas_destroy(frame);
+            char path[512];
+            snprintf(path, sizeof(path), "%s/ring_%05llu.qoi", save_dir, (unsigned long long)next);
+            FILE *f = qoi ? fopen(path, "wb") : NULL;
+            if (f) {
+                if (fwrite(qoi, 1, qoi_size, f) == qoi_size) saved++;
+                fclose(f);
+            }
+            free(qoi);
+        }
+        read++;
+        next++;
+    }
+
+    printf("%ld frames read, %ld lost, %ld saved, mean brightness %.3f\n", read, lost, saved, read ? brightness / read : 0.0);
+    free(copy);
+    frame_ring_destroy(ring);
+    return 0;
+}